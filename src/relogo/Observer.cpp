@@ -159,6 +159,12 @@ const RelogoSpaceType* Observer::space() {
 	return static_cast<RelogoSpaceType*> (context.getProjection(SPACE_NAME));
 }
 
+bool Observer::spacePtToGridPt(Point<double, 2>& spacePt, Point<int, 2>& gridPt) {
+  gridPt[0] = doubleCoordToInt(spacePt[0]);
+  gridPt[1] = doubleCoordToInt(spacePt[1]);
+  return false;
+}
+
 bool Observer::spacePtToGridPt(std::vector<double>& spacePt, std::vector<int>& gridPt) {
   gridPt[0] = doubleCoordToInt(spacePt[0]);
   gridPt[1] = doubleCoordToInt(spacePt[1]);
@@ -251,11 +257,15 @@ struct TurtleCaster: public std::unary_function<boost::shared_ptr<RelogoAgent>,
 };
 
 void Observer::get(AgentSet<Turtle>& turtles) {
-	const_not_type_iterator istart(repast::IsNotType<RelogoAgent>(PATCH_TYPE_ID), context.begin(), context.end());
-	const_not_type_iterator iend(repast::IsNotType<RelogoAgent>(PATCH_TYPE_ID), context.end(), context.end());
-	boost::transform_iterator<TurtleCaster, const_not_type_iterator> begin(istart);
-	boost::transform_iterator<TurtleCaster, const_not_type_iterator> end(iend);
-	turtles.addAll(begin, end);
+	// every type but the patches' is a turtle type
+	std::vector<int> types;
+	context.getAgentTypes(types);
+	for (size_t i = 0; i < types.size(); i++) {
+		if (types[i] == PATCH_TYPE_ID) continue;
+		boost::transform_iterator<TurtleCaster, Context<RelogoAgent>::const_bytype_iterator> begin(context.byTypeBegin(types[i]));
+		boost::transform_iterator<TurtleCaster, Context<RelogoAgent>::const_bytype_iterator> end(context.byTypeEnd(types[i]));
+		turtles.addAll(begin, end);
+	}
 }
 
 void Observer::createLink(RelogoAgent* source, RelogoAgent* target, const std::string& name) {
@@ -211,6 +211,14 @@ public:
 	 */
 	bool spacePtToGridPt(std::vector<double>& spacePt, std::vector<int>& gridPt);
 
+	/*
+	 * As spacePtToGridPt above, for the fixed two dimensional points that
+	 * turtle moves use so that they do not allocate.
+	 *
+	 * NON API method
+	 */
+	bool spacePtToGridPt(Point<double, 2>& spacePt, Point<int, 2>& gridPt);
+
 	/**
 	 * Hatchs an agent of the specified type. The new agent
 	 * will have the location and heading of the specified "parent".
@@ -612,8 +620,6 @@ private:
 
 	// first is the typeid, second is the next good id of that type.
 	typedef std::map<const std::type_info*, std::pair<int, int>, TypeInfoCmp> TypeMap;
-	typedef boost::filter_iterator<IsNotType<RelogoAgent> , Context<RelogoAgent>::const_iterator>
-			const_not_type_iterator;
 	typedef TypeMap::iterator TypeMapIterator;
 
 
@@ -716,11 +722,9 @@ template<typename AgentType>
 void Observer::get(AgentSet<AgentType>& agentSet) {
   int typeId = getTypeId<AgentType> ();
 	if (typeId != NO_TYPE_ID) {
-		for (SharedContext<RelogoAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd(); ++iter) {
-			AgentId id = iter->get()->getId();
-			if (id.agentType() == typeId) {
-				agentSet.add(static_cast<AgentType*> (iter->get()));
-			}
+		for (SharedContext<RelogoAgent>::const_state_aware_bytype_iterator iter = context.byTypeBegin(SharedContext<
+				RelogoAgent>::LOCAL, typeId); iter != context.byTypeEnd(SharedContext<RelogoAgent>::LOCAL, typeId); ++iter) {
+			agentSet.add(static_cast<AgentType*> (iter->get()));
 		}
 	}
 }
@@ -74,39 +74,39 @@ void Turtle::setxy(double x, double y) {
 		// cast away the constness so that we can move
 		// needs to const so that users cannot move using the space
 		RelogoSpaceType* space = const_cast<RelogoSpaceType*> (_observer->space());
-		std::vector<double> pos(2, 0);
-		pos[0] = x;
-		pos[1] = y;
-		std::vector<double> transformedCoords(2, 0);
-		std::vector<double> oldLocation(_location.coords());
-		space->transform(pos, transformedCoords);
-		if (transformedCoords[0] != _location.getX() || transformedCoords[1] != _location.getY()) {
-			_location = Point<double> (transformedCoords);
-			std::vector<int> gridPt(2, 0);
-			std::vector<double> spacePt(_location.coords());
-			if (_observer->spacePtToGridPt(spacePt, gridPt)) {
-				_location = Point<double> (spacePt);
-			}
-
-			space->moveTo(getId(), _location);
+		Point<double, 2> transformedCoords;
+		space->transform(Point<double, 2> (x, y), transformedCoords);
+		relocate(transformedCoords);
+		moved = false;
+	}
+}
 
-			// cast away the constness so that we can move
-			// needs to const so that users can move using the grid
-			RelogoGridType* grid = const_cast<RelogoGridType*> (_observer->grid());
-			grid->moveTo(getId(), Point<int> (gridPt));
-			moveTiedTurtles(oldLocation);
+void Turtle::relocate(const Point<double, 2>& location) {
+	if (location[0] != _location.getX() || location[1] != _location.getY()) {
+		Point<double, 2> oldLocation(_location);
+		Point<double, 2> spacePt(location);
+		Point<int, 2> gridPt;
+		_observer->spacePtToGridPt(spacePt, gridPt);
+		_location.set(spacePt);
 
-		}
+		// cast away the constness so that we can move
+		// needs to const so that users cannot move using the space
+		RelogoSpaceType* space = const_cast<RelogoSpaceType*> (_observer->space());
+		space->moveTo(getId(), spacePt);
 
-		moved = false;
+		// cast away the constness so that we can move
+		// needs to const so that users can move using the grid
+		RelogoGridType* grid = const_cast<RelogoGridType*> (_observer->grid());
+		grid->moveTo(getId(), gridPt);
+		moveTiedTurtles(oldLocation);
 	}
 }
 
-void Turtle::moveTiedTurtles(const Point<double>& oldLocation) {
+void Turtle::moveTiedTurtles(const Point<double, 2>& oldLocation) {
 	if (!fixedLeaves.empty() || !freeLeaves.empty()) {
 		RelogoSpaceType* space = const_cast<RelogoSpaceType*> (_observer->space());
 		vector<double> displacement;
-		space->getDisplacement(oldLocation, _location, displacement);
+		space->getDisplacement(oldLocation.toPoint(), _location, displacement);
 
 		for (TiedSetType::iterator iter = fixedLeaves.begin(); iter != fixedLeaves.end(); ++iter) {
 			Turtle* t = *iter;
@@ -145,36 +145,19 @@ void Turtle::move(double distance) {
 	if (!moved) {
 		moved = true;
 		// convert to relogo angle where 0 is north, rather then repast where 0 is east
-		vector<double> angles(2, 0);
-		angles[0] = repast::PI / 2 - repast::toRadians(_heading);
-		Point<double> oldLocation(_location.coords());
+		double angle = repast::PI / 2 - repast::toRadians(_heading);
 
 		// cast away the constness so that we can move, normally const so that
 		// users cannot move using the space directly
 		RelogoSpaceType* space = const_cast<RelogoSpaceType*> (_observer->space());
 
-		std::vector<double> displacement = calculateDisplacement<double> (2, 0, distance, angles);
-		std::vector<double> newPos(2, 0);
-
-		space->translate(_location, Point<double> (displacement), newPos);
-		std::vector<double> transformedCoords(newPos.size(), 0);
+		// the displacement calculateDisplacement gives for a single angle in 2D
+		Point<double, 2> displacement(distance * cos(angle), distance * sin(angle));
+		Point<double, 2> newPos;
+		space->translate(Point<double, 2> (_location), displacement, newPos);
+		Point<double, 2> transformedCoords;
 		space->transform(newPos, transformedCoords);
-		if (transformedCoords[0] != _location.getX() || transformedCoords[1] != _location.getY()) {
-			_location = Point<double> (transformedCoords);
-			std::vector<int> gridPt(2, 0);
-			std::vector<double> spacePt(_location.coords());
-			if (_observer->spacePtToGridPt(spacePt, gridPt)) {
-				_location = Point<double> (spacePt);
-			}
-
-			space->moveTo(getId(), _location);
-
-			// cast away the constness so that we can move
-			// needs to const so that users can move using the grid
-			RelogoGridType* grid = const_cast<RelogoGridType*> (_observer->grid());
-			grid->moveTo(getId(), Point<int> (gridPt));
-			moveTiedTurtles(oldLocation);
-		}
+		relocate(transformedCoords);
 		moved = false;
 	}
 }
@@ -721,7 +721,13 @@ private:
 	 * Moves tied turtles vector diff between oldLocation and this
 	 * turtles current location
 	 */
-	void moveTiedTurtles(const Point<double>& oldLocation);
+	void moveTiedTurtles(const Point<double, 2>& oldLocation);
+
+	/*
+	 * Moves this turtle in the space and grid to the specified, already
+	 * transformed, location, if that differs from its current location.
+	 */
+	void relocate(const Point<double, 2>& location);
 	/*
 	 * Moves a tied turtle as the result of this turtle changing its heading.
 	 */
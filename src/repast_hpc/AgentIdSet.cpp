@@ -0,0 +1,130 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  AgentIdSet.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "AgentIdSet.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace repast {
+
+AgentIdSet::AgentIdSet() : sorted(0) {}
+
+void AgentIdSet::insert(const AgentId& id) {
+	bool inOrder = (sorted == ids.size()) && (ids.empty() || ids.back() < id);
+	ids.push_back(id);
+	if (inOrder) sorted++;
+}
+
+void AgentIdSet::insert(const AgentIdSet& other) {
+	if (other.empty()) return;
+	if (empty()) {
+		ids = other.ids;
+		sorted = other.sorted;
+		return;
+	}
+	normalize();
+	other.normalize();
+	std::vector<AgentId> merged;
+	merged.reserve(ids.size() + other.ids.size());
+	// set_union takes equivalent ids from the first range, so existing ids win
+	std::set_union(ids.begin(), ids.end(), other.ids.begin(), other.ids.end(), std::back_inserter(merged));
+	ids.swap(merged);
+	sorted = ids.size();
+}
+
+void AgentIdSet::erase(const AgentIdSet& other) {
+	if (empty() || other.empty()) return;
+	normalize();
+	other.normalize();
+	std::vector<AgentId>::iterator out = ids.begin();
+	std::vector<AgentId>::iterator iter = ids.begin(), iterEnd = ids.end();
+	std::vector<AgentId>::const_iterator rem = other.ids.begin(), remEnd = other.ids.end();
+	while (iter != iterEnd) {
+		while (rem != remEnd && *rem < *iter)
+			++rem;
+		if (rem == remEnd || *iter < *rem) *out++ = *iter;
+		++iter;
+	}
+	ids.erase(out, ids.end());
+	sorted = ids.size();
+}
+
+bool AgentIdSet::contains(const AgentId& id) const {
+	normalize();
+	return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+std::size_t AgentIdSet::size() const {
+	normalize();
+	return ids.size();
+}
+
+void AgentIdSet::clear() {
+	ids.clear();
+	sorted = 0;
+}
+
+void AgentIdSet::swap(AgentIdSet& other) {
+	ids.swap(other.ids);
+	std::swap(sorted, other.sorted);
+}
+
+AgentIdSet::const_iterator AgentIdSet::begin() const {
+	normalize();
+	return ids.begin();
+}
+
+AgentIdSet::const_iterator AgentIdSet::end() const {
+	normalize();
+	return ids.end();
+}
+
+void AgentIdSet::normalize() const {
+	if (sorted == ids.size()) return;
+	std::vector<AgentId>::iterator middle = ids.begin() + sorted;
+	// Stable, so that the first copy of an id appended more than once is kept
+	std::stable_sort(middle, ids.end());
+	std::inplace_merge(ids.begin(), middle, ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	sorted = ids.size();
+}
+
+}
@@ -0,0 +1,130 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  AgentIdSet.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef AGENTIDSET_H_
+#define AGENTIDSET_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "AgentId.h"
+
+namespace repast {
+
+/**
+ * A set of AgentIds stored as a flat, sorted vector. Ids are ordered and
+ * compared as in std::set<AgentId> (that is, ignoring the current rank), and
+ * iteration visits them in the same order, but inserting is an append: ids
+ * added out of order are sorted, merged and de-duplicated in bulk the next
+ * time the set is read. When an id is added more than once the first copy
+ * added is the one kept, again as in std::set.
+ *
+ * Used for the bookkeeping done on every synchronization of projection
+ * information and agent status, where whole sets are built, tested against
+ * and subtracted from one another.
+ */
+class AgentIdSet {
+
+public:
+	typedef std::vector<AgentId>::const_iterator const_iterator;
+	typedef const_iterator iterator;
+
+	AgentIdSet();
+
+	/**
+	 * Adds the id to this set. Ids added in increasing order are kept without
+	 * any further sorting.
+	 */
+	void insert(const AgentId& id);
+
+	/**
+	 * Adds all of the ids in the range [first, last) to this set.
+	 */
+	template<typename InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first)
+			insert(*first);
+	}
+
+	/**
+	 * Adds all of the ids in the other set to this set.
+	 */
+	void insert(const AgentIdSet& other);
+
+	/**
+	 * Removes all of the ids in the other set from this set.
+	 */
+	void erase(const AgentIdSet& other);
+
+	/**
+	 * Gets whether or not this set contains the id.
+	 */
+	bool contains(const AgentId& id) const;
+
+	std::size_t size() const;
+
+	bool empty() const {
+		return ids.empty();
+	}
+
+	void clear();
+
+	void reserve(std::size_t count) {
+		ids.reserve(count);
+	}
+
+	void swap(AgentIdSet& other);
+
+	const_iterator begin() const;
+
+	const_iterator end() const;
+
+private:
+	// The first 'sorted' ids are sorted and unique; any after that were
+	// appended out of order and have not been merged yet
+	mutable std::vector<AgentId> ids;
+	mutable std::size_t sorted;
+
+	void normalize() const;
+};
+
+}
+
+#endif /* AGENTIDSET_H_ */
@@ -38,6 +38,7 @@
  */
 
 #include "AgentImporterExporter.h"
+#include "SyncProfiler.h"
 
 #include <algorithm>
 
@@ -258,7 +259,7 @@ std::string Importer_COUNT::getReport(){
   return ss.str();
 }
 
-void Importer_COUNT::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_COUNT::getSetOfAgentsBeingImported(AgentIdSet& set){
   // Not implemented for 'count'
 }
 
@@ -427,7 +428,7 @@ std::string Importer_LIST::getReport(){
   return ss.str();
 }
 
-void Importer_LIST::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_LIST::getSetOfAgentsBeingImported(AgentIdSet& set){
   if(sources.size() > 0){
     std::map<int, std::list<AgentId>* >::iterator it          = sources.begin();
     const std::map<int, std::list<AgentId>* >::iterator itEnd = sources.end();
@@ -547,7 +548,7 @@ std::string Importer_SET::getReport(){
   return ss.str();
 }
 
-void Importer_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_SET::getSetOfAgentsBeingImported(AgentIdSet& set){
   if(sources.size() > 0){
     std::map<int, std::set<AgentId>* >::iterator it          = sources.begin();
     const std::map<int, std::set<AgentId>* >::iterator itEnd = sources.end();
@@ -728,7 +729,7 @@ std::string Importer_MAP_int::getReport(){
   return ss.str();
 }
 
-void Importer_MAP_int::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void Importer_MAP_int::getSetOfAgentsBeingImported(AgentIdSet& set){
   if(sources.size() > 0){
     std::map<int, std::map<AgentId, int>* >::iterator it          = sources.begin();
     const std::map<int, std::map<AgentId, int>* >::iterator itEnd = sources.end();
@@ -1007,6 +1008,7 @@ const AbstractExporter::StatusMap* AbstractImporterExporter::getOutgoingStatusCh
 
 void AbstractImporterExporter::exchangeAgentStatusUpdates(boost::mpi::communicator comm, std::vector<std::vector<AgentStatus>* >& statusUpdates){
   std::vector<boost::mpi::request> requests;
+  std::vector<boost::shared_ptr<boost::mpi::packed_oarchive> > archives; // Sent data
 
   // Create the appropriate receives...
   const std::set<int>& toReceiveFrom = getExportingProcesses();
@@ -1030,16 +1032,16 @@ void AbstractImporterExporter::exchangeAgentStatusUpdates(boost::mpi::communicat
     int exportedSetVal = (exportedSetIter != exportedSet.end()            ? *exportedSetIter       : INT_MAX);
     int statusMapVal   = (statusMapIter   != outgoingStatusChanges->end() ? statusMapIter->first   : INT_MAX);
     if(statusMapVal == exportedSetVal){
-      requests.push_back(comm.isend(statusMapVal, AGENT_SYNC_STATUS, statusMapIter->second));
+      requests.push_back(isendSerialized(comm, statusMapVal, AGENT_SYNC_STATUS, statusMapIter->second, archives));
       exportedSetIter++;
       statusMapIter++;
     }
     else if(statusMapVal < exportedSetVal){
-      requests.push_back(comm.isend(statusMapVal, AGENT_SYNC_STATUS, statusMapIter->second));
+      requests.push_back(isendSerialized(comm, statusMapVal, AGENT_SYNC_STATUS, statusMapIter->second, archives));
       statusMapIter++;
     }
     else if(statusMapVal > exportedSetVal){
-      requests.push_back(comm.isend(exportedSetVal, AGENT_SYNC_STATUS, emptyStatus));
+      requests.push_back(isendSerialized(comm, exportedSetVal, AGENT_SYNC_STATUS, emptyStatus, archives));
       exportedSetIter++;
     }
   }
@@ -1391,7 +1393,7 @@ const std::map<int, AgentRequest>& ImporterExporter_BY_SET::getAgentsToExport(st
 }
 
 
-void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set){
+void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(AgentIdSet& set){
   std::map<std::string, AbstractImporterExporter*>::iterator mapIter = importersExportersMap.begin();
   while(mapIter != importersExportersMap.end()){
     mapIter->second->getSetOfAgentsBeingImported(set);
@@ -1399,7 +1401,7 @@ void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set
   }
 }
 
-void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(std::set<AgentId>& set, std::string excludeSet){
+void ImporterExporter_BY_SET::getSetOfAgentsBeingImported(AgentIdSet& set, std::string excludeSet){
   std::map<std::string, AbstractImporterExporter*>::iterator mapIter = importersExportersMap.begin();
   while(mapIter != importersExportersMap.end()){
     if(mapIter->first.compare(excludeSet) != 0)    mapIter->second->getSetOfAgentsBeingImported(set);
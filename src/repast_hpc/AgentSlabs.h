@@ -0,0 +1,323 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * AgentSlabs.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef AGENTSLABS_H_
+#define AGENTSLABS_H_
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "AgentId.h"
+
+namespace repast {
+
+/**
+ * Agent storage used by a Context created with Context::SLABS. Agents are
+ * held in slabs, one per agent type (the type component of their AgentId),
+ * each a dense vector of slots. Removing an agent moves the last agent of
+ * its slab into its slot, so the agents of a type can be indexed by
+ * position (see typeSize and agentAt). The slots are found by AgentId
+ * through an open addressing hash index that holds only slab and slot
+ * numbers, the AgentId being read from the agent itself. Iteration walks
+ * the slabs in increasing order of type, and each slab in slot order.
+ *
+ * @tparam T the type of the agents
+ */
+template<typename T>
+class AgentSlabs {
+
+public:
+	typedef boost::shared_ptr<T> AgentPtr;
+
+private:
+	struct Slab {
+		std::vector<AgentPtr> agents;
+	};
+
+	struct Slot {
+		int slab, index; // slab is -1 for an empty entry
+	};
+
+	std::vector<Slab> slabs; // in order of creation, so that slab numbers are stable
+	std::vector<std::pair<int, int> > types; // type and slab number, in increasing order of type
+	std::vector<Slot> table;
+	int shift;
+	size_t count;
+
+	const AgentPtr& agentAt(const Slot& slot) const {
+		return slabs[slot.slab].agents[slot.index];
+	}
+
+	// Fibonacci hashing; the index is the top bits of the product
+	size_t home(const AgentId& id) const {
+		return (size_t) (((unsigned long long) id.hashcode() * 11400714819323198485ULL) >> shift);
+	}
+
+	size_t next(size_t entry) const {
+		return (entry + 1) & (table.size() - 1);
+	}
+
+	// the entry holding the agent with the id, or the empty entry where it would go
+	size_t probe(const AgentId& id) const {
+		size_t entry = home(id);
+		while (table[entry].slab != -1 && agentAt(table[entry])->getId() != id)
+			entry = next(entry);
+		return entry;
+	}
+
+	int slabFor(int type) {
+		std::vector<std::pair<int, int> >::iterator iter = std::lower_bound(types.begin(), types.end(),
+				std::make_pair(type, -1));
+		if (iter != types.end() && iter->first == type) return iter->second;
+		slabs.push_back(Slab());
+		types.insert(iter, std::make_pair(type, (int) slabs.size() - 1));
+		return (int) slabs.size() - 1;
+	}
+
+	void resize(size_t entries) {
+		std::vector<Slot> old;
+		old.swap(table);
+		Slot empty = { -1, -1 };
+		table.assign(entries, empty);
+		shift = 64;
+		for (size_t size = entries; size > 1; size >>= 1)
+			shift--;
+		for (size_t i = 0; i < old.size(); i++) {
+			if (old[i].slab != -1) table[probe(agentAt(old[i])->getId())] = old[i];
+		}
+	}
+
+public:
+	/**
+	 * Forward iterator over the agents, dereferencing to a const reference
+	 * to their shared_ptr.
+	 */
+	class const_iterator: public boost::iterator_facade<const_iterator, const AgentPtr, boost::forward_traversal_tag> {
+
+	private:
+		friend class boost::iterator_core_access;
+		friend class AgentSlabs;
+
+		const AgentSlabs* store;
+		size_t type, index;
+
+		const_iterator(const AgentSlabs* slabs, size_t typeIndex) :
+			store(slabs), type(typeIndex), index(0) {
+			settle();
+		}
+
+		// moves forward to the first occupied slot at or after the current one
+		void settle() {
+			while (type < store->types.size()) {
+				const std::vector<AgentPtr>& agents = store->slabs[store->types[type].second].agents;
+				while (index < agents.size() && !agents[index])
+					index++;
+				if (index < agents.size()) return;
+				type++;
+				index = 0;
+			}
+		}
+
+		void increment() {
+			index++;
+			settle();
+		}
+
+		bool equal(const const_iterator& other) const {
+			return type == other.type && index == other.index;
+		}
+
+		const AgentPtr& dereference() const {
+			return store->slabs[store->types[type].second].agents[index];
+		}
+
+	public:
+		const_iterator() :
+			store(0), type(0), index(0) {
+		}
+	};
+
+	AgentSlabs() :
+		shift(64), count(0) {
+		resize(16);
+	}
+
+	/**
+	 * Gets the agent with the id, or 0 if there is no such agent.
+	 */
+	const AgentPtr* find(const AgentId& id) const {
+		const Slot& slot = table[probe(id)];
+		return slot.slab == -1 ? 0 : &agentAt(slot);
+	}
+
+	/**
+	 * Adds the agent, unless there already is an agent with the same id.
+	 *
+	 * @return true if the agent was added, otherwise false.
+	 */
+	bool insert(const AgentPtr& agent) {
+		if ((count + 1) * 2 > table.size()) resize(table.size() * 2);
+		size_t entry = probe(agent->getId());
+		if (table[entry].slab != -1) return false;
+
+		int slabIndex = slabFor(agent->getId().agentType());
+		Slab& slab = slabs[slabIndex];
+		table[entry].slab = slabIndex;
+		table[entry].index = (int) slab.agents.size();
+		slab.agents.push_back(agent);
+		count++;
+		return true;
+	}
+
+	/**
+	 * Makes room in the index for the count of agents, so that adding up to
+	 * that many does not grow it.
+	 */
+	void reserve(size_t agents) {
+		size_t entries = table.size();
+		while (agents * 2 > entries)
+			entries *= 2;
+		if (entries != table.size()) resize(entries);
+	}
+
+	/**
+	 * Removes the agent with the id, if there is one.
+	 *
+	 * @return true if an agent was removed, otherwise false.
+	 */
+	bool erase(const AgentId& id) {
+		size_t entry = probe(id);
+		if (table[entry].slab == -1) return false;
+		Slot removed = table[entry];
+
+		// backward shift deletion: move up the following entries of the
+		// cluster that would otherwise become unreachable
+		size_t hole = entry;
+		for (size_t j = next(hole); table[j].slab != -1; j = next(j)) {
+			size_t k = home(agentAt(table[j])->getId());
+			bool stays = (hole <= j) ? (hole < k && k <= j) : (hole < k || k <= j);
+			if (!stays) {
+				table[hole] = table[j];
+				hole = j;
+			}
+		}
+		table[hole].slab = -1;
+
+		// the last agent of the slab takes the removed agent's slot
+		Slab& slab = slabs[removed.slab];
+		if (removed.index != (int) slab.agents.size() - 1) {
+			slab.agents[removed.index] = slab.agents.back();
+			table[probe(slab.agents[removed.index]->getId())].index = removed.index;
+		}
+		slab.agents.pop_back();
+		count--;
+		return true;
+	}
+
+	/**
+	 * Removes all the agents.
+	 */
+	void clear() {
+		table.clear();
+		slabs.clear();
+		types.clear();
+		count = 0;
+		resize(16);
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	/**
+	 * Gets the number of agent types that have a slab, including those
+	 * whose agents have all been removed.
+	 */
+	size_t typeCount() const {
+		return types.size();
+	}
+
+	/**
+	 * Gets the position of the slab of the agent type among all the slabs,
+	 * in increasing order of type, or -1 if the type has no slab.
+	 */
+	int typeIndex(int type) const {
+		std::vector<std::pair<int, int> >::const_iterator iter = std::lower_bound(types.begin(), types.end(),
+				std::make_pair(type, -1));
+		return (iter != types.end() && iter->first == type) ? (int) (iter - types.begin()) : -1;
+	}
+
+	/**
+	 * Gets the agent type of the slab at the position.
+	 */
+	int typeAt(size_t typeIndex) const {
+		return types[typeIndex].first;
+	}
+
+	/**
+	 * Gets the number of agents in the slab at the position.
+	 */
+	size_t typeSize(size_t typeIndex) const {
+		return slabs[types[typeIndex].second].agents.size();
+	}
+
+	/**
+	 * Gets the agent in the slot of the slab at the position.
+	 */
+	const AgentPtr& agentAt(size_t typeIndex, size_t index) const {
+		return slabs[types[typeIndex].second].agents[index];
+	}
+
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const {
+		return const_iterator(this, types.size());
+	}
+};
+
+}
+
+#endif /* AGENTSLABS_H_ */
@@ -113,12 +113,13 @@ private:
 	AgentLocationMap agentToLocation;
 	GridDimensions dimensions_;
 
-	CellAccessor cellAccessor;
-
-	bool doMove(std::vector<GPType>& point, GridPointHolder<T, GPType>* gpHolder);
+	bool doMove(const Point<GPType>& point, GridPointHolder<T, GPType>* gpHolder);
 
 	size_t size_;
 
+	// reused by the fixed dimension moves, so that they do not allocate
+	Point<GPType> movePoint;
+
 protected:
 
 	typedef typename AgentLocationMap::iterator LocationMapIter;
@@ -126,9 +127,11 @@ protected:
 
 	GPTransformer gpTransformer;
 	Adder adder;
+	CellAccessor cellAccessor;
 
 	virtual bool addAgent(boost::shared_ptr<T> agent);
 	virtual void removeAgent(T* agent);
+	virtual void addAgents(const std::vector<boost::shared_ptr<T> >& agents);
 
 	LocationMapConstIter locationsBegin() const {
 		return agentToLocation.begin();
@@ -219,6 +222,96 @@ public:
 	virtual std::pair<bool, Point<GPType> > moveByVector(const T* agent, double distance,
 			const std::vector<double>& anglesInRadians);
 
+	/**
+	 * Moves the specified agent to the specified location, given as a point
+	 * of compile time dimension. This behaves as moveTo(id, std::vector<GPType>)
+	 * but transforms the location, and moves the agent, without allocating.
+	 *
+	 * @param id the id of the agent to move
+	 * @param newLocation the location to move to
+	 *
+	 * @return true if the move was successful, otherwise false
+	 *
+	 * @throws Repast_Error_3 if N is not the number of dimensions of this grid
+	 */
+	template<int N>
+	bool moveTo(const AgentId& id, const Point<GPType, N>& newLocation);
+
+	/**
+	 * Moves the specified agent by the specified displacement, given as a point
+	 * of compile time dimension. This behaves as moveByDisplacement(agent,
+	 * std::vector<GPType>) but does not allocate.
+	 *
+	 * @param agent the agent to move
+	 * @param displacement the displacement
+	 *
+	 * @return a pair of whether the move was successful and the agent's new location
+	 *
+	 * @throws Repast_Error_5 if N is not the number of dimensions of this grid
+	 */
+	template<int N>
+	std::pair<bool, Point<GPType, N> > moveByDisplacement(const T* agent, const Point<GPType, N>& displacement);
+
+	/**
+	 * Gets the location of the specified agent as a point of compile time
+	 * dimension. N must be the number of dimensions of this grid.
+	 *
+	 * @param id the id of the agent
+	 * @param [out] out the agent's location
+	 *
+	 * @return true if the agent is in this grid, otherwise false
+	 */
+	template<int N>
+	bool getLocation(const AgentId& id, Point<GPType, N>& out) const;
+
+	/**
+	 * Translates the location by the displacement according to this grid's
+	 * borders, using points of compile time dimension.
+	 */
+	template<int N>
+	void translate(const Point<GPType, N>& location, const Point<GPType, N>& displacement, Point<GPType, N>& out) const {
+		gpTransformer.translate(location, out, displacement);
+	}
+
+	/**
+	 * Transforms the location according to this grid's borders, using
+	 * points of compile time dimension.
+	 */
+	template<int N>
+	void transform(const Point<GPType, N>& location, Point<GPType, N>& out) const {
+		gpTransformer.transform(location, out);
+	}
+
+	// doc inherited from Grid
+	virtual bool moveTo(const AgentId& id, const Point<GPType, 2>& pt) {
+		return moveTo<2>(id, pt);
+	}
+
+	// doc inherited from Grid
+	virtual bool moveTo(const AgentId& id, const Point<GPType, 3>& pt) {
+		return moveTo<3>(id, pt);
+	}
+
+	// doc inherited from Grid
+	virtual void translate(const Point<GPType, 2>& location, const Point<GPType, 2>& displacement, Point<GPType, 2>& out) const {
+		gpTransformer.translate(location, out, displacement);
+	}
+
+	// doc inherited from Grid
+	virtual void translate(const Point<GPType, 3>& location, const Point<GPType, 3>& displacement, Point<GPType, 3>& out) const {
+		gpTransformer.translate(location, out, displacement);
+	}
+
+	// doc inherited from Grid
+	virtual void transform(const Point<GPType, 2>& location, Point<GPType, 2>& out) const {
+		gpTransformer.transform(location, out);
+	}
+
+	// doc inherited from Grid
+	virtual void transform(const Point<GPType, 3>& location, Point<GPType, 3>& out) const {
+		gpTransformer.transform(location, out);
+	}
+
 	/**
 	 * Gets an iterator over the agents in this BaseGrid starting with the
 	 * first agent. The iterator derefrences into shared_ptr<T>. The actual
@@ -263,6 +356,17 @@ public:
 		return dimensions_;
 	}
 
+	/**
+	 * Gets the global bounds of this grid. A BaseGrid is not distributed, so
+	 * these are its dimensions. SharedBaseGrid overrides this to return the
+	 * bounds across all processes.
+	 *
+	 * @return the global bounds of this grid.
+	 */
+	virtual const GridDimensions bounds() const {
+		return dimensions_;
+	}
+
 	// doc inherited from Grid
 	virtual void translate(const Point<GPType>& location, const Point<GPType>& displacement, std::vector<GPType>& out) const {
 		gpTransformer.translate(location.coords(), out, displacement.coords());
@@ -282,16 +386,18 @@ public:
 
   virtual void updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context);
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush){ }
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush){ }
   virtual void getInfoExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom) {}
   virtual void getAgentStatusExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom) {}
 };
 
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
 BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::BaseGrid(std::string name, GridDimensions dimensions) :
-	Grid<T, GPType> (name), gpTransformer(dimensions), dimensions_(dimensions), size_(0) {
+	Grid<T, GPType> (name), gpTransformer(dimensions), dimensions_(dimensions), size_(0),
+	movePoint(std::vector<GPType>(dimensions.dimensionCount(), 0)) {
 //	gpTransformer.init(dimensions);
 	adder.init(dimensions, this);
+	cellAccessor.init(dimensions);
 }
 
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
@@ -368,14 +474,66 @@ bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::moveTo(const Agent
 	std::vector<GPType> transformedCoords(newLocation.size(), 0);
 	gpTransformer.transform(newLocation, transformedCoords);
 
-	if (iter->second->point.coords() == transformedCoords)  return true;
-	return doMove(transformedCoords, iter->second);
+	if (iter->second->inGrid && iter->second->point.coords() == transformedCoords)  return true;
+	return doMove(Point<GPType>(transformedCoords), iter->second);
 }
 
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
-bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::doMove(std::vector<GPType>& location, GridPointHolder<T,
+template<int N>
+bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::moveTo(const AgentId& id, const Point<GPType, N>& newLocation) {
+	LocationMapIter iter = agentToLocation.find(id);
+
+	if (iter == agentToLocation.end())
+		throw Repast_Error_2<AgentId>(id, Projection<T>::name()); // Agent has not yet been introduced to this space/is not present
+
+	if (N != dimensions_.dimensionCount())
+		throw Repast_Error_3(N, dimensions_.dimensionCount()); // Destination does not match the space
+
+	Point<GPType, N> transformed;
+	gpTransformer.transform(newLocation, transformed);
+
+	const Point<GPType>& current = iter->second->point;
+	if (iter->second->inGrid && std::equal(transformed.begin(), transformed.end(), current.begin())) return true;
+	movePoint.set(transformed);
+	return doMove(movePoint, iter->second);
+}
+
+template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
+template<int N>
+std::pair<bool, Point<GPType, N> > BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::moveByDisplacement(
+		const T* agent, const Point<GPType, N>& displacement) {
+	if (N != dimensions_.dimensionCount())
+		  throw Repast_Error_5(N, dimensions_.dimensionCount()); // displacement must equal number of grid/space dimensions
+
+	LocationMapIter iter = agentToLocation.find(agent->getId());
+	if (iter == agentToLocation.end())
+      throw Repast_Error_6<AgentId>(agent->getId(), Projection<T>::name()); // Agent has not in this grid / space
+
+	Point<GPType, N> location(iter->second->point);
+	Point<GPType, N> newPos;
+	gpTransformer.translate(location, newPos, displacement);
+	Point<GPType, N> transformed;
+	gpTransformer.transform(newPos, transformed);
+	if (location == transformed)
+		return std::make_pair(true, transformed);
+	movePoint.set(transformed);
+	return std::make_pair(doMove(movePoint, iter->second), transformed);
+}
+
+template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
+template<int N>
+bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::getLocation(const AgentId& id, Point<GPType, N>& out) const {
+	LocationMapConstIter iter = agentToLocation.find(id);
+	if (iter == agentToLocation.end() || !iter->second->inGrid)
+		return false;
+
+	out = Point<GPType, N>(iter->second->point);
+	return true;
+}
+
+template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
+bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::doMove(const Point<GPType>& pt, GridPointHolder<T,
 		GPType>* gpHolder) {
-	Point<GPType> pt(location);
 	if (cellAccessor.put(gpHolder->ptr, pt)) {
 		if (gpHolder->inGrid) {
 			cellAccessor.remove(gpHolder->ptr, gpHolder->point);
@@ -439,6 +597,12 @@ bool BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::addAgent(boost::sh
   return adder.add(agent);
 }
 
+template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
+void BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::addAgents(const std::vector<boost::shared_ptr<T> >& agents) {
+  agentToLocation.reserve(agentToLocation.size() + agents.size());
+  for (size_t i = 0; i < agents.size(); i++) this->addAgent(agents[i]);
+}
+
 template<typename T, typename CellAccessor, typename GPTransformer, typename Adder, typename GPType>
 void BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType>::removeAgent(T* agent) {
 	LocationMapIter iter = agentToLocation.find(agent->getId());
@@ -0,0 +1,554 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  BinnedOccupancy.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef BINNEDOCCUPANCY_H_
+#define BINNEDOCCUPANCY_H_
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Point.h"
+#include "GridDimensions.h"
+
+namespace repast {
+
+/**
+ * Multiple occupancy cell accessor that sorts the occupants of a space into
+ * uniform square bins, so that the occupants of a region of the space can be
+ * found by looking only at the bins that overlap the region. The bins of a
+ * rectangular region of the space are kept in an array; bins outside the region,
+ * for example those of the buffer of a periodic space that wraps around to the far
+ * side, are kept in a hash map.
+ *
+ * The region is set by init and the width of the bins by setBinWidth; the width
+ * is increased if needed to keep the number of bins in the region under MAX_BINS.
+ * The bin array is allocated when the first item is put in the region.
+ *
+ * @param T the type of object in the Grid
+ * @param GPType the coordinate type of the grid point locations. This must
+ * be an int or a double.
+ */
+template<typename T, typename GPType>
+class BinnedOccupancy {
+
+public:
+	/**
+	 * The largest number of bins kept in the bin array.
+	 */
+	static const size_t MAX_BINS = 1 << 20;
+
+private:
+	struct Entry {
+		boost::shared_ptr<T> agent;
+		Point<GPType> location;
+
+		Entry(const boost::shared_ptr<T>& agent, const Point<GPType>& location) :
+			agent(agent), location(location) {
+		}
+	};
+
+	typedef std::vector<Entry> Bin;
+	typedef typename boost::unordered_map<Point<int> , Bin*, HashGridPoint<int> > OverflowMap;
+	typedef typename OverflowMap::iterator OverflowMapIter;
+	typedef typename OverflowMap::const_iterator OverflowMapConstIter;
+
+	GridDimensions region;
+	double requestedWidth, binWidth;
+	std::vector<double> origin;
+	std::vector<int> binCounts;
+	std::vector<size_t> strides;
+	size_t binCount;
+	std::vector<Bin*> bins;
+	OverflowMap overflow;
+
+	void layout();
+	int binCoordinate(double coordinate, size_t dimension) const;
+	void binOf(const std::vector<GPType>& location, std::vector<int>& bin) const;
+	bool indexOf(const std::vector<int>& bin, size_t& index) const;
+	Bin* doGet(const std::vector<int>& bin) const;
+	Bin*& slot(const std::vector<int>& bin);
+	static bool nextBin(std::vector<int>& bin, const std::vector<int>& first, const std::vector<int>& last);
+	void scanBin(const Bin& entries, const std::vector<double>& lower, const std::vector<double>& upper,
+			const Point<GPType>* center, double radiusSq, std::vector<T*>* out,
+			std::vector<std::pair<double, T*> >* distances) const;
+	void doGetAll(const std::vector<double>& lower, const std::vector<double>& upper, const Point<GPType>* center,
+			double radiusSq, std::vector<T*>* out, std::vector<std::pair<double, T*> >* distances) const;
+
+public:
+
+	BinnedOccupancy();
+	virtual ~BinnedOccupancy();
+
+	/**
+	 * Sets the region of the space whose bins are kept in the bin array. Any current
+	 * occupants are kept.
+	 *
+	 * @param bounds the region
+	 */
+	void init(const GridDimensions& bounds);
+
+	/**
+	 * Sets the width of the bins. This defaults to 1. A width close to the
+	 * radius of the typical query balances the number of bins looked at against
+	 * the number of occupants tested. Any current occupants are kept.
+	 *
+	 * @param width the bin width
+	 */
+	void setBinWidth(double width);
+
+	/**
+	 * Gets the width of the bins, which may be larger than the width
+	 * that was set (see MAX_BINS).
+	 */
+	double getBinWidth() const {
+		return binWidth;
+	}
+
+	/**
+	 * Gets the first object found at the specified location.
+	 *
+	 * @param location the location to get the object at
+	 * @return the first object found at the specified location or 0 if there
+	 * are no objects at the specified location.
+	 */
+	T* get(const Point<GPType>& location) const;
+
+	/**
+	 * Gets all the items found at the specified location.
+	 *
+	 * @param location the location to get the items at
+	 * @param [out] the found items will be returned in this vector
+	 */
+	void getAll(const Point<GPType>& location, std::vector<T*>& out) const;
+
+	/**
+	 * Gets all the items whose location is within the specified box,
+	 * including its borders. Borders are not taken into account.
+	 *
+	 * @param lower the lower corner of the box
+	 * @param upper the upper corner of the box
+	 * @param [out] the found items will be returned in this vector
+	 */
+	void getAllInBox(const std::vector<double>& lower, const std::vector<double>& upper, std::vector<T*>& out) const;
+
+	/**
+	 * Gets all the items whose location is within the specified (Euclidean)
+	 * distance of the specified center. Borders are not taken into account.
+	 *
+	 * @param center the center
+	 * @param radius the distance
+	 * @param [out] the found items will be returned in this vector
+	 */
+	void getAllWithin(const Point<GPType>& center, double radius, std::vector<T*>& out) const;
+
+	/**
+	 * Gets all the items whose location is within the specified (Euclidean)
+	 * distance of the specified center, with the square of their distance.
+	 * Borders are not taken into account.
+	 *
+	 * @param center the center
+	 * @param radius the distance
+	 * @param [out] the squared distances and found items will be returned in this vector
+	 */
+	void getAllWithin(const Point<GPType>& center, double radius, std::vector<std::pair<double, T*> >& out) const;
+
+	/**
+	 * Puts the specified item at the specified location.
+	 *
+	 * @param agent the item to put
+	 * @param location the location to put the item at
+	 */
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+
+	/**
+	 * Removes the specified item from the specified location.
+	 *
+	 * @param agent the item to remove
+	 * @param location the location to remove the item from
+	 */
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+
+};
+
+template<typename T, typename GPType>
+BinnedOccupancy<T, GPType>::BinnedOccupancy() :
+	requestedWidth(1), binWidth(1), binCount(0) {
+}
+
+template<typename T, typename GPType>
+BinnedOccupancy<T, GPType>::~BinnedOccupancy() {
+	for (size_t i = 0, n = bins.size(); i < n; ++i) {
+		delete bins[i];
+	}
+	for (OverflowMapIter iter = overflow.begin(); iter != overflow.end(); ++iter) {
+		delete iter->second;
+	}
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::init(const GridDimensions& bounds) {
+	region = bounds;
+	layout();
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::setBinWidth(double width) {
+	requestedWidth = width;
+	layout();
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::layout() {
+	std::vector<Entry> occupants;
+	for (size_t i = 0, n = bins.size(); i < n; ++i) {
+		if (bins[i] != NULL) {
+			occupants.insert(occupants.end(), bins[i]->begin(), bins[i]->end());
+			delete bins[i];
+		}
+	}
+	for (OverflowMapIter iter = overflow.begin(); iter != overflow.end(); ++iter) {
+		occupants.insert(occupants.end(), iter->second->begin(), iter->second->end());
+		delete iter->second;
+	}
+	overflow.clear();
+	std::vector<Bin*>().swap(bins);
+
+	size_t dimCount = region.dimensionCount();
+	binWidth = requestedWidth;
+	double volume = 1;
+	for (size_t d = 0; d < dimCount; ++d) {
+		volume *= region.extents(d);
+	}
+	if (dimCount > 0 && volume / std::pow(binWidth, (double) dimCount) > MAX_BINS)
+		binWidth = std::pow(volume / MAX_BINS, 1.0 / dimCount);
+
+	origin.assign(dimCount, 0);
+	binCounts.assign(dimCount, 0);
+	strides.assign(dimCount, 0);
+	binCount = 1;
+	for (size_t d = 0; d < dimCount; ++d) {
+		origin[d] = region.origin(d);
+		binCounts[d] = std::max(1, (int) std::ceil(region.extents(d) / binWidth));
+		strides[d] = binCount;
+		binCount *= binCounts[d];
+	}
+
+	for (size_t i = 0, n = occupants.size(); i < n; ++i) {
+		put(occupants[i].agent, occupants[i].location);
+	}
+}
+
+template<typename T, typename GPType>
+int BinnedOccupancy<T, GPType>::binCoordinate(double coordinate, size_t dimension) const {
+	double offset = coordinate - (dimension < origin.size() ? origin[dimension] : 0);
+	return (int) std::floor(offset / binWidth);
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::binOf(const std::vector<GPType>& location, std::vector<int>& bin) const {
+	bin.resize(location.size());
+	for (size_t d = 0, n = location.size(); d < n; ++d) {
+		bin[d] = binCoordinate(location[d], d);
+	}
+}
+
+template<typename T, typename GPType>
+bool BinnedOccupancy<T, GPType>::indexOf(const std::vector<int>& bin, size_t& index) const {
+	size_t dimCount = binCounts.size();
+	if (dimCount == 0 || bin.size() != dimCount)
+		return false;
+	index = 0;
+	for (size_t d = 0; d < dimCount; ++d) {
+		if (bin[d] < 0 || bin[d] >= binCounts[d])
+			return false;
+		index += bin[d] * strides[d];
+	}
+	return true;
+}
+
+template<typename T, typename GPType>
+typename BinnedOccupancy<T, GPType>::Bin* BinnedOccupancy<T, GPType>::doGet(const std::vector<int>& bin) const {
+	size_t index;
+	if (indexOf(bin, index))
+		return bins.empty() ? NULL : bins[index];
+	if (overflow.empty())
+		return NULL;
+	OverflowMapConstIter iter = overflow.find(Point<int> (bin));
+	if (iter == overflow.end())
+		return NULL;
+	return iter->second;
+}
+
+template<typename T, typename GPType>
+typename BinnedOccupancy<T, GPType>::Bin*& BinnedOccupancy<T, GPType>::slot(const std::vector<int>& bin) {
+	size_t index;
+	if (indexOf(bin, index)) {
+		if (bins.empty())
+			bins.assign(binCount, (Bin*) NULL);
+		return bins[index];
+	}
+	return overflow[Point<int> (bin)];
+}
+
+template<typename T, typename GPType>
+T* BinnedOccupancy<T, GPType>::get(const Point<GPType>& location) const {
+	std::vector<int> bin;
+	binOf(location.coords(), bin);
+	Bin* entries = doGet(bin);
+	if (entries != NULL) {
+		for (typename Bin::const_iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+			if (iter->location == location)
+				return iter->agent.get();
+		}
+	}
+	return NULL;
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::getAll(const Point<GPType>& location, std::vector<T*>& out) const {
+	std::vector<int> bin;
+	binOf(location.coords(), bin);
+	Bin* entries = doGet(bin);
+	if (entries != NULL) {
+		for (typename Bin::const_iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+			if (iter->location == location)
+				out.push_back(iter->agent.get());
+		}
+	}
+}
+
+template<typename T, typename GPType>
+bool BinnedOccupancy<T, GPType>::nextBin(std::vector<int>& bin, const std::vector<int>& first,
+		const std::vector<int>& last) {
+	// counts along the first dimension fastest
+	size_t d = 0;
+	while (d < bin.size() && bin[d] == last[d]) {
+		bin[d] = first[d];
+		++d;
+	}
+	if (d == bin.size())
+		return false;
+	++bin[d];
+	return true;
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::scanBin(const Bin& entries, const std::vector<double>& lower,
+		const std::vector<double>& upper, const Point<GPType>* center, double radiusSq, std::vector<T*>* out,
+		std::vector<std::pair<double, T*> >* distances) const {
+	size_t dimCount = lower.size();
+	for (typename Bin::const_iterator iter = entries.begin(); iter != entries.end(); ++iter) {
+		const Point<GPType>& location = iter->location;
+		bool in = true;
+		double distSq = 0;
+		for (size_t d = 0; d < dimCount && in; ++d) {
+			in = location[d] >= lower[d] && location[d] <= upper[d];
+			if (center != NULL) {
+				double diff = location[d] - (*center)[d];
+				distSq += diff * diff;
+			}
+		}
+		if (in && (center == NULL || distSq <= radiusSq)) {
+			if (out != NULL)
+				out->push_back(iter->agent.get());
+			else
+				distances->push_back(std::make_pair(distSq, iter->agent.get()));
+		}
+	}
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::doGetAll(const std::vector<double>& lower, const std::vector<double>& upper,
+		const Point<GPType>* center, double radiusSq, std::vector<T*>* out,
+		std::vector<std::pair<double, T*> >* distances) const {
+	size_t dimCount = lower.size();
+	if (dimCount == 0 || (bins.empty() && overflow.empty()))
+		return;
+
+	std::vector<int> first(dimCount), last(dimCount);
+	double boxBins = 1;
+	for (size_t d = 0; d < dimCount; ++d) {
+		first[d] = binCoordinate(lower[d], d);
+		last[d] = binCoordinate(upper[d], d);
+		if (last[d] < first[d])
+			return;
+		boxBins *= last[d] - first[d] + 1.0;
+	}
+
+	// the bins where the box overlaps the region are in the array
+	if (!bins.empty() && dimCount == binCounts.size()) {
+		std::vector<int> from(dimCount), to(dimCount);
+		bool overlaps = true;
+		for (size_t d = 0; d < dimCount && overlaps; ++d) {
+			from[d] = std::max(first[d], 0);
+			to[d] = std::min(last[d], binCounts[d] - 1);
+			overlaps = from[d] <= to[d];
+		}
+		if (overlaps) {
+			std::vector<int> bin(from);
+			do {
+				size_t index = 0;
+				for (size_t d = 0; d < dimCount; ++d) {
+					index += bin[d] * strides[d];
+				}
+				if (bins[index] != NULL)
+					scanBin(*bins[index], lower, upper, center, radiusSq, out, distances);
+			} while (nextBin(bin, from, to));
+		}
+	}
+
+	// Those outside it are in the overflow map. A box with fewer bins than the
+	// map has looks them up; a larger one, e.g. a nearest neighbor search that
+	// has widened to most of the space, goes through the map instead.
+	if (overflow.empty())
+		return;
+	if (boxBins <= overflow.size()) {
+		std::vector<int> bin(first);
+		size_t index;
+		do {
+			if (!indexOf(bin, index)) {
+				OverflowMapConstIter iter = overflow.find(Point<int> (bin));
+				if (iter != overflow.end())
+					scanBin(*iter->second, lower, upper, center, radiusSq, out, distances);
+			}
+		} while (nextBin(bin, first, last));
+	} else {
+		for (OverflowMapConstIter iter = overflow.begin(); iter != overflow.end(); ++iter) {
+			const Point<int>& bin = iter->first;
+			bool in = bin.dimensionCount() == dimCount;
+			for (size_t d = 0; d < dimCount && in; ++d) {
+				in = bin[d] >= first[d] && bin[d] <= last[d];
+			}
+			if (in)
+				scanBin(*iter->second, lower, upper, center, radiusSq, out, distances);
+		}
+	}
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::getAllInBox(const std::vector<double>& lower, const std::vector<double>& upper,
+		std::vector<T*>& out) const {
+	doGetAll(lower, upper, NULL, 0, &out, NULL);
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::getAllWithin(const Point<GPType>& center, double radius, std::vector<T*>& out) const {
+	std::vector<double> lower, upper;
+	for (size_t d = 0, n = center.dimensionCount(); d < n; ++d) {
+		lower.push_back(center[d] - radius);
+		upper.push_back(center[d] + radius);
+	}
+	doGetAll(lower, upper, &center, radius * radius, &out, NULL);
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::getAllWithin(const Point<GPType>& center, double radius,
+		std::vector<std::pair<double, T*> >& out) const {
+	std::vector<double> lower, upper;
+	for (size_t d = 0, n = center.dimensionCount(); d < n; ++d) {
+		lower.push_back(center[d] - radius);
+		upper.push_back(center[d] + radius);
+	}
+	doGetAll(lower, upper, &center, radius * radius, NULL, &out);
+}
+
+template<typename T, typename GPType>
+bool BinnedOccupancy<T, GPType>::put(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
+	std::vector<int> bin;
+	binOf(location.coords(), bin);
+	Bin*& entries = slot(bin);
+	if (entries == NULL) {
+		entries = new Bin();
+	} else {
+		for (typename Bin::const_iterator iter = entries->begin(); iter != entries->end(); ++iter) {
+			if (iter->agent == agent && iter->location == location)
+				return true;
+		}
+	}
+	entries->push_back(Entry(agent, location));
+
+	return true;
+}
+
+template<typename T, typename GPType>
+void BinnedOccupancy<T, GPType>::remove(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
+	std::vector<int> bin;
+	binOf(location.coords(), bin);
+	size_t index;
+	Bin** entries;
+	OverflowMapIter iter;
+	bool inArray = indexOf(bin, index);
+	if (inArray) {
+		if (bins.empty())
+			return;
+		entries = &bins[index];
+	} else {
+		iter = overflow.find(Point<int> (bin));
+		if (iter == overflow.end())
+			return;
+		entries = &iter->second;
+	}
+	if (*entries == NULL)
+		return;
+
+	for (typename Bin::iterator entryIter = (*entries)->begin(); entryIter != (*entries)->end(); ++entryIter) {
+		if (entryIter->agent == agent) {
+			*entryIter = (*entries)->back();
+			(*entries)->pop_back();
+			if ((*entries)->empty()) {
+				delete *entries;
+				if (inArray) {
+					*entries = NULL;
+				} else {
+					overflow.erase(iter);
+				}
+			}
+			return;
+		}
+	}
+}
+
+}
+
+#endif /* BINNEDOCCUPANCY_H_ */
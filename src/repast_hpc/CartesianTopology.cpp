@@ -39,6 +39,9 @@
  */
 
 #include "CartesianTopology.h"
+#include "RepastErrors.h"
+
+#include <cmath>
 
 
 using namespace std;
@@ -47,7 +50,7 @@ namespace repast {
 
 
 CartesianTopology::CartesianTopology(vector<int> processesPerDim, bool spaceIsPeriodic, boost::mpi::communicator* comm) :
-  periodic(spaceIsPeriodic), procsPerDim(processesPerDim) {
+  periodic(spaceIsPeriodic), procsPerDim(processesPerDim), partitionVersion(0) {
   int numDims = procsPerDim.size();
   int* periods = new int[numDims];
   int periodicFlag = periodic ? 1 : 0;
@@ -90,11 +93,26 @@ GridDimensions CartesianTopology::getDimensions(int rank, GridDimensions globalB
   return getDimensions(coords, globalBoundaries);
 }
 
+// Boundaries set from a partition may land a rounding error away from a whole
+// number; as grids and value layers rely on whole-number boundaries, these are snapped
+static double snapBoundary(double boundary, double extent) {
+  double whole = std::floor(boundary + 0.5);
+  return (std::fabs(boundary - whole) <= 1e-9 * (extent > 1 ? extent : 1)) ? whole : boundary;
+}
+
 GridDimensions CartesianTopology::getDimensions(vector<int>& pCoordinates, GridDimensions globalBoundaries) {
   vector<double> origins, extents;
   for (size_t i = 0; i < pCoordinates.size(); i++) {
-    double lower = globalBoundaries.origin(i) + ( (double)pCoordinates[i]      / (double)procsPerDim[i]) * globalBoundaries.extents(i);
-    double upper = globalBoundaries.origin(i) + (((double)pCoordinates[i] + 1 )/ (double)procsPerDim[i]) * globalBoundaries.extents(i);
+    double lower, upper;
+    if(partition.empty()){
+      lower = globalBoundaries.origin(i) + ( (double)pCoordinates[i]      / (double)procsPerDim[i]) * globalBoundaries.extents(i);
+      upper = globalBoundaries.origin(i) + (((double)pCoordinates[i] + 1 )/ (double)procsPerDim[i]) * globalBoundaries.extents(i);
+    }
+    else{
+      double extent = globalBoundaries.extents(i);
+      lower = snapBoundary(globalBoundaries.origin(i) + partition[i][pCoordinates[i]]     * extent, extent);
+      upper = snapBoundary(globalBoundaries.origin(i) + partition[i][pCoordinates[i] + 1] * extent, extent);
+    }
     origins.push_back(lower);
     extents.push_back(upper - lower);
   }
@@ -145,4 +163,28 @@ bool CartesianTopology::matches(std::vector<int> processesPerDim, bool spaceIsPe
     return true;
   }
 
+void CartesianTopology::getPartition(std::vector<std::vector<double> >& fractions) const {
+  if(!partition.empty()){
+    fractions = partition;
+    return;
+  }
+  fractions.assign(procsPerDim.size(), std::vector<double>());
+  for(size_t i = 0; i < procsPerDim.size(); i++){
+    for(int j = 0; j <= procsPerDim[i]; j++) fractions[i].push_back((double)j / (double)procsPerDim[i]);
+  }
+}
+
+void CartesianTopology::setPartition(const std::vector<std::vector<double> >& fractions){
+  if(fractions.size() != procsPerDim.size()) throw Repast_Error_61(procsPerDim.size(), fractions.size());
+  for(size_t i = 0; i < procsPerDim.size(); i++){
+    const std::vector<double>& dim = fractions[i];
+    if(dim.size() != (size_t)(procsPerDim[i] + 1) || dim.front() != 0 || dim.back() != 1) throw Repast_Error_61(procsPerDim.size(), fractions.size());
+    for(size_t j = 1; j < dim.size(); j++){
+      if(dim[j] <= dim[j - 1]) throw Repast_Error_61(procsPerDim.size(), fractions.size());
+    }
+  }
+  partition = fractions;
+  partitionVersion++;
+}
+
 }
@@ -57,6 +57,8 @@ class CartesianTopology {
 private:
   bool               periodic;
   std::vector<int>   procsPerDim;
+  std::vector<std::vector<double> > partition; // Per dimension, the fractions of the global extent at which each process's slab begins and the last ends; empty if uniform
+  int                partitionVersion;
 
 public:
   MPI_Comm           topologyComm;
@@ -106,6 +108,39 @@ public:
    * the value for each dimension matches.
    */
   bool matches(std::vector<int> processesPerDim, bool spaceIsPeriodic);
+
+  /**
+   * Gets the number of processes in each dimension
+   */
+  const std::vector<int>& getProcessesPerDimension() const {
+    return procsPerDim;
+  }
+
+  /**
+   * Gets the current partition of the global boundaries. For each
+   * dimension the vector holds one more value than there are processes
+   * in that dimension: the fraction of the global extent at which the
+   * slab of the processes at each coordinate begins, followed by 1.
+   * Unless setPartition has been called these are evenly spaced.
+   */
+  void getPartition(std::vector<std::vector<double> >& fractions) const;
+
+  /**
+   * Sets the partition of the global boundaries, in the form returned
+   * by getPartition, so that processes may be given slabs of different
+   * extents. Every process must set the same partition, and any spaces
+   * and value layers using this topology must then be updated to it (see
+   * SharedBaseGrid::repartition).
+   */
+  void setPartition(const std::vector<std::vector<double> >& fractions);
+
+  /**
+   * Gets a number that changes each time the partition is set, so that
+   * the users of this topology can tell when their boundaries have changed
+   */
+  int getPartitionVersion() const {
+    return partitionVersion;
+  }
 };
 }
 
@@ -43,15 +43,20 @@
 
 #include <vector>
 #include <set>
+#include <iterator>
 
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 #include <boost/smart_ptr.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/function.hpp>
 
 #include "AgentId.h"
 #include "AgentRequest.h"
+#include "AgentSlabs.h"
+#include "NodePool.h"
 #include "Random.h"
 #include "ValueLayer.h"
 #include "Projection.h"
@@ -71,6 +76,119 @@ struct SecondElement: public std::unary_function<typename boost::unordered_map<A
   }
 };
 
+/**
+ * An agent in a Context with HASH_MAP storage, and its position in
+ * the Context's array of agents of its type.
+ */
+template<typename T>
+struct AgentMapEntry {
+	boost::shared_ptr<T> agent;
+	size_t index;
+};
+
+/**
+ * Forward iterator over the agents in a Context, whichever storage the
+ * Context uses. Dereferences into a const reference to the agent's shared_ptr.
+ */
+template<typename T>
+class ContextIterator: public boost::iterator_facade<ContextIterator<T> , const boost::shared_ptr<T>, boost::forward_traversal_tag> {
+
+private:
+	typedef typename boost::unordered_map<AgentId, AgentMapEntry<T>, HashId>::const_iterator MapIterator;
+	typedef typename AgentSlabs<T>::const_iterator SlabIterator;
+
+	friend class boost::iterator_core_access;
+
+	MapIterator mapIter;
+	SlabIterator slabIter;
+	bool inSlabs;
+
+	void increment() {
+		if (inSlabs) ++slabIter;
+		else ++mapIter;
+	}
+
+	bool equal(const ContextIterator& other) const {
+		return inSlabs ? slabIter == other.slabIter : mapIter == other.mapIter;
+	}
+
+	const boost::shared_ptr<T>& dereference() const {
+		return inSlabs ? *slabIter : mapIter->second.agent;
+	}
+
+public:
+	ContextIterator() :
+		inSlabs(false) {
+	}
+
+	explicit ContextIterator(MapIterator iter) :
+		mapIter(iter), inSlabs(false) {
+	}
+
+	explicit ContextIterator(SlabIterator iter) :
+		slabIter(iter), inSlabs(true) {
+	}
+};
+
+template<typename T>
+class Context;
+
+/**
+ * Random access iterator over the agents in a Context by their position in
+ * the Context's arrays of agents of each type, either in the array of a
+ * single type or in all the arrays in turn. Dereferences into a const
+ * reference to the agent's shared_ptr.
+ */
+template<typename T>
+class ContextArrayIterator: public boost::iterator_facade<ContextArrayIterator<T> , const boost::shared_ptr<T>, boost::random_access_traversal_tag> {
+
+private:
+	friend class boost::iterator_core_access;
+
+	const Context<T>* context;
+	int array; // -1 for all the arrays in turn
+	std::ptrdiff_t index;
+
+	void increment() {
+		index++;
+	}
+
+	void decrement() {
+		index--;
+	}
+
+	void advance(std::ptrdiff_t n) {
+		index += n;
+	}
+
+	std::ptrdiff_t distance_to(const ContextArrayIterator& other) const {
+		return other.index - index;
+	}
+
+	bool atEnd() const {
+		return index >= (std::ptrdiff_t) context->arraySize(array);
+	}
+
+	// All iterators past the end of their range are equal, as the end
+	// iterators of the filtered ranges these replace were
+	bool equal(const ContextArrayIterator& other) const {
+		if (array == other.array && index == other.index) return true;
+		return context != 0 && other.context != 0 && atEnd() && other.atEnd();
+	}
+
+	const boost::shared_ptr<T>& dereference() const {
+		return context->arrayAgent(array, index);
+	}
+
+public:
+	ContextArrayIterator() :
+		context(0), array(-1), index(0) {
+	}
+
+	ContextArrayIterator(const Context<T>* context, int array, std::ptrdiff_t index) :
+		context(context), array(array), index(index) {
+	}
+};
 
 /**
  * Collection of agents of type T with set semantics. Object identity and equality
@@ -83,24 +201,114 @@ class Context {
 
 private:
 
+	friend class ContextArrayIterator<T>;
+
 	typedef typename std::vector<Projection<T>*>::iterator ProjPtrIter;
-	typedef typename boost::unordered_map<AgentId, boost::shared_ptr<T>, HashId> AgentMap;
+	typedef typename boost::unordered_map<AgentId, AgentMapEntry<T>, HashId> AgentMap;
 
 	typedef typename AgentMap::iterator AgentMapIterator;
 	typedef typename AgentMap::const_iterator AgentMapConstIterator;
 
+	typedef std::vector<AgentMapEntry<T>*> EntryArray;
+
 	AgentMap agents;
+	// the agents of each type in HASH_MAP storage, in increasing order of type,
+	// so that they can be picked by position. Removing an agent moves the last
+	// agent of its type into its place.
+	std::vector<std::pair<int, EntryArray> > typeArrays;
+	AgentSlabs<T> slabs;
 	std::map<std::string, BaseValueLayer*> valueLayers;
 
 protected:
   std::vector<Projection<T> *> projections;
 
+	/**
+	 * Called when an agent has been added to this context, before it is
+	 * added to the projections. Does nothing by default.
+	 *
+	 * @param agent the added agent
+	 */
+	virtual void agentAdded(const boost::shared_ptr<T>& agent) {
+	}
+
+	/**
+	 * Called when an agent is about to be removed from this context, after
+	 * it has been removed from the projections. Does nothing by default.
+	 *
+	 * @param id the id of the agent being removed
+	 */
+	virtual void agentRemoved(const AgentId& id) {
+	}
+
 public:
 
-	typedef typename boost::transform_iterator<SecondElement<T> , typename AgentMap::const_iterator> const_iterator;
-	typedef typename boost::filter_iterator<IsAgentType<T> , typename Context<T>::const_iterator> const_bytype_iterator;
+	/**
+	 * How a Context stores its agents. HASH_MAP keeps them in a hash map keyed
+	 * by AgentId. SLABS keeps them in per-type slabs with a dense id index (see
+	 * AgentSlabs), which is faster to iterate and to add to and remove from,
+	 * and iterates the agents grouped by type.
+	 */
+	enum STORAGE {
+		HASH_MAP, SLABS
+	};
+
+private:
+	STORAGE storage;
+
+	struct TypeBefore {
+		bool operator()(const std::pair<int, EntryArray>& array, int type) const {
+			return array.first < type;
+		}
+	};
+
+	int arrayIndex(int type) const {
+		if (storage == SLABS) return slabs.typeIndex(type);
+		typename std::vector<std::pair<int, EntryArray> >::const_iterator iter = std::lower_bound(typeArrays.begin(),
+				typeArrays.end(), type, TypeBefore());
+		return (iter != typeArrays.end() && iter->first == type) ? (int) (iter - typeArrays.begin()) : -1;
+	}
 
-	Context();
+	// stores the agent unless there is one with the same id, returning the
+	// agent in the context; ptr is set to the agent's shared_ptr if it was stored
+	T* store(T* agent, boost::shared_ptr<T>& ptr);
+
+	// the number of agents in the array, or in all of them for -1
+	size_t arraySize(int array) const {
+		if (array == -1) return size();
+		return storage == SLABS ? slabs.typeSize(array) : typeArrays[array].second.size();
+	}
+
+	const boost::shared_ptr<T>& arrayAgent(int array, size_t index) const {
+		if (array == -1) {
+			size_t arrays = (storage == SLABS ? slabs.typeCount() : typeArrays.size());
+			for (array = 0; array < (int) arrays - 1; array++) {
+				size_t size = arraySize(array);
+				if (index < size) break;
+				index -= size;
+			}
+		}
+		if (storage == SLABS) return slabs.agentAt(array, index);
+		return typeArrays[array].second[index]->agent;
+	}
+
+public:
+
+	typedef ContextIterator<T> const_iterator;
+	typedef ContextArrayIterator<T> const_bytype_iterator;
+
+	/**
+	 * Creates a Context that stores its agents as specified.
+	 *
+	 * @param storage how the agents are stored
+	 */
+	Context(STORAGE storage = HASH_MAP);
+
+	/**
+	 * Gets how this Context stores its agents.
+	 */
+	STORAGE getStorage() const {
+		return storage;
+	}
 
 	/**
 	 * Destroys this context and the projections it contains.
@@ -125,6 +333,21 @@ public:
 	 */
 	T* addAgent(T* agent);
 
+	/**
+	 * Adds the agents to the context, as addAgent does for each of them, but
+	 * reserves room for them once and hands those that were added to each
+	 * projection in a single batch.
+	 *
+	 * @param begin the start of the range of agents (T*) to add
+	 * @param end the end of the range of agents to add
+	 * @param [out] inContext a vector to which, for each of the agents in turn,
+	 * the address of the agent in the context is appended; see addAgent
+	 *
+	 * @tparam AgentIterator a forward iterator over T*
+	 */
+	template<typename AgentIterator>
+	void addAgents(AgentIterator begin, AgentIterator end, std::vector<T*>& inContext);
+
 	/**
 	 * Adds the specified projection to this context. All the agents in this
 	 * context will be added to the Projection. Any agents subsequently added
@@ -164,7 +387,9 @@ public:
 
 	/**
 	 * Gets at random the specified count of agents and returns them
-	 * in the agents vector.
+	 * in the agents vector. Agents already in the vector are not picked
+	 * again, and if there are fewer than count agents left to pick, all of
+	 * them are returned. Each pick takes constant time on average.
 	 *
 	 * @param count the number of agents to get
 	 * @param [out] agents a vector where the agents will be returned
@@ -179,7 +404,7 @@ public:
 	 * @return the start of iterator over the agents in this context.
 	 */
 	const_iterator begin() const {
-		return const_iterator(agents.begin());
+		return storage == SLABS ? const_iterator(slabs.begin()) : const_iterator(agents.begin());
 	}
 
 	/**
@@ -190,7 +415,7 @@ public:
 	 * @return  the end of an iterator over the agents in this context
 	 */
 	const_iterator end() const {
-		return const_iterator(agents.end());
+		return storage == SLABS ? const_iterator(slabs.end()) : const_iterator(agents.end());
 	}
 
 	/**
@@ -203,7 +428,8 @@ public:
 	 * @return the start of an iterator over agents in this context of the specified type.
 	 */
 	const_bytype_iterator byTypeBegin(int typeId) const {
-		return const_bytype_iterator(IsAgentType<T> (typeId), Context<T>::begin(), Context<T>::end());
+		int array = arrayIndex(typeId);
+		return array == -1 ? const_bytype_iterator(this, -1, size()) : const_bytype_iterator(this, array, 0);
 	}
 
 	/**
@@ -216,7 +442,9 @@ public:
 	 * @return the end of an iterator over agents in this context of the specified type.
 	 */
 	const_bytype_iterator byTypeEnd(int typeId) const {
-		return const_bytype_iterator(IsAgentType<T> (typeId), Context<T>::end(), Context<T>::end());
+		int array = arrayIndex(typeId);
+		if (array == -1) return const_bytype_iterator(this, -1, size());
+		return const_bytype_iterator(this, array, arraySize(array));
 	}
 
 	/**
@@ -228,7 +456,33 @@ public:
 	 * Gets the size (number of agents) in this context.
 	 */
 	int size() const {
-		return agents.size();
+		return storage == SLABS ? slabs.size() : agents.size();
+	}
+
+	/**
+	 * Gets the number of agents of the specified type in this context. The type
+	 * corresponds to the type component of an agent's AgentId.
+	 *
+	 * @param typeId the type of the agents to count
+	 */
+	int size(int typeId) const {
+		return byTypeEnd(typeId) - byTypeBegin(typeId);
+	}
+
+	/**
+	 * Gets the types of the agents that have been added to this context. A type
+	 * stays listed after all its agents have been removed.
+	 *
+	 * @param [out] types a vector into which the types are placed, in increasing order
+	 */
+	void getAgentTypes(std::vector<int>& types) const {
+		if (storage == SLABS) {
+			for (size_t i = 0; i < slabs.typeCount(); i++)
+				types.push_back(slabs.typeAt(i));
+		} else {
+			for (size_t i = 0; i < typeArrays.size(); i++)
+				types.push_back(typeArrays[i].first);
+		}
 	}
 
 	/**
@@ -798,7 +1052,7 @@ public:
    * be customized depending on the destination process). If not specified a larger set of information
    * will be sent.
    */
-  void getProjectionInfo(AgentRequest req, std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& map,
+  void getProjectionInfo(const AgentRequest& req, std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& map,
       bool secondaryInfo = false, std::set<AgentId>* secondaryIds = 0, int destProc = -1);
 
   /**
@@ -809,19 +1063,21 @@ public:
    */
   void setProjectionInfo(std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& projInfo);
 
-  void cleanProjectionInfo(std::set<AgentId>& agentsToKeep);
+  void cleanProjectionInfo(AgentIdSet& agentsToKeep);
 
 };
 
 
 
 template<typename T>
-Context<T>::Context() {
+Context<T>::Context(STORAGE storage) : storage(storage) {
 }
 
 template<typename T>
 Context<T>::~Context() {
+	typeArrays.clear();
 	agents.erase(agents.begin(), agents.end());
+	slabs.clear();
 	for (ProjPtrIter iter = projections.begin(); iter != projections.end(); ++iter) {
 		Projection<T>* proj = *iter;
 		delete proj;
@@ -859,37 +1115,45 @@ Projection<T>* Context<T>::getProjection(const std::string& name) {
 
 template<typename T>
 T* Context<T>::getAgent(const AgentId& id) {
+  if (storage == SLABS) {
+    const boost::shared_ptr<T>* ptr = slabs.find(id);
+    return ptr == 0 ? 0 : ptr->get();
+  }
   AgentMapIterator iter = agents.find(id);
   if (iter == agents.end()) return 0;
-  return iter->second.get();
+  return iter->second.agent.get();
 }
 
 template<typename T>
 void Context<T>::getRandomAgents(const int count, std::vector<T*>& agents) {
-	for (int i = 0; i < count; i++) {
-		IntUniformGenerator rnd = Random::instance()->createUniIntGenerator(0, size() - 1);
-		bool found = false;
-		while (!found) {
-			const_iterator iter = begin();
-			for (int j = 0, n = rnd.next(); j < n; iter++, j++)
-				;
-			T* agent = iter->get();
-			if (find(agents.begin(), agents.end(), agent) == agents.end()) {
-				agents.push_back(agent);
-				found = true;
-			}
+	// agents already in the vector are not picked again
+	boost::unordered_set<T*> excluded(agents.begin(), agents.end());
+	// partial Fisher-Yates shuffle of the positions in the agent arrays;
+	// only the positions that have been swapped are stored
+	boost::unordered_map<int, int> swapped;
+	ContextArrayIterator<T> all(this, -1, 0);
+	int n = size();
+	for (int i = 0, found = 0; i < n && found < count; i++) {
+		int j = i + (int) (Random::instance()->nextDouble() * (n - i));
+		typename boost::unordered_map<int, int>::iterator atJ = swapped.find(j);
+		int pick = (atJ == swapped.end() ? j : atJ->second);
+		if (j != i) {
+			typename boost::unordered_map<int, int>::iterator atI = swapped.find(i);
+			swapped[j] = (atI == swapped.end() ? i : atI->second);
+		}
+		T* agent = (*(all + pick)).get();
+		if (excluded.empty() || excluded.find(agent) == excluded.end()) {
+			agents.push_back(agent);
+			found++;
 		}
 	}
 }
 
 template<typename T>
 T* Context<T>::addAgent(T* agent) {
-	const AgentId& id = agent->getId();
-	typename AgentMap::iterator findIter = agents.find(id);
-	if (findIter != agents.end())    return &*(findIter->second);
-
-	boost::shared_ptr<T> ptr(agent);
-	agents[id] = ptr;
+	boost::shared_ptr<T> ptr;
+	T* inContext = store(agent, ptr);
+	if (inContext != agent) return inContext;
 
 	for (ProjPtrIter iter = projections.begin(); iter != projections.end(); ++iter) {
 		Projection<T>* proj = *iter;
@@ -899,6 +1163,61 @@ T* Context<T>::addAgent(T* agent) {
 	return agent;
 }
 
+template<typename T>
+template<typename AgentIterator>
+void Context<T>::addAgents(AgentIterator begin, AgentIterator end, std::vector<T*>& inContext) {
+	size_t count = std::distance(begin, end);
+	if (storage == SLABS)
+		slabs.reserve(slabs.size() + count);
+	else
+		agents.reserve(agents.size() + count);
+	inContext.reserve(inContext.size() + count);
+
+	std::vector<boost::shared_ptr<T> > added;
+	added.reserve(count);
+	boost::shared_ptr<T> ptr;
+	for (AgentIterator iter = begin; iter != end; ++iter) {
+		T* agent = *iter;
+		T* stored = store(agent, ptr);
+		if (stored == agent) added.push_back(ptr);
+		inContext.push_back(stored);
+	}
+
+	for (ProjPtrIter iter = projections.begin(); iter != projections.end(); ++iter) {
+		Projection<T>* proj = *iter;
+		proj->addAgents(added);
+	}
+}
+
+template<typename T>
+T* Context<T>::store(T* agent, boost::shared_ptr<T>& ptr) {
+	const AgentId& id = agent->getId();
+	if (storage == SLABS) {
+		const boost::shared_ptr<T>* found = slabs.find(id);
+		if (found != 0) return found->get();
+
+		// the shared_ptr control blocks come from the node pools
+		ptr = boost::shared_ptr<T>(agent, boost::checked_deleter<T>(), PoolAllocator<T>());
+		slabs.insert(ptr);
+	} else {
+		typename AgentMap::iterator findIter = agents.find(id);
+		if (findIter != agents.end())    return &*(findIter->second.agent);
+
+		ptr = boost::shared_ptr<T>(agent);
+		AgentMapEntry<T>& entry = agents[id];
+		entry.agent = ptr;
+
+		typename std::vector<std::pair<int, EntryArray> >::iterator array = std::lower_bound(typeArrays.begin(),
+				typeArrays.end(), id.agentType(), TypeBefore());
+		if (array == typeArrays.end() || array->first != id.agentType())
+			array = typeArrays.insert(array, std::make_pair(id.agentType(), EntryArray()));
+		entry.index = array->second.size();
+		array->second.push_back(&entry);
+	}
+	agentAdded(ptr);
+	return agent;
+}
+
 template<typename T>
 void Context<T>::removeAgent(T* agent) {
 	removeAgent(agent->getId());
@@ -906,19 +1225,40 @@ void Context<T>::removeAgent(T* agent) {
 
 template<typename T>
 void Context<T>::removeAgent(const AgentId id) {
+	if (storage == SLABS) {
+		const boost::shared_ptr<T>* ptr = slabs.find(id);
+		if (ptr != 0) {
+			for (ProjPtrIter pIter = projections.begin(); pIter != projections.end(); ++pIter) {
+				Projection<T>* proj = *pIter;
+				proj->removeAgent(ptr->get());
+			}
+			agentRemoved(id);
+			slabs.erase(id);
+		}
+		return;
+	}
 	const AgentMapIterator iter = agents.find(id);
 	if (iter != agents.end()) {
-		boost::shared_ptr<T>& ptr = iter->second;
+		boost::shared_ptr<T>& ptr = iter->second.agent;
 		for (ProjPtrIter pIter = projections.begin(); pIter != projections.end(); ++pIter) {
 			Projection<T>* proj = *pIter;
 			proj->removeAgent(ptr.get());
 		}
+		agentRemoved(id);
+
+		// the last agent of the type takes the removed agent's place
+		EntryArray& array = typeArrays[arrayIndex(id.agentType())].second;
+		size_t index = iter->second.index;
+		array[index] = array.back();
+		array[index]->index = index;
+		array.pop_back();
 		agents.erase(iter);
 	}
 }
 
 template<typename T>
 bool Context<T>::contains(const AgentId& id) {
+	if (storage == SLABS) return slabs.find(id) != 0;
 	return agents.find(id) != agents.end();
 }
 
@@ -996,12 +1336,12 @@ void Context<T>::selectAgents(std::vector<T*>& selectedAgents, bool remove){
 	
 template<typename T>
 void Context<T>::selectAgents(int count, std::set<T*>& selectedAgents, bool remove){
-	selectNElementsAtRandom(begin(), size(), count, selectedAgents, remove);
+	selectNElementsAtRandom(ContextArrayIterator<T>(this, -1, 0), size(), count, selectedAgents, remove);
 }
 	
 template<typename T>
 void Context<T>::selectAgents(int count, std::vector<T*>& selectedAgents, bool remove){
-	selectNElementsInRandomOrder(begin(), end(), count, selectedAgents, remove);
+	selectNElementsInRandomOrder(ContextArrayIterator<T>(this, -1, 0), size(), count, selectedAgents, remove);
 }
 	
 template<typename T>
@@ -1088,24 +1428,24 @@ void Context<T>::selectAgents(int count, std::vector<T*>& selectedAgents, int ty
 // Beta
 
 template<typename T>
-void Context<T>::getProjectionInfo(AgentRequest req, std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& map,
+void Context<T>::getProjectionInfo(const AgentRequest& req, std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& map,
     bool secondaryInfo, std::set<AgentId>* secondaryIds, int destProc){
   std::vector<AgentId> ids = req.requestedAgents();
   for(typename std::vector<Projection<T> *>::iterator iter = projections.begin(), iterEnd = projections.end(); iter != iterEnd; iter++){
-    std::string projName = (*iter)->name();
-    map[projName] = std::vector<repast::ProjectionInfoPacket*>(); // New, then inserted into collection
-    (*iter)->getProjectionInfo(ids, map[projName], secondaryInfo, secondaryIds, destProc);
+    std::vector<repast::ProjectionInfoPacket*>& packets = map[(*iter)->name()]; // Reuses the vector if the map is reused
+    packets.clear();
+    (*iter)->getProjectionInfo(ids, packets, secondaryInfo, secondaryIds, destProc);
   }
 }
 
 template<typename T>
 void Context<T>::setProjectionInfo(std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >& projInfo){
   for(std::map<std::string, std::vector<repast::ProjectionInfoPacket*> >::iterator iter = projInfo.begin(), iterEnd = projInfo.end(); iter != iterEnd; iter++)
-      getProjection(iter->first)->updateProjectionInfo(iter->second, this);
+      if(iter->second.size() > 0) getProjection(iter->first)->updateProjectionInfo(iter->second, this); // Empty entries may be left in reused maps
 }
 
 template<typename T>
-void Context<T>::cleanProjectionInfo(std::set<AgentId>& agentsToKeep){
+void Context<T>::cleanProjectionInfo(AgentIdSet& agentsToKeep){
   for(typename std::vector<Projection<T> *>::iterator iter = projections.begin(), iterEnd = projections.end(); iter != iterEnd; iter++){
       (*iter)->cleanProjectionInfo(agentsToKeep);
   }
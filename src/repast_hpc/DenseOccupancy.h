@@ -0,0 +1,296 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  DenseOccupancy.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef DENSEOCCUPANCY_H_
+#define DENSEOCCUPANCY_H_
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Point.h"
+#include "GridDimensions.h"
+
+namespace repast {
+
+/**
+ * Multiple occupancy cell accessor that keeps the occupants of each location
+ * of a rectangular region in a contiguous array of cells indexed by the
+ * linearised coordinates of the location, so that getting the occupants of a
+ * location is an array lookup rather than a hash lookup. This suits grids in
+ * which most locations of the region are looked at, such as neighborhood queries
+ * over densely populated discrete grids. Locations outside the region, for example
+ * the buffer of a periodic grid that wraps around to the far side, are kept in
+ * a hash map as in MultipleOccupancy.
+ *
+ * The region is set by init; until then, all locations are kept in the hash map.
+ * The cell array is allocated when the first item is put in the region, and
+ * then costs one empty vector per cell whether the cell is occupied or not. The
+ * cells are stored by value, so an occupied cell costs only the storage of its
+ * occupants; a cell keeps that storage when it is emptied, so agents moving
+ * about the region allocate only when a cell holds more agents than it ever
+ * has before.
+ *
+ * @param T the type of object in the Grid
+ * @param GPType the coordinate type of the grid point locations. This must
+ * be an int.
+ */
+template<typename T, typename GPType>
+class DenseOccupancy {
+
+private:
+	typedef std::vector<boost::shared_ptr<T> > Cell;
+	typedef typename boost::unordered_map<Point<GPType> , Cell, HashGridPoint<GPType> > OverflowMap;
+	typedef typename OverflowMap::iterator OverflowMapIter;
+	typedef typename OverflowMap::const_iterator OverflowMapConstIter;
+
+	std::vector<GPType> origin;
+	std::vector<GPType> extents;
+	std::vector<size_t> strides;
+	size_t cellCount;
+	std::vector<Cell> cells;
+	OverflowMap overflow;
+
+	bool indexOf(const Point<GPType>& location, size_t& index) const;
+	Point<GPType> pointAt(size_t index) const;
+	const Cell* doGet(const Point<GPType>& location) const;
+	Cell& slot(const Point<GPType>& location);
+
+public:
+
+	DenseOccupancy();
+	virtual ~DenseOccupancy();
+
+	/**
+	 * Sets the region whose locations are kept in the cell array. Any current
+	 * occupants are kept, in the array if their location is in the new region and
+	 * in the hash map otherwise.
+	 *
+	 * @param bounds the region
+	 */
+	void init(const GridDimensions& bounds);
+
+	/**
+	 * Gets the first object found at the specified location.
+	 *
+	 * @param location the location to get the object at
+	 * @return the first object found at the specified location or 0 if there
+	 * are no objects at the specified location.
+	 */
+	T* get(const Point<GPType>& location) const;
+
+	/**
+	 * Gets all the items found at the specified location.
+	 *
+	 * @param location the location to get the items at
+	 * @param [out] the found items will be returned in this vector
+	 */
+	void getAll(const Point<GPType>& location, std::vector<T*>& out) const;
+
+	/**
+	 * Puts the specified item at the specified location.
+	 *
+	 * @param agent the item to put
+	 * @param location the location to put the item at
+	 */
+	bool put(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+
+	/**
+	 * Removes the specified item from the specified location.
+	 *
+	 * @param agent the item to remove
+	 * @param location the location to remove the item from
+	 */
+	void remove(boost::shared_ptr<T>& agent, const Point<GPType>& location);
+
+};
+
+template<typename T, typename GPType>
+DenseOccupancy<T, GPType>::DenseOccupancy() : cellCount(0) {
+}
+
+template<typename T, typename GPType>
+DenseOccupancy<T, GPType>::~DenseOccupancy() {
+}
+
+template<typename T, typename GPType>
+bool DenseOccupancy<T, GPType>::indexOf(const Point<GPType>& location, size_t& index) const {
+	size_t dimCount = origin.size();
+	if (dimCount == 0 || location.dimensionCount() != dimCount)
+		return false;
+	index = 0;
+	for (size_t d = 0; d < dimCount; ++d) {
+		GPType offset = location[d] - origin[d];
+		if (offset < 0 || offset >= extents[d])
+			return false;
+		index += offset * strides[d];
+	}
+	return true;
+}
+
+template<typename T, typename GPType>
+Point<GPType> DenseOccupancy<T, GPType>::pointAt(size_t index) const {
+	std::vector<GPType> coords(origin.size(), 0);
+	for (size_t d = origin.size(); d-- > 0;) {
+		coords[d] = origin[d] + index / strides[d];
+		index %= strides[d];
+	}
+	return Point<GPType> (coords);
+}
+
+template<typename T, typename GPType>
+const typename DenseOccupancy<T, GPType>::Cell* DenseOccupancy<T, GPType>::doGet(const Point<GPType>& location) const {
+	size_t index;
+	if (indexOf(location, index)) {
+		if (cells.empty() || cells[index].empty())
+			return NULL;
+		return &cells[index];
+	}
+	if (overflow.empty())
+		return NULL;
+	OverflowMapConstIter iter = overflow.find(location);
+	if (iter == overflow.end())
+		return NULL;
+	return &iter->second;
+}
+
+template<typename T, typename GPType>
+typename DenseOccupancy<T, GPType>::Cell& DenseOccupancy<T, GPType>::slot(const Point<GPType>& location) {
+	size_t index;
+	if (indexOf(location, index)) {
+		if (cells.empty())
+			cells.resize(cellCount);
+		return cells[index];
+	}
+	return overflow[location];
+}
+
+template<typename T, typename GPType>
+void DenseOccupancy<T, GPType>::init(const GridDimensions& bounds) {
+	// the occupants are moved, not copied, from the old cells to the new
+	std::vector<std::pair<Point<GPType> , Cell> > occupied;
+	for (size_t i = 0, n = cells.size(); i < n; ++i) {
+		if (!cells[i].empty()) {
+			occupied.push_back(std::make_pair(pointAt(i), Cell()));
+			occupied.back().second.swap(cells[i]);
+		}
+	}
+	for (OverflowMapIter iter = overflow.begin(); iter != overflow.end(); ++iter) {
+		occupied.push_back(std::make_pair(iter->first, Cell()));
+		occupied.back().second.swap(iter->second);
+	}
+	overflow.clear();
+
+	size_t dimCount = bounds.dimensionCount();
+	origin.assign(dimCount, 0);
+	extents.assign(dimCount, 0);
+	strides.assign(dimCount, 0);
+	cellCount = 1;
+	for (size_t d = 0; d < dimCount; ++d) {
+		origin[d] = (GPType) std::floor(bounds.origin(d));
+		extents[d] = (GPType) std::ceil(bounds.extents(d));
+		strides[d] = cellCount;
+		cellCount *= extents[d];
+	}
+	std::vector<Cell>().swap(cells);
+
+	for (size_t i = 0, n = occupied.size(); i < n; ++i) {
+		slot(occupied[i].first).swap(occupied[i].second);
+	}
+}
+
+template<typename T, typename GPType>
+T* DenseOccupancy<T, GPType>::get(const Point<GPType>& location) const {
+	const Cell* cell = doGet(location);
+	if (cell == NULL)
+		return NULL;
+	return cell->front().get();
+}
+
+template<typename T, typename GPType>
+void DenseOccupancy<T, GPType>::getAll(const Point<GPType>& location, std::vector<T*>& out) const {
+	const Cell* cell = doGet(location);
+	if (cell != NULL) {
+		for (typename Cell::const_iterator iter = cell->begin(); iter != cell->end(); ++iter) {
+			out.push_back(iter->get());
+		}
+	}
+}
+
+template<typename T, typename GPType>
+bool DenseOccupancy<T, GPType>::put(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
+	Cell& cell = slot(location);
+	if (std::find(cell.begin(), cell.end(), agent) == cell.end())
+		cell.push_back(agent);
+	return true;
+}
+
+template<typename T, typename GPType>
+void DenseOccupancy<T, GPType>::remove(boost::shared_ptr<T>& agent, const Point<GPType>& location) {
+	size_t index;
+	Cell* cell;
+	OverflowMapIter iter;
+	bool inArray = indexOf(location, index);
+	if (inArray) {
+		if (cells.empty())
+			return;
+		cell = &cells[index];
+	} else {
+		iter = overflow.find(location);
+		if (iter == overflow.end())
+			return;
+		cell = &iter->second;
+	}
+
+	typename Cell::iterator agentIter = std::find(cell->begin(), cell->end(), agent);
+	if (agentIter != cell->end()) {
+		*agentIter = cell->back();
+		cell->pop_back();
+		// cells in the array keep their storage for the next occupants
+		if (cell->empty() && !inArray)
+			overflow.erase(iter);
+	}
+}
+
+}
+
+#endif /* DENSEOCCUPANCY_H_ */
@@ -88,6 +88,7 @@ protected:
 
   virtual bool addAgent(boost::shared_ptr<V> agent);
   virtual void removeAgent(V* agent);
+  virtual void addAgents(const std::vector<boost::shared_ptr<V> >& agents);
 
   virtual void doAddEdge(boost::shared_ptr<E> edge, bool allowOverwrite = true);
 
@@ -274,11 +275,11 @@ public:
 
   virtual void updateProjectionInfo(ProjectionInfoPacket* pip, Context<V>* context);
 
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired, RADIUS radius =Projection<V>::PRIMARY);
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired, RADIUS radius =Projection<V>::PRIMARY);
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush);
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush);
 
-  virtual void cleanProjectionInfo(std::set<AgentId>& agentsToKeep);
+  virtual void cleanProjectionInfo(AgentIdSet& agentsToKeep);
 
   void clearConflictedEdges();
 
@@ -461,6 +462,12 @@ bool Graph<V, E, Ec, EcM>::addAgent(boost::shared_ptr<V> agent) {
   return true;
 }
 
+template<typename V, typename E, typename Ec, typename EcM>
+void Graph<V, E, Ec, EcM>::addAgents(const std::vector<boost::shared_ptr<V> >& agents) {
+  vertices.reserve(vertices.size() + agents.size());
+  for (size_t i = 0; i < agents.size(); i++) this->addAgent(agents[i]);
+}
+
 template<typename V, typename E, typename Ec, typename EcM>
 boost::shared_ptr<E> Graph<V, E, Ec, EcM>::findEdge(V* source, V* target) {
   boost::shared_ptr<E> ret;
@@ -620,11 +627,12 @@ void Graph<V, E, Ec, EcM>::updateProjectionInfo(ProjectionInfoPacket* pip, Conte
 
 
 template<typename V, typename E, typename Ec, typename EcM>
-void Graph<V, E, Ec, EcM>::getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired, RADIUS radius){
+void Graph<V, E, Ec, EcM>::getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired, RADIUS radius){
+  // Agents found are removed from the set to test in bulk, once all have been tested
+  AgentIdSet found;
   switch(radius){
     case Projection<V>::PRIMARY: {// Keep only the nonlocal ends of MASTER edges
-    std::set<AgentId>::iterator iter = agentsToTest.begin();
-      while(iter != agentsToTest.end()){
+      for(AgentIdSet::const_iterator iter = agentsToTest.begin(), iterEnd = agentsToTest.end(); iter != iterEnd; ++iter){
         VertexMapIterator vertex = Graph<V, E, Ec, EcM>::vertices.find(*iter);
         if(vertex != vertices.end()){
           std::vector<boost::shared_ptr<E> > edges;
@@ -634,53 +642,38 @@ void Graph<V, E, Ec, EcM>::getRequiredAgents(std::set<AgentId>& agentsToTest, st
           edgeSet.insert(edges.begin(), edges.end());
           edges.clear();
           edges.assign(edgeSet.begin(), edgeSet.end());
-          bool keep = false;
           for(typename std::vector<boost::shared_ptr<E> >::iterator edgeIter = edges.begin(), edgeIterEnd = edges.end(); edgeIter != edgeIterEnd; edgeIter++){
             if(isMaster(&**edgeIter)){
-              agentsRequired.insert(*iter);
-              keep = true;
+              found.insert(*iter);
               break;
             }
           }
-          if(keep){
-            std::set<AgentId>::iterator iterTEMP = iter;
-            iter++;
-            agentsToTest.erase(*iterTEMP);
-          }
-          else iter++;
         }
-        else iter++;
       }
+      agentsRequired.insert(found);
       break;
     }
     case Projection<V>::SECONDARY: {// Keep any nonlocal agent that is in any edge
-      std::set<AgentId>::iterator iter = agentsToTest.begin();
-      while(iter != agentsToTest.end()){
+      for(AgentIdSet::const_iterator iter = agentsToTest.begin(), iterEnd = agentsToTest.end(); iter != iterEnd; ++iter){
         VertexMapIterator vertex = Graph<V, E, Ec, EcM>::vertices.find(*iter);
         if(vertex != vertices.end()){
           std::vector<boost::shared_ptr<E> > edges;
           vertex->second->edges(Vertex<V, E>::INCOMING, edges);
           vertex->second->edges(Vertex<V, E>::OUTGOING, edges);
-          if(edges.size() > 0){
-            std::set<AgentId>::iterator iterTEMP = iter;
-            iter++;
-            agentsToTest.erase(*iterTEMP);
-          }
-          else iter++;
+          if(edges.size() > 0) found.insert(*iter);
         }
-        else iter++;
       }
       break;
     }
   }
+  agentsToTest.erase(found);
 }
 
 template<typename V, typename E, typename Ec, typename EcM>
-void Graph<V, E, Ec, EcM>::getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush){
-  if(agentsToTest.size() == 0) return;
+void Graph<V, E, Ec, EcM>::getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush){
+  if(agentsToTest.empty()) return;
   // The local agent ends of master edges must be pushed to the process of the non-local end
-  std::set<AgentId>::iterator iter = agentsToTest.begin();
-  while(iter != agentsToTest.end()){
+  for(AgentIdSet::const_iterator iter = agentsToTest.begin(), iterEnd = agentsToTest.end(); iter != iterEnd; ++iter){
     VertexMapIterator vertexMapEntry = Graph<V, E, Ec, EcM>::vertices.find(*iter);
     if(vertexMapEntry != vertices.end()){
       int localRank = vertexMapEntry->second->item()->getId().currentRank();
@@ -701,13 +694,12 @@ void Graph<V, E, Ec, EcM>::getAgentsToPush(std::set<AgentId>& agentsToTest, std:
         }
       }
     }
-    iter++;
   }
 }
 
 template<typename V, typename E, typename Ec, typename EcM>
-void Graph<V, E, Ec, EcM>::cleanProjectionInfo(std::set<AgentId>& agentsToKeep){
-  for(std::set<AgentId>::iterator iter = agentsToKeep.begin(), iterEnd = agentsToKeep.end(); iter != iterEnd; ++iter){
+void Graph<V, E, Ec, EcM>::cleanProjectionInfo(AgentIdSet& agentsToKeep){
+  for(AgentIdSet::const_iterator iter = agentsToKeep.begin(), iterEnd = agentsToKeep.end(); iter != iterEnd; ++iter){
     VertexMapIterator vertexMapEntry = Graph<V, E, Ec, EcM>::vertices.find(*iter);
     if(vertexMapEntry != vertices.end()){
       std::vector<boost::shared_ptr<E> > edges;
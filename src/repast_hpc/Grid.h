@@ -95,6 +95,34 @@ public:
 	 */
 	virtual bool moveTo(const AgentId& id, const Point<GPType>& pt) = 0;
 
+	/**
+	 * Moves the specified agent to the specified two dimensional point.
+	 * By default this converts the point and calls moveTo(id, Point<GPType>);
+	 * implementations can override it to move the agent without allocating.
+	 *
+	 * @param id the id of the agent to move
+	 * @param pt where to move the agent to
+	 *
+	 * @return true if the move was successful, otherwise false
+	 */
+	virtual bool moveTo(const AgentId& id, const Point<GPType, 2>& pt) {
+		return moveTo(id, pt.toPoint());
+	}
+
+	/**
+	 * Moves the specified agent to the specified three dimensional point.
+	 * By default this converts the point and calls moveTo(id, Point<GPType>);
+	 * implementations can override it to move the agent without allocating.
+	 *
+	 * @param id the id of the agent to move
+	 * @param pt where to move the agent to
+	 *
+	 * @return true if the move was successful, otherwise false
+	 */
+	virtual bool moveTo(const AgentId& id, const Point<GPType, 3>& pt) {
+		return moveTo(id, pt.toPoint());
+	}
+
 	/**
 	 * Moves the specifed object the specified distance from its current
 	 * position along the specified angle. For example, <code>moveByVector(object, 1, Grid.NORTH)</code>
@@ -236,6 +264,58 @@ public:
 	virtual void
 	transform(const std::vector<GPType>& location, std::vector<GPType>& out) const = 0;
 
+	/**
+	 * Translates the specified two dimensional location by the specified
+	 * displacement and puts the result in out. By default this converts the
+	 * points and calls the std::vector translate; implementations can
+	 * override it to translate without allocating.
+	 */
+	virtual void
+	translate(const Point<GPType, 2>& location, const Point<GPType, 2>& displacement, Point<GPType, 2>& out) const {
+		std::vector<GPType> result(2, 0);
+		translate(location.toPoint(), displacement.toPoint(), result);
+		for (int i = 0; i < 2; i++) out[i] = result[i];
+	}
+
+	/**
+	 * Translates the specified three dimensional location by the specified
+	 * displacement and puts the result in out. By default this converts the
+	 * points and calls the std::vector translate; implementations can
+	 * override it to translate without allocating.
+	 */
+	virtual void
+	translate(const Point<GPType, 3>& location, const Point<GPType, 3>& displacement, Point<GPType, 3>& out) const {
+		std::vector<GPType> result(3, 0);
+		translate(location.toPoint(), displacement.toPoint(), result);
+		for (int i = 0; i < 3; i++) out[i] = result[i];
+	}
+
+	/**
+	 * Transforms the specified two dimensional location using the properties
+	 * (e.g. toroidal) of this space. By default this converts the points and
+	 * calls the std::vector transform; implementations can override it to
+	 * transform without allocating.
+	 */
+	virtual void
+	transform(const Point<GPType, 2>& location, Point<GPType, 2>& out) const {
+		std::vector<GPType> result(2, 0);
+		transform(location.toPoint().coords(), result);
+		for (int i = 0; i < 2; i++) out[i] = result[i];
+	}
+
+	/**
+	 * Transforms the specified three dimensional location using the properties
+	 * (e.g. toroidal) of this space. By default this converts the points and
+	 * calls the std::vector transform; implementations can override it to
+	 * transform without allocating.
+	 */
+	virtual void
+	transform(const Point<GPType, 3>& location, Point<GPType, 3>& out) const {
+		std::vector<GPType> result(3, 0);
+		transform(location.toPoint().coords(), result);
+		for (int i = 0; i < 3; i++) out[i] = result[i];
+	}
+
 	/**
 	 * Gets whether or not this grid is periodic (i.e. toroidal).
 	 *
@@ -247,9 +327,9 @@ public:
 
   virtual void updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context) = 0;
 
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired, RADIUS radius = Projection<T>::PRIMARY){} // Grids allow all agents to be dropped b/c agent info not dependent on other agents
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired, RADIUS radius = Projection<T>::PRIMARY){} // Grids allow all agents to be dropped b/c agent info not dependent on other agents
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush) = 0;
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush) = 0;
 
   virtual bool keepsAgentsOnSyncProj(){ return false; }
 
@@ -259,7 +339,7 @@ public:
 
   virtual void getAgentStatusExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom) = 0;
 
-  virtual void cleanProjectionInfo(std::set<AgentId>& agentsToKeep){}; // Grids don't do this
+  virtual void cleanProjectionInfo(AgentIdSet& agentsToKeep){}; // Grids don't do this
 
 };
 
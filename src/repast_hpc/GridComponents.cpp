@@ -137,36 +137,33 @@ WrapAroundBorders::WrapAroundBorders(GridDimensions dimensions): _dimensions(dim
   }
 }
 
+int WrapAroundBorders::wrap(int coord, size_t dimension) const {
+  if(coord >= mins[dimension] && coord < maxs[dimension]) return coord;
+  return fmod((double)(coord-_dimensions.origin(dimension)), (double)_dimensions.extents(dimension))  +
+         (coord < _dimensions.origin(dimension) ? _dimensions.extents(dimension) : 0) +
+         _dimensions.origin(dimension);
+}
+
+double WrapAroundBorders::wrap(double coord, size_t dimension) const {
+  if(coord >= mins[dimension] && coord < maxs[dimension]) return coord;
+  double out = fmod((coord-_dimensions.origin(dimension)), _dimensions.extents(dimension))  +
+               (coord < _dimensions.origin(dimension) ? _dimensions.extents(dimension) : 0) +
+               _dimensions.origin(dimension);
+  if(out >= maxs[dimension])       out = nextafter(maxs[dimension], -DBL_MAX);
+  else if(out < mins[dimension])   out = nextafter(mins[dimension],  DBL_MAX);
+  return out;
+}
+
 void WrapAroundBorders::transform(const std::vector<int>& in, std::vector<int>& out) const {
 	if (out.size() < in.size())	out.insert(out.begin(), in.size(), 0);
 
-  for (size_t i = 0, n = in.size(); i < n; ++i){
-    int coord = in[i];
-    if(coord >= mins[i] && coord < maxs[i])
-      out[i] = coord;
-    else
-      out[i] = fmod((double)(coord-_dimensions.origin(i)), (double)_dimensions.extents(i))  +
-               (coord < _dimensions.origin(i) ? _dimensions.extents(i) : 0) +
-               _dimensions.origin(i);
-  }
+  for (size_t i = 0, n = in.size(); i < n; ++i) out[i] = wrap(in[i], i);
 }
 
 void WrapAroundBorders::transform(const std::vector<double>& in, std::vector<double>& out) const {
 	if (out.size() < in.size()) out.insert(out.begin(), in.size(), 0);
 
-  for (size_t i = 0, n = in.size(); i < n; ++i){
-    double coord = in[i];
-    if(coord >= mins[i] && coord < maxs[i])
-      out[i] = coord;
-    else{
-      out[i] = fmod((coord-_dimensions.origin(i)), _dimensions.extents(i))  +
-               (coord < _dimensions.origin(i) ? _dimensions.extents(i) : 0) +
-               _dimensions.origin(i);
-      if(out[i] >= maxs[i])       out[i] = nextafter(maxs[i], -DBL_MAX);
-      else if(out[i] < mins[i])   out[i] = nextafter(mins[i],  DBL_MAX);
-    }
-  }
-
+  for (size_t i = 0, n = in.size(); i < n; ++i) out[i] = wrap(in[i], i);
 }
 
 void WrapAroundBorders::translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<
@@ -68,11 +68,20 @@ public:
 	void transform(const std::vector<int>& in, std::vector<int>& out) const;
 	void transform(const std::vector<double>& in, std::vector<double>& out) const;
 
+	template<typename GPType, int N>
+	void transform(const Point<GPType, N>& in, Point<GPType, N>& out) const;
+
 	bool isPeriodic() const {
 		return false;
 	}
 };
 
+template<typename GPType, int N>
+void Borders::transform(const Point<GPType, N>& in, Point<GPType, N>& out) const {
+	if (!_dimensions.contains(in)) boundsCheck(std::vector<GPType>(in.begin(), in.end())); // throws
+	out = in;
+}
+
 /**
  * Implements strict grid border semantics: anything
  * outside the dimensions is out of bounds.
@@ -85,8 +94,18 @@ public:
 	void translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<double>& displacement) const;
 	void translate(const std::vector<int>& oldPos, std::vector<int>& newPos, const std::vector<int>& displacement) const;
 
+	template<typename GPType, int N>
+	void translate(const Point<GPType, N>& oldPos, Point<GPType, N>& newPos, const Point<GPType, N>& displacement) const;
+
 };
 
+template<typename GPType, int N>
+void StrictBorders::translate(const Point<GPType, N>& oldPos, Point<GPType, N>& newPos, const Point<GPType, N>& displacement) const {
+	for (int i = 0; i < N; ++i) newPos[i] = oldPos[i] + displacement[i];
+
+	if (!_dimensions.contains(newPos)) boundsCheck(std::vector<GPType>(newPos.begin(), newPos.end())); // throws
+}
+
 /**
  * Implements sticky border semantics: translates out
  * side of the border are clamped to the border coordinates.
@@ -105,8 +124,16 @@ public:
 	StickyBorders(GridDimensions d);
 	void translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<double>& displacement) const;
 	void translate(const std::vector<int>& oldPos, std::vector<int>& newPos, const std::vector<int>& displacement) const;
+
+	template<typename GPType, int N>
+	void translate(const Point<GPType, N>& oldPos, Point<GPType, N>& newPos, const Point<GPType, N>& displacement) const;
 };
 
+template<typename GPType, int N>
+void StickyBorders::translate(const Point<GPType, N>& oldPos, Point<GPType, N>& newPos, const Point<GPType, N>& displacement) const {
+	for (int i = 0; i < N; ++i) newPos[i] = calcCoord<GPType>(oldPos[i] + displacement[i], i);
+}
+
 template<typename T>
 T StickyBorders::calcCoord(T coord, int dimension) const {
 	if (coord < mins[dimension]) return mins[dimension];
@@ -126,6 +153,9 @@ private:
 	GridDimensions _dimensions;
 	std::vector<int> mins, maxs;
 
+	int wrap(int coord, size_t dimension) const;
+	double wrap(double coord, size_t dimension) const;
+
 public:
 
 	WrapAroundBorders(GridDimensions dimensions);
@@ -135,6 +165,16 @@ public:
 	void translate(const std::vector<double>& oldPos, std::vector<double>& newPos, const std::vector<double>& displacement) const;
 	void translate(const std::vector<int>& oldPos, std::vector<int>& newPos, const std::vector<int>& displacement) const;
 
+	template<typename GPType, int N>
+	void transform(const Point<GPType, N>& in, Point<GPType, N>& out) const {
+		for (int i = 0; i < N; ++i) out[i] = wrap(in[i], i);
+	}
+
+	template<typename GPType, int N>
+	void translate(const Point<GPType, N>& oldPos, Point<GPType, N>& newPos, const Point<GPType, N>& displacement) const {
+		for (int i = 0; i < N; ++i) newPos[i] = wrap(oldPos[i] + displacement[i], i);
+	}
+
 	void init(const GridDimensions& dimensions);
 
 	bool isPeriodic() const {
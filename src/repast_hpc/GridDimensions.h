@@ -77,6 +77,13 @@ public:
 	bool contains(const Point<double>& pt) const;
 	bool contains(const std::vector<double>& pt) const;
 
+	/**
+	 * Checks whether a point of compile time dimension is within these
+	 * dimensions, without copying its coordinates.
+	 */
+	template<typename T, int N>
+	bool contains(const Point<T, N>& pt) const;
+
 	/**
 	 * Gets the origin.
 	 */
@@ -105,6 +112,19 @@ public:
 
 };
 
+template<typename T, int N>
+bool GridDimensions::contains(const Point<T, N>& pt) const {
+	if (N != _origin.dimensionCount()) return contains(std::vector<T>(pt.begin(), pt.end())); // throws for the mismatch
+
+	for (int i = 0; i < N; i++) {
+		double start = _origin[i];
+		double end = start + _extents[i];
+		if (pt[i] < start || pt[i] >= end)
+			return false;
+	}
+	return true;
+}
+
 bool operator==(const GridDimensions &one, const GridDimensions &two);
 bool operator!=(const GridDimensions &one, const GridDimensions &two);
 std::ostream& operator<<(std::ostream& os, const GridDimensions& dimensions);
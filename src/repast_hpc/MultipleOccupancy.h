@@ -45,6 +45,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Point.h"
+#include "GridDimensions.h"
 
 namespace repast {
 
@@ -87,6 +88,15 @@ public:
 
 	virtual ~MultipleOccupancy();
 
+	/**
+	 * Sets the region of the grid that this accessor holds. The locations
+	 * of this accessor are kept in a map, so this does nothing.
+	 *
+	 * @param bounds the region
+	 */
+	void init(const GridDimensions& bounds) {
+	}
+
 	/**
 	 * Gets the first object found at the specified location.
 	 *
@@ -0,0 +1,180 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  NDGridQuery.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef NDGRIDQUERY_H_
+#define NDGRIDQUERY_H_
+
+#include <vector>
+#include <limits>
+
+#include "Grid.h"
+#include "Point.h"
+#include "GridDimensions.h"
+#include "NeighborhoodStencil.h"
+#include "RepastErrors.h"
+
+namespace repast {
+
+/**
+ * Neighborhood query that gathers the agents in the cells of a
+ * NeighborhoodStencil around a center, on a discrete Grid of any
+ * number of dimensions. Each query wraps (on a periodic grid) or clips
+ * (on a strict grid) the coordinates once per dimension, then visits the
+ * stencil's cells through a single reused point, so a query does not
+ * allocate per cell. Cells outside a strict grid are skipped. On a
+ * periodic dimension narrower than the stencil, a cell reachable by more
+ * than one offset is visited once, through its smallest offset.
+ *
+ * A query object keeps scratch space between queries, so each
+ * thread should use its own.
+ *
+ * @tparam T the type of agents in the Grid
+ */
+template<typename T>
+class NDGridQuery {
+
+private:
+	static const int OUTSIDE = std::numeric_limits<int>::min();
+
+	const Grid<T, int>* _grid;
+	int _dims;
+	bool _periodic;
+	std::vector<int> _min, _max; // max is EXCLUSIVE
+
+	mutable std::vector<int> _axisCoords; // per dimension, the coordinate for each offset in [-range, range]
+	mutable std::vector<int> _coords;
+	mutable Point<int> _cursor;
+
+public:
+
+	/**
+	 * Creates an NDGridQuery that will query the specified Grid.
+	 */
+	NDGridQuery(const Grid<T, int>* grid);
+	virtual ~NDGridQuery() {}
+
+	/**
+	 * Queries the Grid for the agents in the cells of the stencil
+	 * around the center point.
+	 *
+	 * @param center the center of the neighborhood
+	 * @param stencil the offsets that make up the neighborhood
+	 * @param [out] the neighboring agents will be returned in this vector
+	 *
+	 * @throws Repast_Error_64 if the center or the stencil does not have the grid's number of dimensions
+	 */
+	void query(const Point<int>& center, const NeighborhoodStencil& stencil, std::vector<T*>& out) const;
+};
+
+template<typename T>
+const int NDGridQuery<T>::OUTSIDE;
+
+template<typename T>
+NDGridQuery<T>::NDGridQuery(const Grid<T, int>* grid) :
+	_grid(grid), _dims(grid->bounds().dimensionCount()), _periodic(grid->isPeriodic()),
+	_coords(_dims, 0), _cursor(std::vector<int>(_dims, 0)) {
+	GridDimensions bounds = grid->bounds();
+	for (int i = 0; i < _dims; i++) {
+		_min.push_back((int) bounds.origin(i));
+		_max.push_back((int) (bounds.origin(i) + bounds.extents(i)));
+	}
+}
+
+template<typename T>
+void NDGridQuery<T>::query(const Point<int>& center, const NeighborhoodStencil& stencil, std::vector<T*>& out) const {
+	if (stencil.dimensionCount() != _dims) throw Repast_Error_64(_dims, stencil.dimensionCount()); // Stencil does not match the grid
+	if (center.dimensionCount() != (size_t) _dims) throw Repast_Error_64(_dims, center.dimensionCount()); // Center does not match the grid
+
+	int range = stencil.range();
+	int span = 2 * range + 1;
+	_axisCoords.resize(_dims * span);
+
+	for (int i = 0; i < _dims; i++) {
+		int* axis = &_axisCoords[i * span];
+		int extent = _max[i] - _min[i];
+		for (int offset = -range; offset <= range; offset++) {
+			int coord = center[i] + offset;
+			if (_periodic) {
+				coord = (coord - _min[i]) % extent;
+				if (coord < 0) coord += extent;
+				coord += _min[i];
+			} else if (coord < _min[i] || coord >= _max[i]) {
+				coord = OUTSIDE;
+			}
+			axis[offset + range] = coord;
+		}
+
+		if (_periodic && span > extent) {
+			// Keep each wrapped coordinate only at its smallest offset
+			for (int offset = -range; offset <= range; offset++) {
+				int coord = axis[offset + range];
+				for (int other = -range; other <= range; other++) {
+					int size = other < 0 ? -other : other;
+					int ownSize = offset < 0 ? -offset : offset;
+					if (axis[other + range] == coord && (size < ownSize || (size == ownSize && other < offset))) {
+						axis[offset + range] = OUTSIDE;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	for (size_t n = 0, count = stencil.size(); n < count; n++) {
+		const int* offset = stencil.offset(n);
+		bool inside = true;
+		for (int i = 0; i < _dims; i++) {
+			int coord = _axisCoords[i * span + offset[i] + range];
+			if (coord == OUTSIDE) {
+				inside = false;
+				break;
+			}
+			_coords[i] = coord;
+		}
+		if (inside) {
+			_cursor.set(_coords);
+			_grid->getObjectsAt(_cursor, out);
+		}
+	}
+}
+
+}
+
+#endif /* NDGRIDQUERY_H_ */
@@ -0,0 +1,182 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  NDValueLayerQuery.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef NDVALUELAYERQUERY_H_
+#define NDVALUELAYERQUERY_H_
+
+#include <vector>
+
+#include "Point.h"
+#include "ValueLayerND.h"
+#include "NeighborhoodStencil.h"
+#include "RepastErrors.h"
+
+namespace repast {
+
+/**
+ * Neighborhood query that reads the values in the cells of a
+ * NeighborhoodStencil around a center, on an N dimensional value
+ * layer. Each query resolves the coordinates once per dimension into
+ * offsets in the layer's data space (wrapping on a periodic layer), and
+ * then reads each cell by summing those offsets, so a query neither
+ * allocates nor transforms coordinates per cell.
+ *
+ * Only cells this process holds, locally or in its buffer zone, are
+ * visited; a stencil whose range is no larger than the buffer size
+ * therefore sees the whole neighborhood of any local center. On a
+ * periodic dimension narrower than the stencil, a cell reachable by more
+ * than one offset is visited once, through its smallest offset.
+ *
+ * A query object keeps scratch space between queries, so each
+ * thread should use its own.
+ *
+ * @tparam T the type of the values in the layer
+ */
+template<typename T>
+class NDValueLayerQuery {
+
+private:
+	AbstractValueLayerND<T>* _layer;
+	int _dims;
+
+	mutable std::vector<int> _axisIndexes; // per dimension, the index contribution for each offset in [-range, range]
+
+	struct AppendValue {
+		std::vector<T>& out;
+		AppendValue(std::vector<T>& values) : out(values) {}
+		void operator()(const int* offset, const T& value) {
+			out.push_back(value);
+		}
+	};
+
+public:
+
+	/**
+	 * Creates an NDValueLayerQuery that will query the specified value layer.
+	 */
+	NDValueLayerQuery(AbstractValueLayerND<T>* layer);
+	virtual ~NDValueLayerQuery() {}
+
+	/**
+	 * Calls the functor for each cell of the stencil around the center
+	 * that this process holds, as functor(offset, value), where offset
+	 * points to the stencil offset of the cell.
+	 *
+	 * @param center the center of the neighborhood
+	 * @param stencil the offsets that make up the neighborhood
+	 * @param functor the functor to call for each cell
+	 *
+	 * @throws Repast_Error_64 if the center or the stencil does not have the layer's number of dimensions
+	 */
+	template<typename Functor>
+	void apply(const Point<int>& center, const NeighborhoodStencil& stencil, Functor& functor) const;
+
+	/**
+	 * Gets the values in the cells of the stencil around the center that
+	 * this process holds, in stencil order.
+	 *
+	 * @param center the center of the neighborhood
+	 * @param stencil the offsets that make up the neighborhood
+	 * @param [out] the values will be returned in this vector
+	 *
+	 * @throws Repast_Error_64 if the center or the stencil does not have the layer's number of dimensions
+	 */
+	void query(const Point<int>& center, const NeighborhoodStencil& stencil, std::vector<T>& out) const;
+};
+
+template<typename T>
+NDValueLayerQuery<T>::NDValueLayerQuery(AbstractValueLayerND<T>* layer) :
+	_layer(layer), _dims(layer->getDimensionCount()) {
+}
+
+template<typename T>
+template<typename Functor>
+void NDValueLayerQuery<T>::apply(const Point<int>& center, const NeighborhoodStencil& stencil, Functor& functor) const {
+	if (stencil.dimensionCount() != _dims) throw Repast_Error_64(_dims, stencil.dimensionCount()); // Stencil does not match the layer
+	if (center.dimensionCount() != (size_t) _dims) throw Repast_Error_64(_dims, center.dimensionCount()); // Center does not match the layer
+
+	int range = stencil.range();
+	int span = 2 * range + 1;
+	_axisIndexes.resize(_dims * span);
+
+	for (int i = 0; i < _dims; i++) {
+		int* axis = &_axisIndexes[i * span];
+		for (int offset = -range; offset <= range; offset++) {
+			axis[offset + range] = _layer->getAxisIndex(i, center[i] + offset);
+		}
+
+		// Keep each cell only at its smallest offset; repeats only occur on a wrapped dimension
+		for (int offset = -range; offset <= range; offset++) {
+			int index = axis[offset + range];
+			if (index == -1) continue;
+			for (int other = -range; other <= range; other++) {
+				int size = other < 0 ? -other : other;
+				int ownSize = offset < 0 ? -offset : offset;
+				if (axis[other + range] == index && (size < ownSize || (size == ownSize && other < offset))) {
+					axis[offset + range] = -1;
+					break;
+				}
+			}
+		}
+	}
+
+	const T* data = _layer->getDataSpace();
+	for (size_t n = 0, count = stencil.size(); n < count; n++) {
+		const int* offset = stencil.offset(n);
+		int index = 0;
+		int i = 0;
+		for (; i < _dims; i++) {
+			int axisIndex = _axisIndexes[i * span + offset[i] + range];
+			if (axisIndex == -1) break;
+			index += axisIndex;
+		}
+		if (i == _dims) functor(offset, data[index]);
+	}
+}
+
+template<typename T>
+void NDValueLayerQuery<T>::query(const Point<int>& center, const NeighborhoodStencil& stencil, std::vector<T>& out) const {
+	AppendValue append(out);
+	apply(center, stencil, append);
+}
+
+}
+
+#endif /* NDVALUELAYERQUERY_H_ */
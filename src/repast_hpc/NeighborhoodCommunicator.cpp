@@ -0,0 +1,81 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  NeighborhoodCommunicator.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "NeighborhoodCommunicator.h"
+
+namespace repast {
+
+NeighborhoodCommunicator::NeighborhoodCommunicator(boost::mpi::communicator* comm) : world(comm),
+		graph(MPI_COMM_NULL) {
+}
+
+NeighborhoodCommunicator::~NeighborhoodCommunicator() {
+	free();
+}
+
+void NeighborhoodCommunicator::free() {
+	if (graph != MPI_COMM_NULL)
+		MPI_Comm_free(&graph);
+	graph = MPI_COMM_NULL;
+}
+
+bool NeighborhoodCommunicator::matches(const std::vector<int>& sends, const std::vector<int>& recvs) const {
+	return graph != MPI_COMM_NULL && sends == destinations && recvs == sources;
+}
+
+bool NeighborhoodCommunicator::update(const std::vector<int>& sends, const std::vector<int>& recvs) {
+	int changed = (matches(sends, recvs) ? 0 : 1);
+	int anyChanged = 0;
+	MPI_Allreduce(&changed, &anyChanged, 1, MPI_INT, MPI_LOR, *world);
+	if (anyChanged == 0)
+		return false;
+
+	free();
+	destinations.assign(sends.begin(), sends.end());
+	sources.assign(recvs.begin(), recvs.end());
+	// Reordering is not allowed: ranks in the graph must be ranks in the world communicator
+	int none = 0;
+	MPI_Dist_graph_create_adjacent(*world, (int) sources.size(), sources.empty() ? &none : &sources[0],
+			MPI_UNWEIGHTED, (int) destinations.size(), destinations.empty() ? &none : &destinations[0],
+			MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &graph);
+	return true;
+}
+
+}
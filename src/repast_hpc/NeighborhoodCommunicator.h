@@ -0,0 +1,187 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  NeighborhoodCommunicator.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef NEIGHBORHOODCOMMUNICATOR_H_
+#define NEIGHBORHOODCOMMUNICATOR_H_
+
+#include <vector>
+#include <map>
+#include <cstring>
+
+#include <mpi.h>
+#include <boost/noncopyable.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/packed_oarchive.hpp>
+#include <boost/mpi/packed_iarchive.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include "RepastErrors.h"
+#include "SyncProfiler.h"
+
+namespace repast {
+
+/**
+ * Wraps an MPI distributed graph communicator whose edges are a fixed
+ * set of processes this process sends to and receives from, and uses
+ * neighborhood collectives to exchange serializable objects along those
+ * edges. Building the graph communicator is a collective operation, so
+ * it is done only when the set of partners actually changes on some
+ * process; an unchanged set of partners reuses the existing communicator.
+ */
+class NeighborhoodCommunicator: public boost::noncopyable {
+
+private:
+	boost::mpi::communicator* world;
+	MPI_Comm graph;
+	std::vector<int> destinations;
+	std::vector<int> sources;
+
+	// Kept between exchanges so that their capacity is reused
+	std::vector<char> sendBuffer;
+	std::vector<char> recvBuffer;
+
+	void free();
+
+public:
+	/**
+	 * Creates a NeighborhoodCommunicator for processes in the specified
+	 * communicator. The graph is empty until update is called.
+	 */
+	NeighborhoodCommunicator(boost::mpi::communicator* comm);
+
+	~NeighborhoodCommunicator();
+
+	/**
+	 * Gets whether the graph has been built with exactly the specified partners.
+	 */
+	bool matches(const std::vector<int>& sends, const std::vector<int>& recvs) const;
+
+	/**
+	 * Makes the graph match the specified partners, rebuilding it if they differ
+	 * from the current partners on any process. This must be called by all
+	 * processes in the communicator.
+	 *
+	 * @param sends the processes this process will send to
+	 * @param recvs the processes this process will receive from
+	 *
+	 * @return true if the graph was rebuilt, otherwise false
+	 */
+	bool update(const std::vector<int>& sends, const std::vector<int>& recvs);
+
+	/**
+	 * Sends an object to every destination in the graph and receives one from
+	 * every source. This must be called by all processes in the communicator.
+	 *
+	 * @param outgoing objects to send keyed by destination process; there must be
+	 * an object for every destination and for no other process
+	 * @param incoming map in which the received objects are placed, keyed by source
+	 * process. An object that is already in the map for a source is received into;
+	 * otherwise the object is created with new. The caller is responsible for
+	 * deleting the objects.
+	 *
+	 * @tparam T a default constructible, serializable type
+	 */
+	template<typename T>
+	void exchange(const std::map<int, T*>& outgoing, std::map<int, T*>& incoming);
+
+};
+
+template<typename T>
+void NeighborhoodCommunicator::exchange(const std::map<int, T*>& outgoing, std::map<int, T*>& incoming) {
+	if (outgoing.size() != destinations.size())
+		throw Repast_Error_60(destinations.size(), outgoing.size()); // Objects to send do not match the graph's destinations
+
+	// Serialize; archives are in the same order as the destinations
+	boost::ptr_vector<boost::mpi::packed_oarchive> archives;
+	std::vector<int> sendCounts(destinations.size());
+	for (size_t i = 0; i < destinations.size(); i++) {
+		typename std::map<int, T*>::const_iterator iter = outgoing.find(destinations[i]);
+		if (iter == outgoing.end())
+			throw Repast_Error_60(destinations.size(), outgoing.size()); // Objects to send do not match the graph's destinations
+		boost::mpi::packed_oarchive* archive = new boost::mpi::packed_oarchive(*world);
+		archives.push_back(archive);
+		*archive << *(iter->second);
+		sendCounts[i] = (int) archive->size();
+	}
+
+	std::vector<int> recvCounts(sources.size());
+	MPI_Neighbor_alltoall(sendCounts.empty() ? 0 : &sendCounts[0], 1, MPI_INT,
+			recvCounts.empty() ? 0 : &recvCounts[0], 1, MPI_INT, graph);
+
+	// Pack into one contiguous buffer per direction
+	std::vector<int> sendDispls(destinations.size());
+	int sendTotal = 0;
+	for (size_t i = 0; i < destinations.size(); i++) {
+		sendDispls[i] = sendTotal;
+		sendTotal += sendCounts[i];
+	}
+	std::vector<int> recvDispls(sources.size());
+	int recvTotal = 0;
+	for (size_t i = 0; i < sources.size(); i++) {
+		recvDispls[i] = recvTotal;
+		recvTotal += recvCounts[i];
+	}
+	REPAST_SYNC_SENT(destinations.size(), sendTotal);
+	sendBuffer.resize(sendTotal + 1);
+	recvBuffer.resize(recvTotal + 1);
+	for (size_t i = 0; i < destinations.size(); i++)
+		std::memcpy(&sendBuffer[sendDispls[i]], archives[i].address(), sendCounts[i]);
+	archives.clear();
+
+	MPI_Neighbor_alltoallv(&sendBuffer[0], sendCounts.empty() ? 0 : &sendCounts[0],
+			sendDispls.empty() ? 0 : &sendDispls[0], MPI_PACKED, &recvBuffer[0],
+			recvCounts.empty() ? 0 : &recvCounts[0], recvDispls.empty() ? 0 : &recvDispls[0],
+			MPI_PACKED, graph);
+
+	// Deserialize
+	for (size_t i = 0; i < sources.size(); i++) {
+		boost::mpi::packed_iarchive archive(*world);
+		archive.resize(recvCounts[i]);
+		std::memcpy(archive.address(), &recvBuffer[recvDispls[i]], recvCounts[i]);
+		T*& object = incoming[sources[i]];
+		if (object == 0)
+			object = new T();
+		archive >> *object;
+	}
+}
+
+}
+
+#endif /* NEIGHBORHOODCOMMUNICATOR_H_ */
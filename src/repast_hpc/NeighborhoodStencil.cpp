@@ -0,0 +1,103 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  NeighborhoodStencil.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <cstdlib>
+
+#include "NeighborhoodStencil.h"
+#include "RepastErrors.h"
+
+namespace repast {
+
+NeighborhoodStencil::NeighborhoodStencil(int dimensions) :
+	_dims(dimensions), _range(0) {
+	if (dimensions < 1) throw Repast_Error_64(1, dimensions); // A stencil needs at least one dimension
+}
+
+void NeighborhoodStencil::add(const std::vector<int>& offset) {
+	if (offset.size() != (size_t) _dims) throw Repast_Error_64(_dims, offset.size()); // Offset has the wrong number of dimensions
+
+	for (int i = 0; i < _dims; i++) {
+		int value = std::abs(offset[i]);
+		if (value > _range) _range = value;
+		_offsets.push_back(offset[i]);
+	}
+}
+
+namespace {
+
+// Adds every offset in [-range, range]^dimensions, first dimension fastest,
+// whose summed absolute value is at most maxSum.
+void addBox(NeighborhoodStencil& stencil, int dimensions, int range, int maxSum, bool includeCenter) {
+	if (range < 0) return;
+	std::vector<int> offset(dimensions, -range);
+	while (true) {
+		int sum = 0;
+		bool center = true;
+		for (int i = 0; i < dimensions; i++) {
+			sum += std::abs(offset[i]);
+			if (offset[i] != 0) center = false;
+		}
+		if (sum <= maxSum && (includeCenter || !center)) stencil.add(offset);
+
+		int i = 0;
+		while (i < dimensions && offset[i] == range) {
+			offset[i] = -range;
+			i++;
+		}
+		if (i == dimensions) break;
+		offset[i]++;
+	}
+}
+
+}
+
+NeighborhoodStencil NeighborhoodStencil::moore(int dimensions, int range, bool includeCenter) {
+	NeighborhoodStencil stencil(dimensions);
+	addBox(stencil, dimensions, range, dimensions * range, includeCenter);
+	return stencil;
+}
+
+NeighborhoodStencil NeighborhoodStencil::vonNeumann(int dimensions, int range, bool includeCenter) {
+	NeighborhoodStencil stencil(dimensions);
+	addBox(stencil, dimensions, range, range, includeCenter);
+	return stencil;
+}
+
+}
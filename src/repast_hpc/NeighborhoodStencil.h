@@ -0,0 +1,138 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  NeighborhoodStencil.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef NEIGHBORHOODSTENCIL_H_
+#define NEIGHBORHOODSTENCIL_H_
+
+#include <vector>
+#include <cstddef>
+
+namespace repast {
+
+/**
+ * The set of cell offsets, relative to a center cell, that make up an
+ * N dimensional neighborhood. Stencils are built once and then
+ * applied to any number of centers by NDGridQuery or NDValueLayerQuery.
+ * The offsets are stored contiguously, so applying a stencil does not
+ * allocate.
+ *
+ * Moore and von Neumann stencils enumerate their offsets with the
+ * first dimension varying fastest, which matches the memory layout
+ * of ValueLayerND.
+ */
+class NeighborhoodStencil {
+
+private:
+	int _dims;
+	int _range;
+	std::vector<int> _offsets;
+
+public:
+
+	/**
+	 * Creates an empty stencil for the specified number of dimensions.
+	 * Offsets are added with add().
+	 *
+	 * @param dimensions the number of dimensions of the offsets
+	 */
+	explicit NeighborhoodStencil(int dimensions);
+
+	/**
+	 * Creates a Moore stencil: every cell whose offset along each dimension
+	 * is within range of the center.
+	 *
+	 * @param dimensions the number of dimensions
+	 * @param range the range of the neighborhood out from the center
+	 * @param includeCenter whether or not the center cell is part of the stencil
+	 */
+	static NeighborhoodStencil moore(int dimensions, int range, bool includeCenter);
+
+	/**
+	 * Creates a von Neumann stencil: every cell whose offsets sum, in absolute
+	 * value, to no more than range.
+	 *
+	 * @param dimensions the number of dimensions
+	 * @param range the range of the neighborhood out from the center
+	 * @param includeCenter whether or not the center cell is part of the stencil
+	 */
+	static NeighborhoodStencil vonNeumann(int dimensions, int range, bool includeCenter);
+
+	/**
+	 * Adds an offset to this stencil.
+	 *
+	 * @param offset the offset from the center, one value per dimension
+	 *
+	 * @throws Repast_Error_64 if the offset does not have the stencil's number of dimensions
+	 */
+	void add(const std::vector<int>& offset);
+
+	/**
+	 * Gets the number of dimensions of this stencil.
+	 */
+	int dimensionCount() const {
+		return _dims;
+	}
+
+	/**
+	 * Gets the largest absolute value of any offset along any dimension.
+	 */
+	int range() const {
+		return _range;
+	}
+
+	/**
+	 * Gets the number of offsets in this stencil.
+	 */
+	size_t size() const {
+		return _offsets.size() / _dims;
+	}
+
+	/**
+	 * Gets the offset at the specified index, as dimensionCount() values.
+	 */
+	const int* offset(size_t index) const {
+		return &_offsets[index * _dims];
+	}
+
+};
+
+}
+
+#endif /* NEIGHBORHOODSTENCIL_H_ */
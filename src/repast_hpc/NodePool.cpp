@@ -0,0 +1,107 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * NodePool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "NodePool.h"
+#include "Schedule.h" // for REPAST_SCHEDULE_THREADS
+
+#ifdef REPAST_SCHEDULE_THREADS
+#include <boost/thread/mutex.hpp>
+#endif
+
+namespace repast {
+
+namespace {
+
+// pools hold nodes in multiples of POOL_GRANULE bytes, up to
+// POOL_GRANULE * POOL_COUNT; anything larger uses operator new.
+const size_t POOL_GRANULE = 16;
+const size_t POOL_COUNT = 8;
+
+NodePool* pool(size_t size) {
+	// the pools are never deleted so that nodes may be released at any
+	// point during static destruction
+	static NodePool* pools[POOL_COUNT] = { 0 };
+	if (size == 0) size = 1;
+	size_t index = (size - 1) / POOL_GRANULE;
+	if (index >= POOL_COUNT) return 0;
+	if (pools[index] == 0) pools[index] = new NodePool((index + 1) * POOL_GRANULE);
+	return pools[index];
+}
+
+#ifdef REPAST_SCHEDULE_THREADS
+// the events of a parallel group may use the pools concurrently, e.g. by
+// adding agents to and removing them from their own SLABS contexts
+boost::mutex& poolMutex() {
+	// never deleted, like the pools
+	static boost::mutex* mutex = new boost::mutex();
+	return *mutex;
+}
+#endif
+
+}
+
+void NodePool::grow() {
+	char* chunk = static_cast<char*>(::operator new(nodeSize * NODES_PER_CHUNK));
+	for (size_t i = 0; i < NODES_PER_CHUNK; i++) {
+		release(chunk + i * nodeSize);
+	}
+}
+
+void* poolAllocate(size_t size) {
+#ifdef REPAST_SCHEDULE_THREADS
+	boost::mutex::scoped_lock lock(poolMutex());
+#endif
+	NodePool* nodes = pool(size);
+	return nodes == 0 ? ::operator new(size) : nodes->allocate();
+}
+
+void poolRelease(void* ptr, size_t size) {
+	if (ptr == 0) return;
+#ifdef REPAST_SCHEDULE_THREADS
+	boost::mutex::scoped_lock lock(poolMutex());
+#endif
+	NodePool* nodes = pool(size);
+	if (nodes == 0)
+		::operator delete(ptr);
+	else
+		nodes->release(ptr);
+}
+
+}
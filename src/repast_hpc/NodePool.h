@@ -0,0 +1,169 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * NodePool.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef NODEPOOL_H_
+#define NODEPOOL_H_
+
+#include <cstddef>
+#include <new>
+
+namespace repast {
+
+/**
+ * Free list allocator of equally sized nodes. Nodes are carved out
+ * of larger chunks, and released nodes are kept for reuse rather than
+ * returned to the system. Not thread safe.
+ */
+class NodePool {
+private:
+	static const size_t NODES_PER_CHUNK = 256;
+
+	size_t nodeSize;
+	void* freeList;
+
+	void grow();
+
+public:
+	NodePool(size_t size) : nodeSize(size), freeList(0) {
+	}
+
+	void* allocate() {
+		if (freeList == 0) grow();
+		void* node = freeList;
+		freeList = *static_cast<void**>(node);
+		return node;
+	}
+
+	void release(void* node) {
+		*static_cast<void**>(node) = freeList;
+		freeList = node;
+	}
+};
+
+/**
+ * Allocates size bytes from the process wide NodePool for that size,
+ * or with operator new if size is larger than any of the pools' nodes.
+ * The pools live until the process ends, so memory from them may be
+ * released at any point, including during static destruction. When
+ * REPAST_SCHEDULE_THREADS is defined the pools are locked, so that the
+ * events of a parallel group may allocate from them concurrently.
+ */
+void* poolAllocate(size_t size);
+
+/**
+ * Releases memory allocated with poolAllocate(size).
+ */
+void poolRelease(void* ptr, size_t size);
+
+/**
+ * Standard allocator that allocates single objects from the process wide
+ * NodePools (see poolAllocate), and arrays with operator new. Used to
+ * allocate many small, equally sized objects, e.g. the control blocks of
+ * shared_ptrs.
+ */
+template<typename U>
+class PoolAllocator {
+public:
+	typedef U value_type;
+	typedef U* pointer;
+	typedef const U* const_pointer;
+	typedef U& reference;
+	typedef const U& const_reference;
+	typedef size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<typename V>
+	struct rebind {
+		typedef PoolAllocator<V> other;
+	};
+
+	PoolAllocator() {
+	}
+
+	template<typename V>
+	PoolAllocator(const PoolAllocator<V>&) {
+	}
+
+	pointer address(reference value) const {
+		return &value;
+	}
+
+	const_pointer address(const_reference value) const {
+		return &value;
+	}
+
+	pointer allocate(size_type n, const void* = 0) {
+		if (n == 1) return static_cast<pointer>(poolAllocate(sizeof(U)));
+		return static_cast<pointer>(::operator new(n * sizeof(U)));
+	}
+
+	void deallocate(pointer ptr, size_type n) {
+		if (n == 1)
+			poolRelease(ptr, sizeof(U));
+		else
+			::operator delete(ptr);
+	}
+
+	size_type max_size() const {
+		return size_t(-1) / sizeof(U);
+	}
+
+	void construct(pointer ptr, const U& value) {
+		new (ptr) U(value);
+	}
+
+	void destroy(pointer ptr) {
+		ptr->~U();
+	}
+
+	template<typename V>
+	bool operator==(const PoolAllocator<V>&) const {
+		return true;
+	}
+
+	template<typename V>
+	bool operator!=(const PoolAllocator<V>&) const {
+		return false;
+	}
+};
+
+}
+
+#endif /* NODEPOOL_H_ */
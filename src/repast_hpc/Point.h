@@ -42,6 +42,7 @@
 #define POINT_H_
 
 #include <vector>
+#include <array>
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
@@ -55,9 +56,11 @@
 namespace repast {
 
 /**
- * A N-dimensional Point representation.
+ * A N-dimensional Point representation. Point<T> has its number of
+ * dimensions set at run time; Point<T, N> with N > 0 has N dimensions
+ * fixed at compile time.
  */
-template<typename T>
+template<typename T, int N = 0>
 class Point;
 
 /**
@@ -83,7 +86,7 @@ std::ostream& operator<<(std::ostream& os, const Point<T>& pt);
  * and double.
  */
 template<typename T>
-class Point {
+class Point<T, 0> {
 
 private:
 	friend bool operator==<> (const Point<T> &one, const Point<T> &two);
@@ -255,6 +258,25 @@ public:
 	 * @param [out] the vector to copy the point coordinates into
 	 */
 	void copy(std::vector<T>& out) const;
+
+	/**
+	 * Sets the coordinates of this point from the specified vector,
+	 * reusing this point's storage, and updates its hash. Assumes the
+	 * vector is the same length as this point.
+	 *
+	 * @param coordinates the new coordinates
+	 */
+	void set(const std::vector<T>& coordinates);
+
+	/**
+	 * Sets the coordinates of this point from the specified fixed
+	 * dimension point, reusing this point's storage, and updates its
+	 * hash. Assumes the points have the same number of dimensions.
+	 *
+	 * @param coordinates the new coordinates
+	 */
+	template<int N>
+	void set(const Point<T, N>& coordinates);
 };
 
 template<typename T>
@@ -326,6 +348,12 @@ void Point<T>::copy(std::vector<T>& out) const {
 	std::copy(point.begin(), point.end(), out.begin());
 }
 
+template<typename T>
+void Point<T>::set(const std::vector<T>& coordinates) {
+	std::copy(coordinates.begin(), coordinates.end(), point.begin());
+	calcHash();
+}
+
 template<typename T>
 bool operator==(const Point<T> &one, const Point<T> &two) {
 	return one.point == two.point;
@@ -362,6 +390,232 @@ bool operator<(const Point<T>& one, const Point<T>& two) {
 	return std::lexicographical_compare(one.begin(), one.end(), two.begin(), two.end());
 }
 
+/**
+ * N dimensional point whose number of dimensions is fixed at compile time.
+ * The coordinates are held in a std::array, so creating, copying and
+ * updating a Point<T, N> never allocates, which makes it the coordinate
+ * type for per-agent hot paths such as moves. The interface follows
+ * Point<T>; a Point<T, N> converts to and from a Point<T> of N dimensions.
+ *
+ * @tparam T a numeric type. In repast and relogo these are limited to int
+ * and double.
+ * @tparam N the number of dimensions
+ */
+template<typename T, int N>
+class Point {
+
+private:
+	std::array<T, N> point;
+
+	friend class boost::serialization::access;
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		for (int i = 0; i < N; i++) ar & point[i];
+	}
+
+public:
+
+	typedef typename std::array<T, N>::const_iterator const_iterator;
+
+	/**
+	 * The number of dimensions of this point type.
+	 */
+	static constexpr int DIMENSIONS = N;
+
+	/**
+	 * Creates a point at the origin.
+	 */
+	Point() {
+		point.fill(0);
+	}
+
+	/**
+	 * Creates a one dimensional point with the specified value.
+	 *
+	 * @param x the x coordinate of the point
+	 */
+	explicit Point(T x) {
+		static_assert(N == 1, "Point(x) creates a one dimensional point");
+		point[0] = x;
+	}
+
+	/**
+	 * Creates a two dimensional point with the specified values.
+	 *
+	 * @param x the x coordinate of the point
+	 * @param y the y coordinate of the point
+	 */
+	Point(T x, T y) {
+		static_assert(N == 2, "Point(x, y) creates a two dimensional point");
+		point[0] = x;
+		point[1] = y;
+	}
+
+	/**
+	 * Creates a three dimensional point with the specified values.
+	 *
+	 * @param x the x coordinate of the point
+	 * @param y the y coordinate of the point
+	 * @param z the z coordinate of the point
+	 */
+	Point(T x, T y, T z) {
+		static_assert(N == 3, "Point(x, y, z) creates a three dimensional point");
+		point[0] = x;
+		point[1] = y;
+		point[2] = z;
+	}
+
+	/**
+	 * Creates a point with the coordinates of the specified point.
+	 *
+	 * @param pt the point to copy
+	 *
+	 * @throws Repast_Error_65 if pt does not have N dimensions
+	 */
+	explicit Point(const Point<T>& pt) {
+		if (pt.dimensionCount() != (size_t) N) throw Repast_Error_65(N, pt.dimensionCount()); // Dimensions do not match
+		std::copy(pt.begin(), pt.end(), point.begin());
+	}
+
+	/**
+	 * Creates a point with the specified coordinates.
+	 *
+	 * @param coordinates the coordinate values of the point
+	 *
+	 * @throws Repast_Error_65 if coordinates does not have N elements
+	 */
+	explicit Point(const std::vector<T>& coordinates) {
+		if (coordinates.size() != (size_t) N) throw Repast_Error_65(N, coordinates.size()); // Dimensions do not match
+		std::copy(coordinates.begin(), coordinates.end(), point.begin());
+	}
+
+	/**
+	 * Gets the x coordinate of the point.
+	 */
+	T getX() const {
+		return point[0];
+	}
+
+	/**
+	 * Gets the y coordinate of the point.
+	 */
+	T getY() const {
+		static_assert(N >= 2, "getY requires at least two dimensions");
+		return point[1];
+	}
+
+	/**
+	 * Gets the z coordinate of the point.
+	 */
+	T getZ() const {
+		static_assert(N >= 3, "getZ requires at least three dimensions");
+		return point[2];
+	}
+
+	/**
+	 * Gets the coodinate of the point in the specified dimension.
+	 *
+	 * @throws an out_of_range exception if this point doesn't
+	 * have the specified dimension.
+	 */
+	T getCoordinate(int coordIndex) const {
+		return point.at(coordIndex);
+	}
+
+	/**
+	 * Adds the specified point to this point. This point contains the result.
+	 */
+	void add(const Point<T, N>& pt) {
+		for (int i = 0; i < N; i++) point[i] += pt.point[i];
+	}
+
+	/**
+	 * Gets the number of dimensions of this point.
+	 */
+	static constexpr size_t dimensionCount() {
+		return N;
+	}
+
+	/**
+	 * Gets the coordinate value at the specified index.
+	 */
+	const T& operator[](size_t index) const {
+		return point[index];
+	}
+
+	/**
+	 * Gets the coordinate value at the specified index.
+	 */
+	T& operator[](size_t index) {
+		return point[index];
+	}
+
+	/**
+	 * Gets the coordinates of this point.
+	 */
+	const std::array<T, N>& coords() const {
+		return point;
+	}
+
+	/**
+	 * Gets the start of an iterator over the coordinates of this point.
+	 */
+	const_iterator begin() const {
+		return point.begin();
+	}
+
+	/**
+	 * Gets the end of an iterator over the coordinates of this point.
+	 */
+	const_iterator end() const {
+		return point.end();
+	}
+
+	/**
+	 * Copies the point into the specified vector. Assumes the
+	 * vector is the same length as this point.
+	 *
+	 * @param [out] the vector to copy the point coordinates into
+	 */
+	void copy(std::vector<T>& out) const {
+		std::copy(point.begin(), point.end(), out.begin());
+	}
+
+	/**
+	 * Gets this point as a Point<T>.
+	 */
+	Point<T> toPoint() const {
+		return Point<T>(std::vector<T>(point.begin(), point.end()));
+	}
+
+	friend bool operator==(const Point<T, N>& one, const Point<T, N>& two) {
+		return one.point == two.point;
+	}
+
+	friend bool operator!=(const Point<T, N>& one, const Point<T, N>& two) {
+		return !(one.point == two.point);
+	}
+
+	friend bool operator<(const Point<T, N>& one, const Point<T, N>& two) {
+		return one.point < two.point;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const Point<T, N>& pt) {
+		return os << pt.toPoint();
+	}
+};
+
+template<typename T, int N>
+constexpr int Point<T, N>::DIMENSIONS;
+
+template<typename T>
+template<int N>
+void Point<T>::set(const Point<T, N>& coordinates) {
+	std::copy(coordinates.begin(), coordinates.end(), point.begin());
+	calcHash();
+}
+
 }
 
 #endif /* POINT_H_ */
@@ -52,6 +52,8 @@
 #include <boost/serialization/set.hpp>
 
 #include "AgentId.h"
+#include "AgentIdSet.h"
+#include "NodePool.h"
 
 namespace repast {
 
@@ -84,7 +86,9 @@ BOOST_SERIALIZATION_ASSUME_ABSTRACT(ProjectionInfoPacket);
 
 /**
  * Serializable packet that can contain projection information
- * of a specific kind using the template parameter.
+ * of a specific kind using the template parameter. One is created
+ * for every agent and projection each time agents are exchanged,
+ * so they are allocated from the process wide NodePools.
  */
 template<typename Datum>
 class SpecializedProjectionInfoPacket: public ProjectionInfoPacket{
@@ -92,6 +96,14 @@ class SpecializedProjectionInfoPacket: public ProjectionInfoPacket{
 
 public:
 
+  static void* operator new(std::size_t size){
+    return poolAllocate(size);
+  }
+
+  static void operator delete(void* ptr, std::size_t size){
+    poolRelease(ptr, size);
+  }
+
   SpecializedProjectionInfoPacket(){} // For serialization
   SpecializedProjectionInfoPacket(AgentId agentId): ProjectionInfoPacket(agentId){}
   SpecializedProjectionInfoPacket(AgentId agentId, std::vector<Datum> projectionData): ProjectionInfoPacket(agentId){
@@ -132,6 +144,15 @@ protected:
 	virtual bool addAgent(boost::shared_ptr<T> agent) = 0;
 	virtual void removeAgent(T* agent) = 0;
 
+	/**
+	 * Adds the agents, as addAgent does for each of them. Projections that
+	 * can add many agents faster than one at a time override this.
+	 */
+	virtual void addAgents(const std::vector<boost::shared_ptr<T> >& agents) {
+		for (size_t i = 0; i < agents.size(); i++)
+			addAgent(agents[i]);
+	}
+
 
 	// Beta (Protected)
 	std::set<int> filter;
@@ -270,7 +291,7 @@ public:
    * 'contract' to the specified radius. Generally spaces do not require any agents, but graphs
    * do- generally the non-local ends to master copies of edges.
    */
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired, RADIUS radius = PRIMARY) = 0;
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired, RADIUS radius = PRIMARY) = 0;
 
   /**
    * Given a set of agents, gets the agents that this projection implementation must 'push' to
@@ -278,7 +299,7 @@ public:
    * must push local agents that are vertices to master edges where the other vertex is non-
    * local. The results are returned per-process in the agentsToPush map.
    */
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush) = 0;
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush) = 0;
 
   // Note: Virtual because some child classes may be able to short-circuit this (like Graphs)
   /**
@@ -294,7 +315,7 @@ public:
    */
   void updateProjectionInfo(std::vector<ProjectionInfoPacket*>& pips, Context<T>* context);
 
-  virtual void cleanProjectionInfo(std::set<AgentId>& agentsToKeep) = 0;
+  virtual void cleanProjectionInfo(AgentIdSet& agentsToKeep) = 0;
 
   virtual void balance(){};
 
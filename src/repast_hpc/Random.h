@@ -58,6 +58,7 @@
 #include <boost/random/lognormal_distribution.hpp>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_categories.hpp>
 
 
 namespace repast {
@@ -285,13 +286,23 @@ ptrdiff_t uni_random(ptrdiff_t i);
  * in iterator
  */
 template<typename I>
-int countOf(I iteratorStart, I iteratorEnd){
+int countOf(I iteratorStart, I iteratorEnd, boost::incrementable_traversal_tag){
   I iterator = iteratorStart;
   int c = 0;
   while(iterator != iteratorEnd){ iterator++; c++; }
   return c;
 }
 
+template<typename I>
+int countOf(I iteratorStart, I iteratorEnd, boost::random_access_traversal_tag){
+  return iteratorEnd - iteratorStart;
+}
+
+template<typename I>
+int countOf(I iteratorStart, I iteratorEnd){
+  return countOf(iteratorStart, iteratorEnd, typename boost::iterator_traversal<I>::type());
+}
+
 /**
  * Shuffles the order of a vector of elements.
  * Note that there can be alternative algorithms
@@ -385,7 +396,8 @@ void shuffleSet(std::set<T*>& elementSet, std::vector<T*>& elementList){
  *
  * Assuming that requests are evenly distributed, optimum interval for
  * landmarks is the square root of the size of the list, and performance
- * for the algorithm will be in log(size) time.
+ * for the algorithm will be in log(size) time. Random access iterators
+ * are simply advanced to the element, in constant time.
  *
  * Note that other implementations are possible- for example, checking
  * if enough memory would allow a completely indexed list. A long-term
@@ -423,6 +435,16 @@ public:
    * @param index
    */
   I get(int index){
+    return get(index, typename boost::iterator_traversal<I>::type());
+  }
+
+private:
+
+  I get(int index, boost::random_access_traversal_tag){
+    return begin + index;
+  }
+
+  I get(int index, boost::incrementable_traversal_tag){
     bool place = (index > (maxLandmark + interval));
     typename std::vector<std::pair<int, I > >::iterator lm = landmarks.end();
     while((--lm)->first > index);
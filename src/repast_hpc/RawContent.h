@@ -0,0 +1,216 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  RawContent.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef RAWCONTENT_H_
+#define RAWCONTENT_H_
+
+#include <vector>
+#include <type_traits>
+
+#include <mpi.h>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/datatype.hpp>
+
+#include "SyncProfiler.h"
+
+namespace repast {
+
+/**
+ * Gets the MPI datatype for the specified type, if boost.mpi has one for it.
+ */
+template<typename Content, bool IsMPIDatatype = boost::mpi::is_mpi_datatype<Content>::value>
+struct BoostContentDatatype {
+	static MPI_Datatype get() {
+		return MPI_DATATYPE_NULL;
+	}
+};
+
+template<typename Content>
+struct BoostContentDatatype<Content, true> {
+	static MPI_Datatype get() {
+		return boost::mpi::get_mpi_datatype<Content>(Content());
+	}
+};
+
+/**
+ * Describes how vectors of agent Content are sent between processes. By
+ * default Content is serialized with boost::serialization, unless boost.mpi
+ * knows an MPI datatype for it (see BOOST_IS_MPI_DATATYPE), in which case
+ * vectors of it are sent as raw contiguous buffers of that datatype.
+ *
+ * Content that is trivially copyable (a plain struct with no pointers,
+ * like the zombies model's AgentPackage) can be sent as raw bytes by declaring
+ * it with REPAST_RAW_CONTENT(Content) at global scope.
+ *
+ * When 'isRaw' is true, RepastProcess sends Content vectors outside of any
+ * boost archive in requestAgents, synchronizeAgentStates, synchronizeProjectionInfo
+ * and synchronizeAgentStatus.
+ */
+template<typename Content>
+struct ContentTraits {
+	static const bool isRaw = boost::mpi::is_mpi_datatype<Content>::value;
+
+	static MPI_Datatype datatype() {
+		return BoostContentDatatype<Content>::get();
+	}
+};
+
+/**
+ * Gets an MPI datatype made of sizeof(Content) bytes. The type is created
+ * and committed the first time it is requested.
+ */
+template<typename Content>
+MPI_Datatype rawContentDatatype() {
+	static MPI_Datatype datatype = MPI_DATATYPE_NULL;
+	if (datatype == MPI_DATATYPE_NULL) {
+		MPI_Type_contiguous((int) sizeof(Content), MPI_BYTE, &datatype);
+		MPI_Type_commit(&datatype);
+	}
+	return datatype;
+}
+
+/**
+ * Sends and receives vectors of Content as raw buffers for one round of an exchange.
+ * The vectors are owned by the caller; those sent must not be changed or deleted
+ * until the sends have completed (see wait), which destroying this also waits for.
+ */
+template<typename Content>
+class RawContentExchange {
+
+private:
+	boost::mpi::communicator* comm;
+	int tag;
+	std::vector<MPI_Request> requests;
+
+	void receive(MPI_Status& status, std::vector<Content>& content) {
+		int count = 0;
+		MPI_Get_count(&status, ContentTraits<Content>::datatype(), &count);
+		content.resize(count);
+		MPI_Recv(count == 0 ? 0 : &content[0], count, ContentTraits<Content>::datatype(), status.MPI_SOURCE, tag,
+				*comm, MPI_STATUS_IGNORE);
+	}
+
+public:
+	RawContentExchange(boost::mpi::communicator* communicator, int messageTag) :
+			comm(communicator), tag(messageTag) {
+	}
+
+	~RawContentExchange() {
+		wait();
+	}
+
+	/**
+	 * Sends the content to the specified process.
+	 */
+	void send(int dest, const std::vector<Content>& content) {
+		requests.push_back(MPI_REQUEST_NULL);
+		REPAST_SYNC_SENT(1, SyncProfiler::bytes(ContentTraits<Content>::datatype(), (int) content.size()));
+		MPI_Isend(content.empty() ? 0 : const_cast<Content*>(&content[0]), (int) content.size(),
+				ContentTraits<Content>::datatype(), dest, tag, *comm, &requests.back());
+	}
+
+	/**
+	 * Receives content from the specified process into the vector, replacing
+	 * what it held and waiting for the content if necessary.
+	 */
+	void receive(int source, std::vector<Content>& content) {
+		MPI_Status status;
+		MPI_Probe(source, tag, *comm, &status);
+		receive(status, content);
+	}
+
+	/**
+	 * Receives content from the specified process into the vector if it has
+	 * arrived.
+	 *
+	 * @return true if the content was received, otherwise false
+	 */
+	bool tryReceive(int source, std::vector<Content>& content) {
+		int flag = 0;
+		MPI_Status status;
+		MPI_Iprobe(source, tag, *comm, &flag, &status);
+		if (!flag)
+			return false;
+		receive(status, content);
+		return true;
+	}
+
+	/**
+	 * Tests whether all the sends have completed.
+	 */
+	bool testSends() {
+		int flag = 1;
+		if (requests.size() > 0)
+			MPI_Testall((int) requests.size(), &requests[0], &flag, MPI_STATUSES_IGNORE);
+		return flag != 0;
+	}
+
+	/**
+	 * Waits for all the sends to complete.
+	 */
+	void wait() {
+		if (requests.size() > 0)
+			MPI_Waitall((int) requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+		requests.clear();
+	}
+
+};
+
+}
+
+/**
+ * Declares that vectors of the specified Content type are to be sent as raw
+ * bytes, bypassing boost::serialization. The type must be trivially copyable;
+ * Content holding a std::string, a container or a pointer fails to compile.
+ */
+#define REPAST_RAW_CONTENT(T) \
+namespace repast { \
+template<> \
+struct ContentTraits<T> { \
+	static_assert(std::is_trivially_copyable<T>::value, \
+			"REPAST_RAW_CONTENT requires a trivially copyable Content type"); \
+	static const bool isRaw = true; \
+	static MPI_Datatype datatype() { \
+		return rawContentDatatype<T>(); \
+	} \
+}; \
+}
+
+#endif /* RAWCONTENT_H_ */
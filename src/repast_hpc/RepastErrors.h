@@ -879,6 +879,105 @@ public:
       RESOLUTION    "Modify the incorrect line in the properties file, or alter the code to provide a communicator for initializeSeed"
 END_ERR
 
+/* Error 58 */
+class Repast_Error_58: public std::invalid_argument{
+public:
+  Repast_Error_58(): INVALID_ARG(ERROR_NUMBER 58)
+      THROWN_BY     "RepastProcess::beginSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Provider& provider, std::string setName)"
+      REASON        "The handle passed already has an agent state synchronization in progress."
+      EXPLANATION   "Each handle tracks a single exchange; an exchange must be finished before the handle can be used to begin another."
+      CAUSE         "beginSynchronizeAgentStates was called twice with the same handle without an intervening call to finishSynchronizeAgentStates"
+      RESOLUTION    "Call finishSynchronizeAgentStates with the handle before beginning a new synchronization, or use a separate handle."
+END_ERR
+
+/* Error 59 */
+class Repast_Error_59: public std::invalid_argument{
+public:
+  Repast_Error_59(): INVALID_ARG(ERROR_NUMBER 59)
+      THROWN_BY     "RepastProcess::finishSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Updater& updater)"
+      REASON        "The handle passed does not have an agent state synchronization in progress."
+      EXPLANATION   "Only an exchange begun with beginSynchronizeAgentStates can be finished, and it can be finished only once."
+      CAUSE         "finishSynchronizeAgentStates was called with a handle that was never begun or that has already been finished"
+      RESOLUTION    "Call beginSynchronizeAgentStates with the handle before finishing it."
+END_ERR
+
+/* Error 60 */
+class Repast_Error_60: public std::invalid_argument{
+public:
+  Repast_Error_60(size_t destinations, size_t objects): INVALID_ARG(ERROR_NUMBER 60)
+      THROWN_BY     "NeighborhoodCommunicator::exchange(const std::map<int, T*>& outgoing, std::map<int, T*>& incoming)"
+      REASON        "The graph has " + VAL(destinations) + " destinations but " + VAL(objects) + " objects were to be sent, or an object was to be sent to a process that is not a destination"
+      EXPLANATION   "A neighborhood exchange sends exactly one object to each destination in the graph and can send nothing to any other process."
+      CAUSE         "The processes this process sends to have changed since the last synchronization, but the exchange pattern assumes they are unchanged (USE_LAST_OR_POLL or USE_LAST_OR_USE_CURRENT)"
+      RESOLUTION    "Use POLL or USE_CURRENT for synchronizations in which the set of partner processes can change, or turn off neighborhood collectives."
+END_ERR
+
+/* Error 61 */
+class Repast_Error_61: public std::invalid_argument{
+public:
+  Repast_Error_61(size_t dimensions, size_t dimensionsGiven): INVALID_ARG(ERROR_NUMBER 61)
+      THROWN_BY     "CartesianTopology::setPartition(const std::vector<std::vector<double> >& fractions)"
+      REASON        "The partition given (" + VAL(dimensionsGiven) + " dimensions) is not valid for this topology of " + VAL(dimensions) + " dimensions"
+      EXPLANATION   "A partition must give, for each dimension, one more fraction than there are processes in that dimension, starting at 0, ending at 1 and strictly increasing, so that every process has a slab of nonzero extent."
+      CAUSE         "The partition has the wrong number of dimensions or fractions, or gives some process an empty or negative extent"
+      RESOLUTION    "Start from the partition returned by getPartition and move only the fractions between the first and the last, keeping them in increasing order."
+END_ERR
+
+/* Error 62 */
+class Repast_Error_62: public std::invalid_argument{
+public:
+  Repast_Error_62(double lookahead): INVALID_ARG(ERROR_NUMBER 62)
+      THROWN_BY     "ScheduleRunner::setLookahead(double ticks)"
+      REASON        "The lookahead given (" + VAL(lookahead) + ") is negative"
+      EXPLANATION   "The lookahead is the number of ticks past the earliest next tick of all processes that each process executes before the processes agree on the next tick again, so it cannot be less than 0."
+      CAUSE         "A negative value was passed as the lookahead"
+      RESOLUTION    "Use 0 to agree on every tick, or a positive number of ticks."
+END_ERR
+
+/* Error 63 */
+class Repast_Error_63: public std::invalid_argument{
+public:
+  Repast_Error_63(int threads): INVALID_ARG(ERROR_NUMBER 63)
+      THROWN_BY     "Schedule::setThreadCount(int threads)"
+      REASON        "The thread count given (" + VAL(threads) + ") is less than 1, or is greater than 1 and Repast HPC was built without REPAST_SCHEDULE_THREADS"
+      EXPLANATION   "The schedule's events are executed by at least the calling thread; worker threads for parallel groups are only available when REPAST_SCHEDULE_THREADS is defined."
+      CAUSE         "A thread count of 0 or less was given, or more threads were requested from a build without thread support"
+      RESOLUTION    "Use a thread count of 1 or more, and to use more than 1 define REPAST_SCHEDULE_THREADS in Schedule.h and link against boost_thread."
+END_ERR
+
+/* Error 64 */
+class Repast_Error_64: public std::invalid_argument{
+public:
+  Repast_Error_64(size_t dimensions, size_t dimensionsGiven): INVALID_ARG(ERROR_NUMBER 64)
+      THROWN_BY     "NeighborhoodStencil, NDGridQuery<T>::query or NDValueLayerQuery<T>::query"
+      REASON        "The stencil, offset or center given has " + VAL(dimensionsGiven) + " dimensions but " + VAL(dimensions) + " were expected"
+      EXPLANATION   "A neighborhood stencil has at least one dimension, every offset in it has the stencil's number of dimensions, and it can only be applied to a grid or value layer with the same number of dimensions."
+      CAUSE         "A stencil was created with fewer than 1 dimension, an offset of the wrong length was added, or a stencil or center was used with a space of a different dimensionality"
+      RESOLUTION    "Create the stencil with the number of dimensions of the space it will be applied to, and give centers and offsets with that many coordinates."
+END_ERR
+
+/* Error 65 */
+class Repast_Error_65: public std::invalid_argument{
+public:
+  Repast_Error_65(size_t dimensions, size_t dimensionsGiven): INVALID_ARG(ERROR_NUMBER 65)
+      THROWN_BY     "Point<T, N>::Point(const Point<T>& pt) or Point<T, N>::Point(const std::vector<T>& coordinates)"
+      REASON        "A point of " + VAL(dimensions) + " fixed dimensions cannot be created from coordinates of " + VAL(dimensionsGiven) + " dimensions"
+      EXPLANATION   "A point whose number of dimensions is fixed at compile time can only be created from coordinates with that number of dimensions."
+      CAUSE         "The Point<T, N> type used does not match the number of dimensions of the space or of the point it was created from"
+      RESOLUTION    "Use a Point<T, N> whose N is the number of dimensions of the space, or use Point<T>."
+END_ERR
+
+/* Error 66 */
+class Repast_Error_66: public std::invalid_argument{
+public:
+  Repast_Error_66(int outstanding): INVALID_ARG(ERROR_NUMBER 66)
+      THROWN_BY     "RepastProcess::beginSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Provider& provider, std::string setName)"
+      REASON        "An agent state synchronization was begun while " + VAL(outstanding) + " begun before it are still in progress, one of which uses the tag it would be given."
+      EXPLANATION   "Agent state synchronizations that send Content raw are told apart by their message tags, of which there is a fixed number; the exchange begun that many synchronizations ago must be finished before another can be begun."
+      CAUSE         "Too many handles were begun without being finished, or a handle that was begun was never finished"
+      RESOLUTION    "Finish older synchronizations with finishSynchronizeAgentStates before beginning new ones."
+END_ERR
+
 /* TEMPLATE
 class Repast_Error_: public std::invalid_argument{
 public:
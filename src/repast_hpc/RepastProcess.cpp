@@ -66,9 +66,13 @@ namespace repast {
 RepastProcess* RepastProcess::_instance = 0;
 
 RepastProcess::RepastProcess(boost::mpi::communicator* comm) : world(comm), runner(new ScheduleRunner(world)),
-		rank_(world->rank()), worldSize_(world->size()),
+		rank_(world->rank()), worldSize_(world->size()), deltaAgentStateSync(false),
+		stateSyncSequence(0), stateContentTagsInUse(AGENT_STATE_CONTENT_TAGS, false),
+		requestExchange(ALL_TO_ALL), sparseRequestRound(0),
 		procsToSendProjInfoTo(NULL), procsToRecvProjInfoFrom(NULL), procsToSendAgentStatusInfoTo(NULL),
-		procsToRecvAgentStatusInfoFrom(NULL) {
+		procsToRecvAgentStatusInfoFrom(NULL), useNeighborhoodCollectives(false),
+		projInfoNeighborhood(NULL), agentStatusNeighborhood(NULL), projInfoNeighborhoodChecked(false),
+		agentStatusNeighborhoodChecked(false) {
 
 	//world = comm;
 	//runner = new ScheduleRunner(world);
@@ -119,6 +123,9 @@ RepastProcess* RepastProcess::init(string propsfile,
 	else
 		Log4CL::configure(tmpWorld->rank());
 	_instance = new RepastProcess(tmpWorld);
+#ifdef REPAST_SYNC_PROFILING
+	SyncProfiler::instance()->clear();
+#endif
 
 	return _instance;
 }
@@ -134,6 +141,9 @@ boost::mpi::communicator* RepastProcess::communicator() {
 }
 
 void RepastProcess::done() {
+#ifdef REPAST_SYNC_PROFILING
+	SyncProfiler::instance()->report(*world);
+#endif
 	Log4CL::instance()->close();
 }
 
@@ -147,6 +157,7 @@ void RepastProcess::addImportedAgent(AgentId id) {
 
 void RepastProcess::agentRemoved(const AgentId& id) {
 	movedAgents.erase(id);
+	dirtyAgents.erase(id);
 	importer_exporter->agentRemoved(id);
 }
 
@@ -173,6 +184,7 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 		, std::string setName, AGENT_IMPORTER_EXPORTER_TYPE setType
 #endif
 		) {
+	REPAST_SYNC_PROFILE(AGENT_REQUEST);
 
 	// Record and process the outgoing request for agents from other processes
 #ifndef SHARE_AGENTS_BY_SET
@@ -181,6 +193,28 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 	importer_exporter->registerOutgoingRequests(request, setName, setType);
 #endif
 
+	vector<AgentRequest> reqsRecd;
+	switch (requestExchange) {
+	case SPARSE_COUNTS:
+		exchangeAgentRequestsSparseCounts(request, reqsRecd);
+		break;
+	case SPARSE_NBX:
+		exchangeAgentRequestsSparseNBX(request, reqsRecd);
+		break;
+	default:
+		exchangeAgentRequestsAllToAll(request, reqsRecd);
+	}
+
+	// Set up export of agents requested by other processes
+#ifndef SHARE_AGENTS_BY_SET
+	importer_exporter->registerIncomingRequests(reqsRecd);
+#else
+	importer_exporter->registerIncomingRequests(reqsRecd, setName);
+#endif
+
+}
+
+void RepastProcess::exchangeAgentRequestsAllToAll(AgentRequest& request, vector<AgentRequest>& reqsRecd) {
 	int* countsOfRequests = new int[worldSize_];
 	for (int i = 0; i < worldSize_; ++i)
 		countsOfRequests[i] = 0; // OOPS! This was not included in version 1.0.1 final
@@ -253,13 +287,13 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 	}
 
 	// Exchange data
+	REPAST_SYNC_PARTNERS(worldSize_ - 1, worldSize_ - 1);
+	REPAST_SYNC_SENT(worldSize_ - 1, (worldSize_ - 1) * dataElementSize * sizeof(int));
 	MPI_Alltoall(data, dataElementSize, MPI_INT, rec, dataElementSize, MPI_INT,
 			*world);
 	delete[] data; // Done with this...
 
 	// Now re-package the received data as the vector<AgentRequest> that is needed
-
-	vector<AgentRequest> reqsRecd;
 	for (int i = 0; i < worldSize_; i++) {
 		if (i != rank_) { // This isn't necessary as long as a process doesn't request agents from itself (!); this acts as an error trap if this happens
 			int index = i * dataElementSize;
@@ -289,14 +323,161 @@ void RepastProcess::initiateAgentRequest(AgentRequest& request
 
 	delete[] countsOfRequests;
 	delete[] rec;
+}
 
-	// Set up export of agents requested by other processes
-#ifndef SHARE_AGENTS_BY_SET
-	importer_exporter->registerIncomingRequests(reqsRecd);
-#else
-	importer_exporter->registerIncomingRequests(reqsRecd, setName);
-#endif
+namespace {
+
+/*
+ * Packs the requests and cancellations in the specified request into one
+ * int buffer per target process. Each buffer holds the number of requests,
+ * the number of cancellations, and then (id, startingRank, agentType) triples
+ * for the requests followed by the cancellations. Requests that target this
+ * process are dropped (see the error trap in the all-to-all version).
+ */
+void packAgentRequests(const AgentRequest& request, int rank, map<int, vector<int> >& buffers) {
+	const vector<AgentId>& requestedAgents = request.requestedAgents();
+	const vector<AgentId>& cancellations = request.cancellations();
+
+	for (size_t i = 0; i < requestedAgents.size(); i++) {
+		const AgentId& id = requestedAgents[i];
+		if (id.currentRank() == rank) continue;
+		vector<int>& buf = buffers[id.currentRank()];
+		if (buf.empty()) buf.resize(2, 0);
+		buf[0]++;
+		buf.push_back(id.id());
+		buf.push_back(id.startingRank());
+		buf.push_back(id.agentType());
+	}
 
+	for (size_t i = 0; i < cancellations.size(); i++) {
+		const AgentId& id = cancellations[i];
+		if (id.currentRank() == rank) continue;
+		vector<int>& buf = buffers[id.currentRank()];
+		if (buf.empty()) buf.resize(2, 0);
+		buf[1]++;
+	}
+	// Cancellations go after all the requests, so make a second pass
+	for (size_t i = 0; i < cancellations.size(); i++) {
+		const AgentId& id = cancellations[i];
+		if (id.currentRank() == rank) continue;
+		vector<int>& buf = buffers[id.currentRank()];
+		buf.push_back(id.id());
+		buf.push_back(id.startingRank());
+		buf.push_back(id.agentType());
+	}
+}
+
+/*
+ * Unpacks a buffer created by packAgentRequests and sent by the specified
+ * source process into an AgentRequest.
+ */
+AgentRequest unpackAgentRequest(const vector<int>& buf, int source, int rank) {
+	AgentRequest req(source, rank);
+	int numRequests = buf[0];
+	int numCancellations = buf[1];
+	size_t index = 2;
+	for (int i = 0; i < numRequests; i++, index += 3) {
+		AgentId id(buf[index], buf[index + 1], buf[index + 2]);
+		id.currentRank(rank);
+		req.addRequest(id);
+	}
+	for (int i = 0; i < numCancellations; i++, index += 3) {
+		AgentId id(buf[index], buf[index + 1], buf[index + 2]);
+		id.currentRank(rank);
+		req.addCancellation(id);
+	}
+	return req;
+}
+
+}
+
+void RepastProcess::exchangeAgentRequestsSparseCounts(AgentRequest& request, vector<AgentRequest>& reqsRecd) {
+	map<int, vector<int> > sendBuffers;
+	packAgentRequests(request, rank_, sendBuffers);
+
+	// Every process learns how many ints it will receive from every other process
+	vector<int> sendSizes(worldSize_, 0);
+	vector<int> recvSizes(worldSize_, 0);
+	for (map<int, vector<int> >::iterator iter = sendBuffers.begin(); iter != sendBuffers.end(); ++iter)
+		sendSizes[iter->first] = (int) iter->second.size();
+	REPAST_SYNC_SENT(worldSize_ - 1, (worldSize_ - 1) * sizeof(int));
+	MPI_Alltoall(&sendSizes[0], 1, MPI_INT, &recvSizes[0], 1, MPI_INT, *world);
+
+	map<int, vector<int> > recvBuffers;
+	vector<MPI_Request> requests;
+	for (int i = 0; i < worldSize_; i++) {
+		if (recvSizes[i] > 0) {
+			vector<int>& buf = recvBuffers[i];
+			buf.resize(recvSizes[i]);
+			requests.push_back(MPI_Request());
+			MPI_Irecv(&buf[0], recvSizes[i], MPI_INT, i, AGENT_REQUEST_TAG, *world, &requests.back());
+		}
+	}
+	REPAST_SYNC_PARTNERS(sendBuffers.size(), recvBuffers.size());
+	for (map<int, vector<int> >::iterator iter = sendBuffers.begin(); iter != sendBuffers.end(); ++iter) {
+		REPAST_SYNC_SENT(1, iter->second.size() * sizeof(int));
+		requests.push_back(MPI_Request());
+		MPI_Isend(&iter->second[0], (int) iter->second.size(), MPI_INT, iter->first, AGENT_REQUEST_TAG, *world,
+				&requests.back());
+	}
+	if (requests.size() > 0) MPI_Waitall((int) requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+
+	for (map<int, vector<int> >::iterator iter = recvBuffers.begin(); iter != recvBuffers.end(); ++iter)
+		reqsRecd.push_back(unpackAgentRequest(iter->second, iter->first, rank_));
+}
+
+void RepastProcess::exchangeAgentRequestsSparseNBX(AgentRequest& request, vector<AgentRequest>& reqsRecd) {
+	map<int, vector<int> > sendBuffers;
+	packAgentRequests(request, rank_, sendBuffers);
+
+	// A process can leave the barrier while others are still receiving, and
+	// so send the next round's messages early; alternating tags keeps those
+	// from being received as part of this round.
+	int tag = (sparseRequestRound % 2 == 0 ? AGENT_REQUEST_SPARSE_EVEN : AGENT_REQUEST_SPARSE_ODD);
+	sparseRequestRound++;
+
+	// Synchronous sends complete only once they have been matched by a receive
+	vector<MPI_Request> sends(sendBuffers.size());
+	int s = 0;
+	for (map<int, vector<int> >::iterator iter = sendBuffers.begin(); iter != sendBuffers.end(); ++iter, ++s) {
+		REPAST_SYNC_SENT(1, iter->second.size() * sizeof(int));
+		MPI_Issend(&iter->second[0], (int) iter->second.size(), MPI_INT, iter->first, tag, *world, &sends[s]);
+	}
+
+	map<int, vector<int> > recvBuffers;
+	MPI_Request barrier = MPI_REQUEST_NULL;
+	bool barrierActive = false;
+	bool done = false;
+	while (!done) {
+		int flag = 0;
+		MPI_Status status;
+		MPI_Iprobe(MPI_ANY_SOURCE, tag, *world, &flag, &status);
+		if (flag) {
+			int count = 0;
+			MPI_Get_count(&status, MPI_INT, &count);
+			vector<int>& buf = recvBuffers[status.MPI_SOURCE];
+			buf.resize(count);
+			MPI_Recv(&buf[0], count, MPI_INT, status.MPI_SOURCE, tag, *world, MPI_STATUS_IGNORE);
+		}
+		if (barrierActive) {
+			int barrierDone = 0;
+			MPI_Test(&barrier, &barrierDone, MPI_STATUS_IGNORE);
+			done = (barrierDone != 0);
+		} else {
+			int sendsDone = 1;
+			if (sends.size() > 0) MPI_Testall((int) sends.size(), &sends[0], &sendsDone, MPI_STATUSES_IGNORE);
+			if (sendsDone) {
+				MPI_Ibarrier(*world, &barrier);
+				barrierActive = true;
+			}
+		}
+	}
+
+	REPAST_SYNC_PARTNERS(sendBuffers.size(), recvBuffers.size());
+
+	// Buffers are keyed by source, so requests are registered in rank order as in the all-to-all version
+	for (map<int, vector<int> >::iterator iter = recvBuffers.begin(); iter != recvBuffers.end(); ++iter)
+		reqsRecd.push_back(unpackAgentRequest(iter->second, iter->first, rank_));
 }
 
 RepastProcess::~RepastProcess() {
@@ -309,11 +490,27 @@ RepastProcess::~RepastProcess() {
 	delete procsToSendAgentStatusInfoTo;
 	delete procsToRecvAgentStatusInfoFrom;
 
+	delete projInfoNeighborhood;
+	delete agentStatusNeighborhood;
+
 	for(size_t i = 0; i < cartesianTopologies.size(); i++) delete cartesianTopologies[i];
 
+	clearSyncBuffers();
+
 	_instance = 0;
 }
 
+void RepastProcess::clearSyncBuffers() {
+	for (size_t i = 0; i < bufferPools.size(); i++)
+		delete bufferPools[i];
+	bufferPools.clear();
+}
+
+size_t SyncBufferPoolBase::nextIndex() {
+	static size_t count = 0;
+	return count++;
+}
+
 CartesianTopology* RepastProcess::getCartesianTopology(std::vector<int> processesPerDim, bool spaceIsPeriodic){
   for(size_t i = 0; i < cartesianTopologies.size(); i++){
     if(cartesianTopologies[i]->matches(processesPerDim, spaceIsPeriodic)) return cartesianTopologies[i];
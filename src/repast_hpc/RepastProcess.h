@@ -51,9 +51,11 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/noncopyable.hpp>
-#include <boost/ptr_container/ptr_list.hpp>
 #include <boost/serialization/utility.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include "Schedule.h"
 #include "AgentId.h"
@@ -65,6 +67,9 @@
 #include "RepastErrors.h"
 #include "AgentImporterExporter.h"
 #include "CartesianTopology.h"
+#include "NeighborhoodCommunicator.h"
+#include "RawContent.h"
+#include "SyncProfiler.h"
 
 // these are for the timings logging
 #include "Utilities.h"
@@ -83,6 +88,69 @@
 
 namespace repast {
 
+typedef std::map<std::string, std::vector<ProjectionInfoPacket*> > ProjectionInfoMap;
+
+/**
+ * Writes the agent Content of a packet to an archive. Content that is sent
+ * raw (see ContentTraits) is sent separately and is not written.
+ */
+template<class Archive, typename Content>
+void saveContent(Archive& ar, const std::vector<Content>* content) {
+	bool hasContent = (content != 0) && !ContentTraits<Content>::isRaw;
+	ar << hasContent;
+	if (hasContent)
+		ar << *content;
+}
+
+/**
+ * Reads the agent Content of a packet from an archive into the vector,
+ * which is created if necessary; reading into an existing vector reuses its
+ * capacity.
+ */
+template<class Archive, typename Content>
+void loadContent(Archive& ar, std::vector<Content>*& content) {
+	bool hasContent;
+	ar >> hasContent;
+	if (content == 0)
+		content = new std::vector<Content>;
+	if (hasContent)
+		ar >> *content;
+}
+
+/**
+ * Writes the projection information of a packet to an archive.
+ */
+template<class Archive>
+void saveProjectionInfo(Archive& ar, const ProjectionInfoMap* projectionInfo) {
+	size_t count = (projectionInfo == 0 ? 0 : projectionInfo->size());
+	ar << count;
+	if (count > 0) {
+		for (ProjectionInfoMap::const_iterator iter = projectionInfo->begin(), iterEnd = projectionInfo->end();
+				iter != iterEnd; ++iter) {
+			ar << iter->first;
+			ar << iter->second;
+		}
+	}
+}
+
+/**
+ * Reads the projection information of a packet from an archive into the map,
+ * which is created if necessary. The vectors for projections already in the
+ * map are reused; they must be empty.
+ */
+template<class Archive>
+void loadProjectionInfo(Archive& ar, ProjectionInfoMap*& projectionInfo) {
+	size_t count;
+	ar >> count;
+	if (projectionInfo == 0)
+		projectionInfo = new ProjectionInfoMap;
+	for (size_t i = 0; i < count; i++) {
+		std::string name;
+		ar >> name;
+		ar >> (*projectionInfo)[name];
+	}
+}
+
 /**
  * Contains information sent as agents are exchanged, either in response to
  * requests or agent movement. Contains both agent raw information
@@ -134,11 +202,19 @@ public:
 	}
 
 	template<class Archive>
-	void serialize(Archive& ar, const unsigned int version) {
-		ar & agentContentPtr;
-		ar & projectionInfoPtr;
+	void save(Archive& ar, const unsigned int version) const {
+		saveContent(ar, agentContentPtr);
+		saveProjectionInfo(ar, projectionInfoPtr);
 	}
 
+	template<class Archive>
+	void load(Archive& ar, const unsigned int version) {
+		loadContent(ar, agentContentPtr);
+		loadProjectionInfo(ar, projectionInfoPtr);
+	}
+
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 };
 
 /**
@@ -215,11 +291,301 @@ public:
 	}
 
 	template<class Archive>
-	void serialize(Archive& ar, const unsigned int version) {
-		ar & agentContentPtr;
-		ar & projectionInfoPtr;
-		ar & secondaryIdsPtr;
-		ar & exporterInfoPtr;
+	void save(Archive& ar, const unsigned int version) const {
+		saveContent(ar, agentContentPtr);
+		saveProjectionInfo(ar, projectionInfoPtr);
+		ar << secondaryIdsPtr;
+		ar << exporterInfoPtr;
+	}
+
+	template<class Archive>
+	void load(Archive& ar, const unsigned int version) {
+		loadContent(ar, agentContentPtr);
+		loadProjectionInfo(ar, projectionInfoPtr);
+		ar >> secondaryIdsPtr;
+		ar >> exporterInfoPtr;
+	}
+
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+};
+
+/**
+ * Base class for SyncBufferPool, so that RepastProcess can keep the pools
+ * for different types of Content together.
+ */
+class SyncBufferPoolBase: public boost::noncopyable {
+
+protected:
+	static size_t nextIndex();
+
+public:
+	virtual ~SyncBufferPoolBase() {
+	}
+
+};
+
+/**
+ * Keeps the packets and Content vectors used to exchange agents between
+ * processes so that they, and the capacity they have grown to, are reused
+ * from one synchronization to the next instead of being created and deleted
+ * every time. RepastProcess keeps one pool for each type of Content.
+ *
+ * Packets taken from the pool always have a Content vector and a projection
+ * information map. When a packet is released its Content is cleared and its
+ * ProjectionInfoPackets are deleted, but the map keeps its (now empty) vectors.
+ *
+ * @tparam Content the serializable struct or class that describes the
+ * state of agents
+ */
+template<typename Content>
+class SyncBufferPool: public SyncBufferPoolBase {
+
+private:
+	std::vector<std::vector<Content>*> contents;
+	std::vector<Request_Packet<Content>*> requestPackets;
+	std::vector<SyncStatus_Packet<Content>*> syncStatusPackets;
+
+	void clearProjectionInfo(ProjectionInfoMap*& projectionInfo) {
+		if (projectionInfo == 0) {
+			projectionInfo = new ProjectionInfoMap;
+			return;
+		}
+		for (ProjectionInfoMap::iterator iter = projectionInfo->begin(), iterEnd = projectionInfo->end();
+				iter != iterEnd; ++iter) {
+			for (size_t i = 0; i < iter->second.size(); i++)
+				delete iter->second[i];
+			iter->second.clear();
+		}
+	}
+
+	void clearContent(std::vector<Content>*& content) {
+		if (content == 0)
+			content = this->content();
+		else
+			content->clear();
+	}
+
+public:
+	/**
+	 * Gets the index of the pool for this type of Content in RepastProcess.
+	 */
+	static size_t index() {
+		static size_t index = nextIndex();
+		return index;
+	}
+
+	virtual ~SyncBufferPool() {
+		for (size_t i = 0; i < contents.size(); i++)
+			delete contents[i];
+		for (size_t i = 0; i < requestPackets.size(); i++)
+			delete requestPackets[i];
+		for (size_t i = 0; i < syncStatusPackets.size(); i++)
+			delete syncStatusPackets[i];
+	}
+
+	/**
+	 * Gets an empty Content vector.
+	 */
+	std::vector<Content>* content() {
+		if (contents.empty())
+			return new std::vector<Content>;
+		std::vector<Content>* content = contents.back();
+		contents.pop_back();
+		return content;
+	}
+
+	/**
+	 * Returns a Content vector to the pool.
+	 */
+	void release(std::vector<Content>* content) {
+		content->clear();
+		contents.push_back(content);
+	}
+
+	/**
+	 * Gets an empty Request_Packet.
+	 */
+	Request_Packet<Content>* requestPacket() {
+		if (requestPackets.empty())
+			return new Request_Packet<Content>(content(), new ProjectionInfoMap);
+		Request_Packet<Content>* packet = requestPackets.back();
+		requestPackets.pop_back();
+		return packet;
+	}
+
+	/**
+	 * Returns a Request_Packet to the pool, deleting its projection information.
+	 */
+	void release(Request_Packet<Content>* packet) {
+		clearContent(packet->agentContentPtr);
+		clearProjectionInfo(packet->projectionInfoPtr);
+		requestPackets.push_back(packet);
+	}
+
+	/**
+	 * Gets an empty SyncStatus_Packet.
+	 */
+	SyncStatus_Packet<Content>* syncStatusPacket() {
+		if (syncStatusPackets.empty())
+			return new SyncStatus_Packet<Content>(content(), new ProjectionInfoMap, 0, 0);
+		SyncStatus_Packet<Content>* packet = syncStatusPackets.back();
+		syncStatusPackets.pop_back();
+		return packet;
+	}
+
+	/**
+	 * Returns a SyncStatus_Packet to the pool, deleting its projection information
+	 * and secondary ids. The exporter info is not deleted (see
+	 * SyncStatus_Packet::deleteExporterInfo).
+	 */
+	void release(SyncStatus_Packet<Content>* packet) {
+		clearContent(packet->agentContentPtr);
+		clearProjectionInfo(packet->projectionInfoPtr);
+		delete packet->secondaryIdsPtr;
+		packet->secondaryIdsPtr = 0;
+		packet->exporterInfoPtr = 0;
+		syncStatusPackets.push_back(packet);
+	}
+
+};
+
+/**
+ * Tracks an agent state synchronization that has been started with
+ * RepastProcess::beginSynchronizeAgentStates but not yet finished with
+ * RepastProcess::finishSynchronizeAgentStates. The handle owns the send
+ * and receive buffers of the exchange; if it is destroyed before the
+ * exchange is finished it waits for the outstanding messages to complete
+ * and discards what was received.
+ *
+ * @tparam Content the serializable struct or class that describes the
+ * state of agents
+ */
+template<typename Content>
+class AgentStateSyncHandle: public boost::noncopyable {
+
+	friend class RepastProcess;
+
+private:
+	std::vector<boost::mpi::request> requests;
+	std::vector<bool> completed;
+	std::vector<std::vector<Content>*> sent;
+	std::vector<boost::shared_ptr<boost::mpi::packed_oarchive> > archives;
+	std::vector<std::vector<Content>*> received;
+	bool active;
+	SyncBufferPool<Content>* pool; // The buffers are taken from and returned to this
+
+	// Used instead of the above when Content is sent raw (see ContentTraits).
+	// The receives are matched by probing, so each raw exchange has its own tag
+	// and cannot take the messages of another exchange that is in flight.
+	RawContentExchange<Content>* raw;
+	std::vector<int> rawSources; // Processes whose content has not yet been received
+	std::vector<bool>* rawTags; // The RepastProcess's tags in use
+	int rawTag;
+
+	void releaseTag() {
+		if (rawTags != 0)
+			(*rawTags)[rawTag - AGENT_STATE_CONTENT] = false;
+		rawTags = 0;
+	}
+
+	void add(const boost::mpi::request& request) {
+		requests.push_back(request);
+		completed.push_back(false);
+	}
+
+	// Note that boost's wait_all and test_all cannot be used here: test_all
+	// never reports serialized messages as complete, and a request cannot
+	// be waited on once a test has found it complete.
+	void wait() {
+		for (size_t i = 0; i < requests.size(); i++) {
+			if (!completed[i]) {
+				requests[i].wait();
+				completed[i] = true;
+			}
+		}
+		if (raw != 0) {
+			for (size_t i = 0; i < rawSources.size(); i++) {
+				received.push_back(pool->content());
+				raw->receive(rawSources[i], *received.back());
+			}
+			rawSources.clear();
+			raw->wait();
+		}
+	}
+
+	void clear() {
+		requests.clear();
+		completed.clear();
+		for (size_t i = 0; i < sent.size(); i++)
+			pool->release(sent[i]);
+		sent.clear();
+		archives.clear();
+		for (size_t i = 0; i < received.size(); i++)
+			pool->release(received[i]);
+		received.clear();
+		delete raw;
+		raw = 0;
+		rawSources.clear();
+		releaseTag();
+		active = false;
+	}
+
+public:
+	AgentStateSyncHandle() :
+			active(false), pool(0), raw(0), rawTags(0), rawTag(0) {
+	}
+
+	~AgentStateSyncHandle() {
+		if (active) {
+			wait();
+			clear();
+		}
+	}
+
+	/**
+	 * Gets whether this handle has an exchange in progress, that is, one that
+	 * has been begun but not finished.
+	 */
+	bool inProgress() const {
+		return active;
+	}
+
+	/**
+	 * Tests the outstanding messages of the exchange without blocking. Calling
+	 * this from time to time while doing other work allows the MPI implementation
+	 * to progress the exchange.
+	 *
+	 * @return true if all the messages have completed and finishing the
+	 * exchange will not block, otherwise false.
+	 */
+	bool test() {
+		if (!active)
+			return true;
+		bool allCompleted = true;
+		for (size_t i = 0; i < requests.size(); i++) {
+			if (!completed[i]) {
+				if (requests[i].test())
+					completed[i] = true;
+				else
+					allCompleted = false;
+			}
+		}
+		if (raw != 0) {
+			std::vector<int> stillPending;
+			for (size_t i = 0; i < rawSources.size(); i++) {
+				std::vector<Content>* content = pool->content();
+				if (raw->tryReceive(rawSources[i], *content)) {
+					received.push_back(content);
+				} else {
+					pool->release(content);
+					stillPending.push_back(rawSources[i]);
+				}
+			}
+			rawSources.swap(stillPending);
+			allCompleted = raw->testSends() && rawSources.empty() && allCompleted;
+		}
+		return allCompleted;
 	}
 
 };
@@ -236,6 +602,23 @@ public:
 		POLL, USE_CURRENT, USE_LAST_OR_POLL, USE_LAST_OR_USE_CURRENT
 	};
 
+	/**
+	 * Method used to deliver agent requests (and cancellations) to the
+	 * processes that own the requested agents.
+	 *
+	 * ALL_TO_ALL: every process sends a block padded to the largest
+	 *   request made anywhere to every other process (the original behavior).
+	 * SPARSE_COUNTS: processes exchange a single count with every other
+	 *   process and then send requests point-to-point, only to the processes
+	 *   that actually hold requested agents.
+	 * SPARSE_NBX: requests are sent point-to-point with synchronous sends and
+	 *   a non-blocking barrier marks completion (the 'non-blocking consensus'
+	 *   approach); no per-process arrays are allocated or exchanged at all.
+	 */
+	enum AGENT_REQUEST_EXCHANGE {
+		ALL_TO_ALL, SPARSE_COUNTS, SPARSE_NBX
+	};
+
 private:
 
 	typedef boost::unordered_set<AgentId, HashId> MovedAgentSetType;
@@ -261,6 +644,16 @@ private:
 	std::map<int, std::vector<AgentRequest>*> importers;
 	MovedAgentSetType movedAgents;
 
+	// local agents whose state has changed since the last state synchronization;
+	// only used when synchronizing agent states by delta
+	bool deltaAgentStateSync;
+	boost::unordered_set<AgentId, HashId> dirtyAgents;
+
+	// agent state synchronizations begun so far, which every process begins in
+	// the same order; the count picks the tag of each raw exchange
+	int stateSyncSequence;
+	std::vector<bool> stateContentTagsInUse;
+
 	// called by request agents function to initiate the request
 #ifndef SHARE_AGENTS_BY_SET
 	void initiateAgentRequest(AgentRequest& requests);
@@ -270,14 +663,46 @@ private:
 	DEFAULT_ENUM_SYMBOL);
 #endif
 
+	AGENT_REQUEST_EXCHANGE requestExchange;
+	int sparseRequestRound;
+
+	// Implementations of the agent request exchange; each takes the request
+	// made by this process and fills reqsRecd with the requests made of this process
+	void exchangeAgentRequestsAllToAll(AgentRequest& request, std::vector<AgentRequest>& reqsRecd);
+	void exchangeAgentRequestsSparseCounts(AgentRequest& request, std::vector<AgentRequest>& reqsRecd);
+	void exchangeAgentRequestsSparseNBX(AgentRequest& request, std::vector<AgentRequest>& reqsRecd);
+
 	std::vector<int>* procsToSendProjInfoTo;
 	std::vector<int>* procsToRecvProjInfoFrom;
 
 	std::vector<int>* procsToSendAgentStatusInfoTo;
 	std::vector<int>* procsToRecvAgentStatusInfoFrom;
 
+	// Graph communicators built from the cached partners above; used
+	// for the USE_LAST exchange patterns when neighborhood collectives are on.
+	// The 'checked' flags are cleared whenever the partners are recomputed.
+	bool useNeighborhoodCollectives;
+	NeighborhoodCommunicator* projInfoNeighborhood;
+	NeighborhoodCommunicator* agentStatusNeighborhood;
+	bool projInfoNeighborhoodChecked;
+	bool agentStatusNeighborhoodChecked;
+
 	std::vector<CartesianTopology*> cartesianTopologies;
 
+	// Packets and Content buffers kept between synchronizations; indexed by
+	// SyncBufferPool<Content>::index()
+	std::vector<SyncBufferPoolBase*> bufferPools;
+
+	template<typename Content>
+	SyncBufferPool<Content>& bufferPool() {
+		size_t index = SyncBufferPool<Content>::index();
+		if (index >= bufferPools.size())
+			bufferPools.resize(index + 1, 0);
+		if (bufferPools[index] == 0)
+			bufferPools[index] = new SyncBufferPool<Content>();
+		return *static_cast<SyncBufferPool<Content>*>(bufferPools[index]);
+	}
+
 protected:
 	RepastProcess(boost::mpi::communicator* comm = 0);
 
@@ -306,6 +731,17 @@ protected:
 		procsToRecvAgentStatusInfoFrom->assign(recvs.begin(), recvs.end());
 	}
 
+	// Implements synchronizeProjectionInfo; if withAgentStates is true the
+	// Content of every exported agent, in any set, is sent in the same round
+	template<typename T, typename Content, typename Provider, typename Updater,
+			typename AgentCreator>
+	void exchangeProjectionInfo(SharedContext<T>& context, Provider& provider,
+			Updater& updater, AgentCreator& creator, EXCHANGE_PATTERN exchangePattern,
+#ifdef SHARE_AGENTS_BY_SET
+			bool declareNoAgentsKeptOnAnyProcess,
+#endif
+			bool withAgentStates);
+
 public:
 
 	/**
@@ -409,6 +845,88 @@ public:
 
 	CartesianTopology* getCartesianTopology(std::vector<int> processesPerDim, bool spaceIsPeriodic);
 
+	/**
+	 * Sets the method used to deliver agent requests to other processes.
+	 * All processes must use the same method; the default is ALL_TO_ALL.
+	 *
+	 * @param exchange the method to use for subsequent agent requests
+	 */
+	void setAgentRequestExchange(AGENT_REQUEST_EXCHANGE exchange) {
+		requestExchange = exchange;
+	}
+
+	/**
+	 * Gets the method used to deliver agent requests to other processes.
+	 */
+	AGENT_REQUEST_EXCHANGE getAgentRequestExchange() const {
+		return requestExchange;
+	}
+
+	/**
+	 * Deletes the packets and buffers that are kept for reuse from one
+	 * synchronization to the next; they are created again as they are needed.
+	 * This can be used to release memory after an unusually large exchange,
+	 * but must not be called while an agent state synchronization begun with
+	 * beginSynchronizeAgentStates is in progress.
+	 */
+	void clearSyncBuffers();
+
+	/**
+	 * Sets whether synchronizeProjectionInfo and synchronizeAgentStatus use
+	 * MPI neighborhood collectives when called with USE_LAST_OR_POLL or
+	 * USE_LAST_OR_USE_CURRENT and the partner processes are already known.
+	 * The neighborhood is an MPI distributed graph communicator built from the
+	 * known partners and rebuilt only if they change. All processes must use
+	 * the same setting; the default is false.
+	 *
+	 * @param use true to use neighborhood collectives, false to use
+	 * individual sends and receives
+	 */
+	void setUseNeighborhoodCollectives(bool use) {
+		useNeighborhoodCollectives = use;
+	}
+
+	/**
+	 * Gets whether neighborhood collectives are used for the USE_LAST exchange patterns.
+	 */
+	bool getUseNeighborhoodCollectives() const {
+		return useNeighborhoodCollectives;
+	}
+
+	/**
+	 * Sets whether synchronizeAgentStates sends the state of every exported
+	 * agent (the default) or only of those that have been marked with
+	 * markAgentDirty since the last synchronization. All processes must use
+	 * the same setting.
+	 *
+	 * @param delta true to send only the state of agents marked as changed
+	 */
+	void setDeltaAgentStateSync(bool delta) {
+		deltaAgentStateSync = delta;
+		dirtyAgents.clear();
+	}
+
+	/**
+	 * Gets whether synchronizeAgentStates sends only the state of agents marked as changed.
+	 */
+	bool getDeltaAgentStateSync() const {
+		return deltaAgentStateSync;
+	}
+
+	/**
+	 * Marks the local agent with the specified id as having changed state, so
+	 * that its state is sent by the next call to synchronizeAgentStates that
+	 * includes it. This has no effect unless delta state synchronization is on.
+	 * Marks are cleared by synchronizing all agents (that is, all agent request
+	 * sets when sharing agents by set). Agents that move to this process are
+	 * marked automatically.
+	 *
+	 * @param id the id of the agent whose state has changed
+	 */
+	void markAgentDirty(const AgentId& id) {
+		if (deltaAgentStateSync)
+			dirtyAgents.insert(id);
+	}
 
 #ifdef SHARE_AGENTS_BY_SET
 	void dropImporterExporterSet(std::string setName) {
@@ -461,6 +979,50 @@ public:
 #endif
 			);
 
+	/**
+	 * Begins synchronizing the state values of shared agents and returns without
+	 * waiting for the exchange to complete. The state of the agents this process
+	 * exports is collected from the provider, and sent, before this returns, so
+	 * local agents may be modified freely afterwards; the non-local copies on this
+	 * process are not updated until finishSynchronizeAgentStates is called and
+	 * so should not be read in the meantime. This allows, for example, agents in
+	 * the interior of this process's space to be stepped while the state of the
+	 * agents on its boundary is in flight.
+	 *
+	 * Several handles may be in progress at once and finished in any order, as
+	 * long as every process begins them in the same order. When Content is sent
+	 * raw no more than AGENT_STATE_CONTENT_TAGS may be in progress at once.
+	 *
+	 * @param handle the handle that tracks the exchange; it must not already
+	 * be in progress
+	 * @param provider provides Content for a given an AgentRequest, implementing
+	 * void provideContent(const AgentRequest&, std::vector<Content>&)
+	 *
+	 * @tparam Content the serializable struct or class that describes the
+	 * state of agents
+	 *
+	 * @throws Repast_Error_66 if Content is sent raw and too many synchronizations
+	 * are already in progress
+	 */
+	template<typename Content, typename Provider>
+	void beginSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Provider& provider
+#ifdef SHARE_AGENTS_BY_SET
+			, std::string setName = REQUEST_AGENTS_ALL
+#endif
+			);
+
+	/**
+	 * Completes an agent state synchronization begun with beginSynchronizeAgentStates,
+	 * waiting for any outstanding messages and then updating the non-local agents
+	 * on this process with the updater. The handle may be reused afterwards.
+	 *
+	 * @param handle the handle passed to beginSynchronizeAgentStates
+	 * @param updater updates agents given Content, implementing
+	 * void updateAgent(const Content&)
+	 */
+	template<typename Content, typename Updater>
+	void finishSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Updater& updater);
+
 	/**
 	 * Synchronizes the Projection information for shared projections.
 	 */
@@ -496,6 +1058,30 @@ public:
 			Updater& updater, AgentCreator& creator,
 			EXCHANGE_PATTERN exchangePattern = POLL);
 
+	/**
+	 * Synchronizes agent status, projection information and agent states, with
+	 * the same result as calling synchronizeAgentStatus, synchronizeProjectionInfo
+	 * and synchronizeAgentStates (for all agents) in that order, in two rounds
+	 * of messages rather than three. Agent status is synchronized first, because
+	 * the moves it carries out determine which processes export which agents.
+	 * The projection information and the Content of every exported agent then
+	 * go to each partner process in a single message.
+	 *
+	 * @param context the SharedContext that contains the agents on this process
+	 * @param provider provides Content for a given an AgentRequest
+	 * @param updater updates an existing agent given Content
+	 * @param creator creates agents of type T given Content
+	 * @param exchangePattern the pattern used to find partner processes
+	 */
+	template<typename T, typename Content, typename Provider, typename Updater,
+			typename AgentCreator>
+	void synchronize(SharedContext<T>& context, Provider& provider, Updater& updater,
+			AgentCreator& creator, EXCHANGE_PATTERN exchangePattern = POLL
+#ifdef SHARE_AGENTS_BY_SET
+			, bool declareNoAgentsKeptOnAnyProcess = false
+#endif
+			);
+
 };
 
 /**
@@ -528,6 +1114,7 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 		, std::string setName, AGENT_IMPORTER_EXPORTER_TYPE setType
 #endif
 		) {
+	REPAST_SYNC_PROFILE(AGENT_REQUEST);
 
 	// Initiate the new requests
 #ifdef SHARE_AGENTS_BY_SET
@@ -546,9 +1133,15 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 	const std::set<int>& exporters = importer_exporter->getExportingProcesses();
 	const std::map<int, AgentRequest>& agentsToExport = importer_exporter->getAgentsToExport();
 #endif
+	REPAST_SYNC_PARTNERS(agentsToExport.size(), exporters.size());
 
 	// Construct MPI requests (Receives and Sends)
 	std::vector<boost::mpi::request> requests; // MPI Requests (receives and sends)
+	std::vector<boost::shared_ptr<boost::mpi::packed_oarchive> > archives; // Sent data
+
+	// If the Content can be sent raw it is sent apart from the rest of the packet
+	RawContentExchange<Content> rawContent(world, AGENT_REQUEST_CONTENT);
+	SyncBufferPool<Content>& pool = bufferPool<Content>();
 
 	// Construct Receives
 	std::vector<Request_Packet<Content>*> toReceive;
@@ -556,56 +1149,63 @@ void RepastProcess::requestAgents(SharedContext<T>& context,
 	for (std::set<int>::const_iterator iter = exporters.begin();
 			iter != exporters.end(); ++iter) {
 		Request_Packet<Content>* packet;
-		toReceive.push_back(packet = new Request_Packet<Content>());
+		toReceive.push_back(packet = pool.requestPacket());
 		requests.push_back(world->irecv(*iter, 23, *packet));
 	}
 
 	// Construct Sends
-	boost::ptr_list<Request_Packet<Content> >* toSend = new boost::ptr_list<
-			Request_Packet<Content> >;
+	std::vector<Request_Packet<Content>*> toSend;
 
 	for (std::map<int, AgentRequest>::const_iterator iter =
 			agentsToExport.begin(); iter != agentsToExport.end(); ++iter) {
+		Request_Packet<Content>* packet;
+		toSend.push_back(packet = pool.requestPacket());
 
 		// Agent Content
-		std::vector<Content>* content = new std::vector<Content>;
-		provider.provideContent(iter->second, *content);
+		provider.provideContent(iter->second, *packet->agentContentPtr);
 
 		// Projection Info
-		std::map<std::string, std::vector<ProjectionInfoPacket*> >* projInfo =
-				new std::map<std::string,
-						std::vector<repast::ProjectionInfoPacket*> >;
-		context.getProjectionInfo(iter->second, *projInfo);
+		context.getProjectionInfo(iter->second, *packet->projectionInfoPtr);
 
-		Request_Packet<Content>* packet;
-		toSend->push_back(
-				packet = new Request_Packet<Content>(content, projInfo));
-		requests.push_back(world->isend(iter->first, 23, *packet));
+		if (ContentTraits<Content>::isRaw)
+			rawContent.send(iter->first, *packet->agentContentPtr);
+		requests.push_back(isendSerialized(*world, iter->first, 23, *packet, archives));
 	}
 
 	// Wait until all sends/receives complete
 	boost::mpi::wait_all(requests.begin(), requests.end());
+	if (ContentTraits<Content>::isRaw) {
+		std::set<int>::const_iterator source = exporters.begin();
+		for (size_t i = 0; i < toReceive.size(); i++, ++source)
+			rawContent.receive(*source, *toReceive[i]->agentContentPtr);
+		rawContent.wait();
+	}
 
 	// Clear sent data
-	delete toSend;
+	for (size_t i = 0; i < toSend.size(); i++)
+		pool.release(toSend[i]);
 
-	// Process (and delete) received data
+	// Process (and release) received data
+	std::vector<T*> created, inContext;
 	for (typename std::vector<Request_Packet<Content>*>::iterator iter =
 			toReceive.begin(), iterEnd = toReceive.end(); iter != iterEnd;
 			++iter) {
 		std::vector<Content>* content = (*iter)->agentContentPtr;
+		created.clear();
+		inContext.clear();
 		for (typename std::vector<Content>::const_iterator contentIter =
 				content->begin(), contentIterEnd = content->end();
-				contentIter != contentIterEnd; ++contentIter) {
-			T* out = creator.createAgent(*contentIter);
-			T* inContext = context.addAgent(out);
-			if (inContext != out) { // This agent was already on this process
-				updater.updateAgent(*contentIter);
-				delete out;
+				contentIter != contentIterEnd; ++contentIter)
+			created.push_back(creator.createAgent(*contentIter));
+		context.addAgents(created.begin(), created.end(), inContext);
+		for (size_t i = 0; i < created.size(); i++) {
+			if (inContext[i] != created[i]) { // This agent was already on this process
+				updater.updateAgent((*content)[i]);
+				delete created[i];
 			}
 		}
 		context.setProjectionInfo(*((*iter)->projectionInfoPtr));
-		delete *iter;
+		pool.release(*iter);
 	}
 
 }
@@ -616,6 +1216,25 @@ void RepastProcess::synchronizeAgentStates(Provider& provider, Updater& updater
 		, std::string setName
 #endif
 		) {
+	REPAST_SYNC_PROFILE(AGENT_STATES); // Counts one call, not one for beginning and one for finishing
+	AgentStateSyncHandle<Content> handle;
+#ifdef SHARE_AGENTS_BY_SET
+	beginSynchronizeAgentStates(handle, provider, setName);
+#else
+	beginSynchronizeAgentStates(handle, provider);
+#endif
+	finishSynchronizeAgentStates(handle, updater);
+}
+
+template<typename Content, typename Provider>
+void RepastProcess::beginSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Provider& provider
+#ifdef SHARE_AGENTS_BY_SET
+		, std::string setName
+#endif
+		) {
+	REPAST_SYNC_PROFILE(AGENT_STATES);
+	if (handle.active)
+		throw Repast_Error_58(); // Agent state synchronization already in progress for this handle
 
 	// Establish which processes are sending/receiving from this one
 #ifdef SHARE_AGENTS_BY_SET
@@ -627,51 +1246,87 @@ void RepastProcess::synchronizeAgentStates(Provider& provider, Updater& updater
 	const std::set<int>& processesToReceiveFrom = importer_exporter->getExportingProcesses();
 	const std::map<int, AgentRequest>& agentsToExport = importer_exporter->getAgentsToExport();
 #endif
-
-	// Construct MPI Requests (sends and receives)
-	std::vector<boost::mpi::request> requests;
+	REPAST_SYNC_PARTNERS(agentsToExport.size(), processesToReceiveFrom.size());
+
+	int tag = AGENT_STATE_CONTENT + stateSyncSequence++ % AGENT_STATE_CONTENT_TAGS;
+	if (ContentTraits<Content>::isRaw) {
+		if (stateContentTagsInUse[tag - AGENT_STATE_CONTENT])
+			throw Repast_Error_66(AGENT_STATE_CONTENT_TAGS); // Too many agent state synchronizations in progress
+		stateContentTagsInUse[tag - AGENT_STATE_CONTENT] = true;
+		handle.rawTags = &stateContentTagsInUse;
+		handle.rawTag = tag;
+		handle.raw = new RawContentExchange<Content>(world, tag);
+	}
+	handle.active = true;
+	handle.pool = &bufferPool<Content>();
 
 	// Construct Receives
-	std::vector<std::vector<Content>*> received;
+	std::vector<Content>* content;
 	for (std::set<int>::const_iterator iter = processesToReceiveFrom.begin(),
 			iterEnd = processesToReceiveFrom.end(); iter != iterEnd; ++iter) {
-		std::vector<Content>* content = new std::vector<Content>();
-		requests.push_back(world->irecv(*iter, 47, *content));
-		received.push_back(content);
+		if (handle.raw != 0) {
+			handle.rawSources.push_back(*iter);
+		} else {
+			handle.received.push_back(content = handle.pool->content());
+			handle.add(world->irecv(*iter, 47, *content));
+		}
 	}
 
-	// Construct Sends
-	boost::ptr_list<std::vector<Content> >* toSend = new boost::ptr_list<
-			std::vector<Content> >;
-	std::vector<Content>* content;
-
+	// Construct Sends; in delta mode, a process that is sent no agents
+	// still gets an (empty) message because it is expecting one
 	for (std::map<int, AgentRequest>::const_iterator iter =
 			agentsToExport.begin(), iterEnd = agentsToExport.end();
 			iter != iterEnd; ++iter) {
-		toSend->push_back(content = new std::vector<Content>);
-		provider.provideContent(iter->second, *content);
-		requests.push_back(world->isend(iter->first, 47, *content));
+		handle.sent.push_back(content = handle.pool->content());
+		if (deltaAgentStateSync) {
+			AgentRequest changed(iter->second.sourceProcess(), iter->second.targetProcess());
+			const std::vector<AgentId>& ids = iter->second.requestedAgents();
+			for (size_t i = 0; i < ids.size(); i++) {
+				if (dirtyAgents.find(ids[i]) != dirtyAgents.end())
+					changed.addRequest(ids[i]);
+			}
+			if (changed.requestCount() > 0)
+				provider.provideContent(changed, *content);
+		} else {
+			provider.provideContent(iter->second, *content);
+		}
+		if (handle.raw != 0) {
+			handle.raw->send(iter->first, *content);
+		} else {
+			handle.add(isendSerialized(*world, iter->first, 47, *content, handle.archives));
+		}
 	}
 
-	// Wait until all sends and receives are complete
-	boost::mpi::wait_all(requests.begin(), requests.end());
+	bool allAgentsSynchronized = true;
+#ifdef SHARE_AGENTS_BY_SET
+	allAgentsSynchronized = (setName == REQUEST_AGENTS_ALL);
+#endif
+	if (allAgentsSynchronized)
+		dirtyAgents.clear();
+}
 
-	// Clear sent data
-	delete toSend;
+template<typename Content, typename Updater>
+void RepastProcess::finishSynchronizeAgentStates(AgentStateSyncHandle<Content>& handle, Updater& updater) {
+	REPAST_SYNC_PROFILE(AGENT_STATES);
+	if (!handle.active)
+		throw Repast_Error_59(); // Agent state synchronization not in progress for this handle
 
-	// Process (and clear) received data
-	for (typename std::vector<std::vector<Content>*>::iterator iter =
-			received.begin(), iterEnd = received.end(); iter != iterEnd;
+	// Wait until all sends and receives are complete
+	handle.wait();
+
+	// Process received data
+	for (typename std::vector<std::vector<Content>*>::const_iterator iter =
+			handle.received.begin(), iterEnd = handle.received.end(); iter != iterEnd;
 			++iter) {
-		content = *iter;
 		for (typename std::vector<Content>::const_iterator agentIter =
-				content->begin(), agentIterEnd = content->end();
+				(*iter)->begin(), agentIterEnd = (*iter)->end();
 				agentIter != agentIterEnd; ++agentIter) {
 			updater.updateAgent(*agentIter);
 		}
-		delete content;
 	}
 
+	// Return the sent and received data to the pool
+	handle.clear();
 }
 
 template<typename T, typename Content, typename Provider, typename Updater,
@@ -683,9 +1338,47 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 		, bool declareNoAgentsKeptOnAnyProcess
 #endif
 		) {
+#ifdef SHARE_AGENTS_BY_SET
+	exchangeProjectionInfo<T, Content>(context, provider, updater, creator, exchangePattern,
+			declareNoAgentsKeptOnAnyProcess, false);
+#else
+	exchangeProjectionInfo<T, Content>(context, provider, updater, creator, exchangePattern, false);
+#endif
+}
+
+template<typename T, typename Content, typename Provider, typename Updater,
+		typename AgentCreator>
+void RepastProcess::synchronize(SharedContext<T>& context, Provider& provider,
+		Updater& updater, AgentCreator& creator, EXCHANGE_PATTERN exchangePattern
+#ifdef SHARE_AGENTS_BY_SET
+		, bool declareNoAgentsKeptOnAnyProcess
+#endif
+		) {
+	synchronizeAgentStatus<T, Content>(context, provider, updater, creator, exchangePattern);
+#ifdef SHARE_AGENTS_BY_SET
+	exchangeProjectionInfo<T, Content>(context, provider, updater, creator, exchangePattern,
+			declareNoAgentsKeptOnAnyProcess, true);
+#else
+	exchangeProjectionInfo<T, Content>(context, provider, updater, creator, exchangePattern, true);
+#endif
+
+	// Every exported agent has been sent
+	dirtyAgents.clear();
+}
+
+template<typename T, typename Content, typename Provider, typename Updater,
+		typename AgentCreator>
+void RepastProcess::exchangeProjectionInfo(SharedContext<T>& context,
+		Provider& provider, Updater& updater, AgentCreator& creator,
+		EXCHANGE_PATTERN exchangePattern,
+#ifdef SHARE_AGENTS_BY_SET
+		bool declareNoAgentsKeptOnAnyProcess,
+#endif
+		bool withAgentStates) {
+	REPAST_SYNC_PROFILE(PROJECTION_INFO);
 
 	// Generate sets of agents to delete or not delete
-	std::set<AgentId> agentsToKeep;
+	AgentIdSet agentsToKeep;
 
 	bool agentsMayBeKept =
 #ifdef SHARE_AGENTS_BY_SET
@@ -708,11 +1401,11 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 #endif
 
 	// Determine all agents that the context doesn't need and are not on 'Keep' list, adding those that it needs to the 'Keep' list
-	std::set<AgentId> agentsToDrop;
+	AgentIdSet agentsToDrop;
 	context.getNonlocalAgentsToDrop(agentsToKeep, agentsToDrop);
 
 	// Drop all of the agents that can be dropped
-	std::set<AgentId>::iterator dropIter = agentsToDrop.begin(), dropIterEnd =
+	AgentIdSet::const_iterator dropIter = agentsToDrop.begin(), dropIterEnd =
 			agentsToDrop.end();
 	while (dropIter != dropIterEnd) {
 		context.removeAgent(*dropIter);
@@ -726,7 +1419,7 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 	// Initiate Agent Request (so that I/E will have agents needed by other processes)
 	if (agentsMayBeKept) {
 		AgentRequest req;
-		for (std::set<AgentId>::iterator iter = agentsToKeep.begin(), iterEnd =
+		for (AgentIdSet::const_iterator iter = agentsToKeep.begin(), iterEnd =
 				agentsToKeep.end(); iter != iterEnd; ++iter) {
 			req.addRequest(*iter); // TO DO: Better optimized constructor
 		}
@@ -734,16 +1427,16 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 	}
 
 	// Determine which agents will be 'pushed' to other processes
-	std::map<int, std::set<AgentId> > agentsToPush;
+	std::map<int, AgentIdSet> agentsToPush;
 	context.getAgentsToPushToOtherProcesses(agentsToPush);
 
 	// Add these to I/E as exports
 	std::vector<AgentRequest> requests;
-	for (std::map<int, std::set<AgentId> >::iterator iter =
+	for (std::map<int, AgentIdSet>::iterator iter =
 			agentsToPush.begin(), iterEnd = agentsToPush.end(); iter != iterEnd;
 			++iter) {
 		AgentRequest req(iter->first);
-		for (std::set<AgentId>::iterator i = iter->second.begin(), iEnd =
+		for (AgentIdSet::const_iterator i = iter->second.begin(), iEnd =
 				iter->second.end(); i != iEnd; i++)
 			req.addRequest(*i);
 		requests.push_back(req);
@@ -767,11 +1460,44 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 
 	std::map<int, AgentRequest> agentsToExport = tmpAgentsToExport; // Copy?
 
+	// Agents exported other than for projections (in other sets) whose Content
+	// synchronizeAgentStates would send; it goes with the projection information
+	std::map<int, AgentRequest> statesToExport;
+	if (withAgentStates) {
+#ifdef SHARE_AGENTS_BY_SET
+		const std::map<int, AgentRequest>& allExports = importer_exporter->getAgentsToExport(REQUEST_AGENTS_ALL);
+#else
+		const std::map<int, AgentRequest>& allExports = importer_exporter->getAgentsToExport();
+#endif
+		for (std::map<int, AgentRequest>::const_iterator iter = allExports.begin(), iterEnd = allExports.end();
+				iter != iterEnd; ++iter) {
+			int dest = iter->first;
+			boost::unordered_set<AgentId, HashId> sent;
+			std::map<int, AgentRequest>::iterator exported = agentsToExport.find(dest);
+			if (exported == agentsToExport.end()) {
+				AgentRequest dummy(rank_, dest);
+				agentsToExport[dest] = dummy;
+			} else {
+				sent.insert(exported->second.requestedAgents().begin(), exported->second.requestedAgents().end());
+			}
+			AgentRequest& states = statesToExport.insert(std::make_pair(dest, AgentRequest(rank_, dest))).first->second;
+			const std::vector<AgentId>& ids = iter->second.requestedAgents();
+			for (size_t i = 0; i < ids.size(); i++) {
+				if (sent.find(ids[i]) == sent.end()
+						&& (!deltaAgentStateSync || dirtyAgents.find(ids[i]) != dirtyAgents.end()))
+					states.addRequest(ids[i]);
+			}
+		}
+	}
+
 	std::vector<int> psToSendTo;
 	std::vector<int> psToReceiveFrom;
+	bool useNeighborhood = false;
+	bool polled = false;
 	if (exchangePattern == USE_CURRENT
 			|| ((exchangePattern == USE_LAST_OR_USE_CURRENT)
 					&& (procsToSendProjInfoTo == NULL))) {
+		projInfoNeighborhoodChecked = false;
 		std::set<int> sends, recvs;
 		context.getProjInfoExchangePartners(sends, recvs);
 		psToSendTo.assign(sends.begin(), sends.end());
@@ -788,6 +1514,8 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 	} else if (exchangePattern == POLL
 			|| ((exchangePattern == USE_LAST_OR_POLL)
 					&& (procsToSendProjInfoTo == NULL))) {
+		projInfoNeighborhoodChecked = false;
+		polled = true;
 		for (std::map<int, AgentRequest>::const_iterator iter =
 				agentsToExport.begin(), iterEnd = agentsToExport.end();
 				iter != iterEnd; ++iter) {
@@ -797,6 +1525,7 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 		manager.retrieveSources(psToSendTo, psToReceiveFrom,
 				AGENT_MOVED_SENDERS);
 	} else {
+		useNeighborhood = useNeighborhoodCollectives;
 		psToSendTo.assign(procsToSendProjInfoTo->begin(),
 				procsToSendProjInfoTo->end());
 		psToReceiveFrom.assign(procsToRecvProjInfoFrom->begin(),
@@ -815,22 +1544,57 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 
 	saveProjInfoSRProcs(psToSendTo, psToReceiveFrom);
 
+	// Every process this one exports to is sent a message. Polling finds all
+	// of them, but the projection partners may not include the processes that
+	// export agents kept without a projection needing them, or (with agent
+	// states) agents in other sets, so these are added
+	if (!polled) {
+		std::set<int> sends(psToSendTo.begin(), psToSendTo.end());
+		std::set<int> recvs(psToReceiveFrom.begin(), psToReceiveFrom.end());
+		for (std::map<int, AgentRequest>::const_iterator iter = agentsToExport.begin(),
+				iterEnd = agentsToExport.end(); iter != iterEnd; ++iter)
+			sends.insert(iter->first);
+#ifdef SHARE_AGENTS_BY_SET
+		const std::set<int>& exporting = importer_exporter->getExportingProcesses(
+				withAgentStates ? REQUEST_AGENTS_ALL : DEFAULT_AGENT_REQUEST_SET);
+#else
+		const std::set<int>& exporting = importer_exporter->getExportingProcesses();
+#endif
+		recvs.insert(exporting.begin(), exporting.end());
+		psToSendTo.assign(sends.begin(), sends.end());
+		psToReceiveFrom.assign(recvs.begin(), recvs.end());
+	}
+	REPAST_SYNC_PARTNERS(agentsToExport.size(), psToReceiveFrom.size());
+
+	if (useNeighborhood && !projInfoNeighborhoodChecked) {
+		if (projInfoNeighborhood == NULL)
+			projInfoNeighborhood = new NeighborhoodCommunicator(world);
+		projInfoNeighborhood->update(psToSendTo, psToReceiveFrom);
+		projInfoNeighborhoodChecked = true;
+	}
+
 	// Construct MPI requests (Receives and Sends)
 	std::vector<boost::mpi::request> MPIRequests; // MPI Requests (receives and sends)
+	std::vector<boost::shared_ptr<boost::mpi::packed_oarchive> > archives; // Sent data
 
-	// Construct Receives
+	// If the Content can be sent raw it is sent apart from the rest of the packet
+	RawContentExchange<Content> rawContent(world, PROJECTION_INFO_CONTENT);
+	SyncBufferPool<Content>& pool = bufferPool<Content>();
+
+	// Construct Receives; the neighborhood exchange receives into the same packets
 	std::map<int, Request_Packet<Content>*> toReceive;
 
 	for (std::vector<int>::iterator iter = psToReceiveFrom.begin(), iterEnd =
 			psToReceiveFrom.end(); iter != iterEnd; ++iter) {
 		Request_Packet<Content>* packet;
-		toReceive[*iter] = (packet = new Request_Packet<Content>());
-		MPIRequests.push_back(world->irecv(*iter, 23, *packet));
+		toReceive[*iter] = (packet = pool.requestPacket());
+		if (!useNeighborhood)
+			MPIRequests.push_back(world->irecv(*iter, 23, *packet));
 	}
 
 	// Construct Sends
-	boost::ptr_list<Request_Packet<Content> >* toSend = new boost::ptr_list<
-			Request_Packet<Content> >;
+	std::vector<Request_Packet<Content>*> toSend;
+	std::map<int, Request_Packet<Content>*> outgoing; // Only used for the neighborhood exchange
 
 	for (std::map<int, AgentRequest>::const_iterator iter =
 			agentsToExport.begin(), iterEnd = agentsToExport.end();
@@ -838,50 +1602,72 @@ void RepastProcess::synchronizeProjectionInfo(SharedContext<T>& context,
 		int dest = iter->first;
 		const AgentRequest& rq = iter->second;
 
+		Request_Packet<Content>* packet;
+		toSend.push_back(packet = pool.requestPacket());
+
 		// Agent Content
-		std::vector<Content>* contentVector = new std::vector<Content>;
-		provider.provideContent(rq, *contentVector);
+		provider.provideContent(rq, *packet->agentContentPtr);
+		if (withAgentStates) {
+			std::map<int, AgentRequest>::const_iterator states = statesToExport.find(dest);
+			if (states != statesToExport.end() && states->second.requestCount() > 0)
+				provider.provideContent(states->second, *packet->agentContentPtr);
+		}
 
 		// Projection Info
-		std::map<std::string, std::vector<ProjectionInfoPacket*> >* projInfo =
-				new std::map<std::string,
-						std::vector<repast::ProjectionInfoPacket*> >;
-		context.getProjectionInfo(rq, *projInfo, true, 0, dest); // Will collect the edges but not the secondary IDs
+		context.getProjectionInfo(rq, *packet->projectionInfoPtr, true, 0, dest); // Will collect the edges but not the secondary IDs
 
-		Request_Packet<Content>* packet;
-		toSend->push_back(
-				packet = new Request_Packet<Content>(contentVector, projInfo));
-		MPIRequests.push_back(world->isend(dest, 23, *packet));
+		if (ContentTraits<Content>::isRaw)
+			rawContent.send(dest, *packet->agentContentPtr);
+		if (useNeighborhood) {
+			outgoing[dest] = packet;
+		} else {
+			MPIRequests.push_back(isendSerialized(*world, dest, 23, *packet, archives));
+		}
 	}
 
-	// Wait until all sends/receives complete
-	boost::mpi::wait_all(MPIRequests.begin(), MPIRequests.end());
+	if (useNeighborhood) {
+		projInfoNeighborhood->exchange(outgoing, toReceive);
+	} else {
+		// Wait until all sends/receives complete
+		boost::mpi::wait_all(MPIRequests.begin(), MPIRequests.end());
+	}
+	if (ContentTraits<Content>::isRaw) {
+		for (typename std::map<int, Request_Packet<Content>*>::iterator iter =
+				toReceive.begin(), iterEnd = toReceive.end(); iter != iterEnd; ++iter)
+			rawContent.receive(iter->first, *iter->second->agentContentPtr);
+		rawContent.wait();
+	}
 
 	// Clear sent data
-	delete toSend;
+	for (size_t i = 0; i < toSend.size(); i++)
+		pool.release(toSend[i]);
 
 	// Process received data (and clear)
+	std::vector<T*> created, inContext;
 	for (typename std::map<int, Request_Packet<Content>*>::iterator iter =
 			toReceive.begin(), iterEnd = toReceive.end(); iter != iterEnd;
 			++iter) {
 		std::vector<Content>* contentVector = iter->second->agentContentPtr;
 		AgentRequest requestToRegister(iter->first);
+		created.clear();
+		inContext.clear();
 		for (typename std::vector<Content>::const_iterator contentIter =
 				contentVector->begin(), contentIterEnd = contentVector->end();
-				contentIter != contentIterEnd; ++contentIter) {
-			T* newAgent = creator.createAgent(*contentIter);
-			T* agentInContext = context.addAgent(newAgent);
-			if (agentInContext != newAgent) { // This agent was already on this process
-				updater.updateAgent(*contentIter);
-				delete newAgent;
+				contentIter != contentIterEnd; ++contentIter)
+			created.push_back(creator.createAgent(*contentIter));
+		context.addAgents(created.begin(), created.end(), inContext);
+		for (size_t i = 0; i < created.size(); i++) {
+			if (inContext[i] != created[i]) { // This agent was already on this process
+				updater.updateAgent((*contentVector)[i]);
+				delete created[i];
 			} else {
 				// Add the agent to the agent request that will be processed as if it were an OUTGOING request
-				requestToRegister.addRequest(agentInContext->getId());
+				requestToRegister.addRequest(created[i]->getId());
 			}
 		}
 
 		context.setProjectionInfo(*(iter->second->projectionInfoPtr));
-		delete iter->second;
+		pool.release(iter->second);
 		// Register these as requests, so that the importer/exporter will know these agents will be sent
 		importer_exporter->registerOutgoingRequests(requestToRegister);
 	}
@@ -892,6 +1678,7 @@ template<typename T, typename Content, typename Provider, typename AgentCreator,
 void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 		Provider& provider, Updater& updater, AgentCreator& creator,
 		EXCHANGE_PATTERN exchangePattern) {
+	REPAST_SYNC_PROFILE(AGENT_STATUS);
 
 	// Step 1: Exchange information about agents whose status will be updated.
 	//
@@ -924,7 +1711,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 				T* agent = context.getAgent(status.getOldId());
 				if (agent == (void*) 0)
 					throw Repast_Error_32<AgentId>(status.getOldId()); // Agent not found
-				agent->getId().currentRank(status.getNewId().currentRank());
+				context.updateAgentRank(agent, status.getNewId().currentRank());
 			}
 		}
 		delete vec;
@@ -933,7 +1720,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	// Step 2: Send moving agents' information to new home processes
 	//
 	// First, some basic data structures must be created for some bookkeeping we will need later
-	std::set<AgentId> agentsToDrop; // A list of agents that will be removed from this process
+	AgentIdSet agentsToDrop; // A list of agents that will be removed from this process
 	std::set<int> psMovedTo; // A list of the processes that will be receiving moving agents
 	std::map<int, AgentRequest> agentRequests; // A map of these receiving processes and a list of the IDs of the agents going to them
 
@@ -944,7 +1731,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	for (MovedAgentSetType::const_iterator iter = movedAgents.begin(), iterEnd =
 			movedAgents.end(); iter != iterEnd; ++iter) {
 		AgentId id = *iter;
-		context.getAgent(id)->getId().currentRank(id.currentRank());
+		context.updateAgentRank(context.getAgent(id), id.currentRank());
 		agentsToDrop.insert(id);
 		int currentProc = id.currentRank();
 		if (psMovedTo.insert(currentProc).second) {
@@ -974,10 +1761,12 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	// unchanged.
 	std::vector<int> psToSendTo;        // Convert set to vector
 	std::vector<int> psToReceiveFrom;
+	bool useNeighborhood = false;
 
 	if (exchangePattern == USE_CURRENT
 			|| ((exchangePattern == USE_LAST_OR_USE_CURRENT)
 					&& (procsToSendAgentStatusInfoTo == NULL))) {
+		agentStatusNeighborhoodChecked = false;
 		std::set<int> sends, recvs;
 		context.getAgentStatusInfoExchangePartners(sends, recvs);
 		psToSendTo.assign(sends.begin(), sends.end());
@@ -994,6 +1783,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	} else if (exchangePattern == POLL
 			|| ((exchangePattern == USE_LAST_OR_POLL)
 					&& (procsToSendAgentStatusInfoTo == NULL))) {
+		agentStatusNeighborhoodChecked = false;
 		for (std::map<int, AgentRequest>::const_iterator iter =
 				agentRequests.begin(), iterEnd = agentRequests.end();
 				iter != iterEnd; ++iter) {
@@ -1003,6 +1793,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 		manager.retrieveSources(psToSendTo, psToReceiveFrom,
 				AGENT_MOVED_SENDERS);
 	} else {
+		useNeighborhood = useNeighborhoodCollectives;
 		psToSendTo.assign(procsToSendAgentStatusInfoTo->begin(),
 				procsToSendAgentStatusInfoTo->end());
 		psToReceiveFrom.assign(procsToRecvAgentStatusInfoFrom->begin(),
@@ -1020,44 +1811,64 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	}
 
 	saveAgentStatusInfoSRProcs(psToSendTo, psToReceiveFrom);
+	REPAST_SYNC_PARTNERS(psToSendTo.size(), psToReceiveFrom.size());
+
+	if (useNeighborhood && !agentStatusNeighborhoodChecked) {
+		if (agentStatusNeighborhood == NULL)
+			agentStatusNeighborhood = new NeighborhoodCommunicator(world);
+		agentStatusNeighborhood->update(psToSendTo, psToReceiveFrom);
+		agentStatusNeighborhoodChecked = true;
+	}
 
 	// Determine if any projection in the context will need to send 'secondary' agent data:
 	bool sendSecondaryData = context.sendsSecondaryDataOnStatusExchange();
 
 	// Create MPI Sends and Receives
 	std::vector<boost::mpi::request> requests;
+	std::vector<boost::shared_ptr<boost::mpi::packed_oarchive> > archives; // Sent data
+
+	// If the Content can be sent raw it is sent apart from the rest of the packet
+	RawContentExchange<Content> rawContent(world, AGENT_MOVED_CONTENT);
+	SyncBufferPool<Content>& pool = bufferPool<Content>();
 
 	// STEP 5: Create the receives
 	std::vector<SyncStatus_Packet<Content>*> packetsRecd;
+	std::vector<int> packetSources;
+	std::map<int, SyncStatus_Packet<Content>*> incoming; // Only used for the neighborhood exchange
 
 	for (std::vector<int>::const_iterator iter = psToReceiveFrom.begin();
 			iter != psToReceiveFrom.end(); ++iter) {
 		int source = *iter;
-		SyncStatus_Packet<Content>* packetToRecv =
-				new SyncStatus_Packet<Content>;
-		requests.push_back(
-				world->irecv(source, AGENT_MOVED_AGENT, *packetToRecv));
-		packetsRecd.push_back(packetToRecv);
+		SyncStatus_Packet<Content>* packetToRecv = pool.syncStatusPacket();
+		if (useNeighborhood) {
+			incoming[source] = packetToRecv;
+		} else {
+			requests.push_back(
+					world->irecv(source, AGENT_MOVED_AGENT, *packetToRecv));
+			packetsRecd.push_back(packetToRecv);
+			packetSources.push_back(source);
+		}
 	}
 
 	// STEP 6: Assemble data to send
-	boost::ptr_list<SyncStatus_Packet<Content> >* packetsToSend =
-			new boost::ptr_list<SyncStatus_Packet<Content> >;
+	std::vector<SyncStatus_Packet<Content>*> packetsToSend;
+	std::map<int, SyncStatus_Packet<Content>*> outgoing; // Only used for the neighborhood exchange
 
 	for (std::map<int, repast::AgentRequest>::iterator iter =
 			agentRequests.begin(); iter != agentRequests.end(); ++iter) {
+		SyncStatus_Packet<Content>* packetToSend;
+		packetsToSend.push_back(packetToSend = pool.syncStatusPacket());
+
 		// Agent Content
-		std::vector<Content>* content = new std::vector<Content>;
+		std::vector<Content>* content = packetToSend->agentContentPtr;
 		provider.provideContent(iter->second, *content);
 
 		// Projection Info and Secondary Ids
-		std::map<std::string, std::vector<ProjectionInfoPacket*> >* projInfo =
-				new std::map<std::string,
-						std::vector<repast::ProjectionInfoPacket*> >;
 		std::set<AgentId>* secondaryIds = (
 				sendSecondaryData ? new std::set<AgentId> : 0);
-		context.getProjectionInfo(iter->second, *projInfo, sendSecondaryData,
+		context.getProjectionInfo(iter->second, *packetToSend->projectionInfoPtr, sendSecondaryData,
 				secondaryIds);
+		packetToSend->secondaryIdsPtr = secondaryIds;
 
 		// Send the information for the secondary agents, too:
 		if (secondaryIds != 0) { // use 'sendSecondaryData' instead? Should be equivalent...
@@ -1070,28 +1881,44 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 		}
 
 		// Agent Exporter Info
-		AgentExporterInfo* agentImporterInfoPtr =
-				importer_exporter->getAgentExportInfo(iter->first);
+		packetToSend->exporterInfoPtr = importer_exporter->getAgentExportInfo(iter->first);
 
-		SyncStatus_Packet<Content>* packetToSend;
-		packetsToSend->push_back(
-				packetToSend = new SyncStatus_Packet<Content>(content, projInfo,
-						secondaryIds, agentImporterInfoPtr));
+		if (ContentTraits<Content>::isRaw)
+			rawContent.send(iter->first, *content);
 
-		requests.push_back(
-				world->isend(iter->first, AGENT_MOVED_AGENT, *packetToSend));
+		if (useNeighborhood) {
+			outgoing[iter->first] = packetToSend;
+		} else {
+			requests.push_back(
+					isendSerialized(*world, iter->first, AGENT_MOVED_AGENT, *packetToSend, archives));
+		}
 	}
-	boost::mpi::wait_all(requests.begin(), requests.end());
-	delete packetsToSend;
+	if (useNeighborhood) {
+		agentStatusNeighborhood->exchange(outgoing, incoming);
+		for (typename std::map<int, SyncStatus_Packet<Content>*>::iterator iter =
+				incoming.begin(), iterEnd = incoming.end(); iter != iterEnd; ++iter) {
+			packetsRecd.push_back(iter->second);
+			packetSources.push_back(iter->first);
+		}
+	} else {
+		boost::mpi::wait_all(requests.begin(), requests.end());
+	}
+	if (ContentTraits<Content>::isRaw) {
+		for (size_t i = 0; i < packetsRecd.size(); i++)
+			rawContent.receive(packetSources[i], *packetsRecd[i]->agentContentPtr);
+		rawContent.wait();
+	}
+	for (size_t i = 0; i < packetsToSend.size(); i++)
+		pool.release(packetsToSend[i]); // The exporter info sent belongs to the importer/exporter
 
 	importer_exporter->clearAgentExportInfo();
 
 	// STEP 9: Remove the agents that are moving to other processes and are not needed here
-	std::set<AgentId> agentsToKeep;
+	AgentIdSet agentsToKeep;
 	context.getRequiredAgents(agentsToDrop, agentsToKeep,
 			Projection<T>::SECONDARY);
 
-	for (std::set<AgentId>::iterator idIter = agentsToDrop.begin(), idIterEnd =
+	for (AgentIdSet::const_iterator idIter = agentsToDrop.begin(), idIterEnd =
 			agentsToDrop.end(); idIter != idIterEnd; ++idIter)
 		context.removeAgent(*idIter);
 
@@ -1100,24 +1927,29 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	typename std::vector<SyncStatus_Packet<Content>*>::iterator packetIterEnd =
 			packetsRecd.end();
 	AgentRequest secondaryAgentsToRequest(rank_);
+	std::vector<T*> created, inContext;
 	for (packetIter = packetsRecd.begin(); packetIter != packetIterEnd;
 			++packetIter) {
 		std::vector<Content>* content = (*packetIter)->agentContentPtr;
-		typename std::vector<Content>::iterator contentIter = content->begin();
-		while (contentIter != content->end()) {
-			T* out = creator.createAgent(*contentIter);
-			T* inContext = context.addAgent(out);
-			if (inContext != out) { // Already contain the agent
+		created.clear();
+		inContext.clear();
+		for (typename std::vector<Content>::iterator contentIter = content->begin(); contentIter != content->end(); ++contentIter)
+			created.push_back(creator.createAgent(*contentIter));
+		context.addAgents(created.begin(), created.end(), inContext);
+		for (size_t i = 0; i < created.size(); i++) {
+			T* out = created[i];
+			if (inContext[i] != out) { // Already contain the agent
 				// If the agent is local on this rank, do nothing (the agent received must be a secondary agent)
 				// If the agent is non-local on this rank
-				if (inContext->getId().currentRank() != rank_) {
+				if (inContext[i]->getId().currentRank() != rank_) {
 					// If the arriving agent has a current rank equal to this rank, this
 					// is an incoming, newly arrived local agent that already existed on this
 					// process as a secondary agent; it should be updated and its currentRank in
 					// its ID set to the local rank
 					if (out->getId().currentRank() == rank_) {
-						updater.updateAgent(*contentIter);
-						inContext->getId().currentRank(rank_);
+						updater.updateAgent((*content)[i]);
+						context.updateAgentRank(inContext[i], rank_);
+						markAgentDirty(inContext[i]->getId()); // Copies elsewhere were exported from its old process
 					}
 					// Otherwise, it's a secondary agent arriving from another process, when it
 					// already exists as a non-local agent on this process; leave the original alone
@@ -1127,8 +1959,9 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 			} else { // Agent was not already on this rank and is not a new local agent; must process it as a new request
 				if (out->getId().currentRank() != rank_)
 					secondaryAgentsToRequest.addRequest(out->getId());
+				else
+					markAgentDirty(out->getId()); // Copies elsewhere were exported from its old process
 			}
-			contentIter++;
 		}
 
 		// Update the importer/exporter to reflect the newly arrived local agents
@@ -1146,7 +1979,7 @@ void RepastProcess::synchronizeAgentStatus(SharedContext<T>& context,
 	for (packetIter = packetsRecd.begin(); packetIter != packetIterEnd;
 			++packetIter) {
 		context.setProjectionInfo(*((*packetIter)->projectionInfoPtr));
-		delete (*packetIter)->deleteExporterInfo(); // Exporter Info is only deleted from the received packets, not the sent ones...
+		pool.release((*packetIter)->deleteExporterInfo()); // Exporter Info is only deleted from the received packets, not the sent ones...
 	}
 
 }
@@ -38,6 +38,7 @@
  */
 
 #include "SRManager.h"
+#include "SyncProfiler.h"
 
 #include <boost/mpi.hpp>
 
@@ -84,6 +85,9 @@ void SRManager::clear(){
 }
 
 void SRManager::retrieveSources(){
+  REPAST_SYNC_PROFILE(RETRIEVE_SOURCES);
+  REPAST_SYNC_PARTNERS(_comm->size() - 1, _comm->size() - 1);
+  REPAST_SYNC_SENT(_comm->size() - 1, (_comm->size() - 1) * sizeof(int));
   MPI_Alltoall(send, 1, MPI_INT, recv, 1, MPI_INT, (*_comm));
 }
 
@@ -41,28 +41,62 @@
 #include "Schedule.h"
 #include "Utilities.h"
 #include "logger.h"
+#include "RepastErrors.h"
+#include "ScheduleProfiler.h"
+#include "NodePool.h"
 
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 #include <boost/mpi.hpp>
 #include <boost/lexical_cast.hpp>
 
+#ifdef REPAST_SCHEDULE_THREADS
+#include <boost/bind/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/exception_ptr.hpp>
+#endif
+
 namespace repast {
 
 RepastEvent::~RepastEvent() {
 //std::cout << func_ptr.use_count() << std::endl;
 }
 
+void* RepastEvent::operator new(size_t size) {
+	return poolAllocate(size);
+}
+
+void RepastEvent::operator delete(void* ptr, size_t size) {
+	poolRelease(ptr, size);
+}
+
 Functor::~Functor() {
 }
 
 ScheduledEvent::ScheduledEvent(double at, RepastEvent *evt) :
-	event(evt), start(at) {
+	event(evt), start(at), parallelGroup(0), label(0) {
+}
+
+const std::string& ScheduledEvent::getLabel() const {
+	static const std::string NO_LABEL;
+	return label == 0 ? NO_LABEL : *label;
 }
 
 ScheduledEvent::~ScheduledEvent() {
 	delete event;
 }
 
+void* ScheduledEvent::operator new(size_t size) {
+	return poolAllocate(size);
+}
+
+void ScheduledEvent::operator delete(void* ptr, size_t size) {
+	poolRelease(ptr, size);
+}
+
 OneTimeEvent::OneTimeEvent(double at, RepastEvent *evt) :
 	ScheduledEvent(at, evt) {
 }
@@ -71,7 +105,7 @@ OneTimeEvent::~OneTimeEvent() {
 }
 
 // does nothing as its a one time event
-bool OneTimeEvent::reschedule(std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare>& queue) {
+bool OneTimeEvent::reschedule(EventQueue& queue) {
 	return false;
 }
 
@@ -82,20 +116,296 @@ RepeatingEvent::RepeatingEvent(double start, double _interval, RepastEvent *evt)
 RepeatingEvent::~RepeatingEvent() {
 }
 
-bool RepeatingEvent::reschedule(
-		std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare>& queue) {
+bool RepeatingEvent::reschedule(EventQueue& queue) {
 	event->tick += interval;
 	queue.push(this);
 	return true;
 }
 
+EventQueue::~EventQueue() {
+}
+
+HeapEventQueue::~HeapEventQueue() {
+}
+
+CalendarEventQueue::CalendarEventQueue(size_t bucketCount) :
+	mask(0), base(0), front(0), ringCount(0), order(0) {
+	size_t count = 1;
+	while (count < bucketCount)
+		count <<= 1;
+	buckets.resize(count);
+	mask = count - 1;
+}
+
+CalendarEventQueue::~CalendarEventQueue() {
+}
+
+void CalendarEventQueue::insert(const Entry& entry) {
+	long index = (long) std::floor(entry.tick);
+	Bucket& b = bucket(index);
+	if (b.empty()) {
+		b.events.clear();
+		b.head = 0;
+	}
+	if (b.empty() || !(entry < b.events.back())) {
+		b.events.push_back(entry);
+	} else {
+		b.events.insert(std::upper_bound(b.events.begin() + b.head, b.events.end(), entry), entry);
+	}
+	if (ringCount == 0 || index < front) front = index;
+	ringCount++;
+}
+
+void CalendarEventQueue::push(ScheduledEvent* evt) {
+	Entry entry;
+	entry.tick = evt->get_event()->tick;
+	entry.order = order++;
+	entry.evt = evt;
+	if (inWindow(entry.tick))
+		insert(entry);
+	else
+		overflow.push(entry);
+}
+
+const CalendarEventQueue::Bucket* CalendarEventQueue::frontBucket() const {
+	if (ringCount == 0) return 0;
+	while (bucket(front).empty())
+		front++;
+	return &bucket(front);
+}
+
+ScheduledEvent* CalendarEventQueue::top() const {
+	const Bucket* b = frontBucket();
+	if (b == 0) return overflow.top().evt;
+	const Entry& entry = b->events[b->head];
+	if (!overflow.empty() && overflow.top() < entry) return overflow.top().evt;
+	return entry.evt;
+}
+
+void CalendarEventQueue::pop() {
+	const Bucket* b = frontBucket();
+	double tick;
+	if (b != 0 && (overflow.empty() || b->events[b->head] < overflow.top())) {
+		Bucket& fb = bucket(front);
+		tick = fb.events[fb.head].tick;
+		fb.head++;
+		ringCount--;
+	} else {
+		tick = overflow.top().tick;
+		overflow.pop();
+	}
+	advance(tick);
+}
+
+// Moves the start of the window up to the tick of the event that was just
+// removed, if that is later than the current start, and moves any
+// overflow events that are now within the window into the ring.
+void CalendarEventQueue::advance(double tick) {
+	// every event left in the queue is at or after tick, so the window
+	// can start at tick's bucket without stranding any of the ring's events
+	static const double MAX_BASE = 4611686018427387904.0; // 2^62
+	if (tick > base && tick < MAX_BASE) {
+		base = (long) std::floor(tick);
+		if (ringCount == 0 || front < base) front = base;
+	}
+	while (!overflow.empty()) {
+		const Entry& entry = overflow.top();
+		if (!inWindow(entry.tick)) break;
+		Entry moved = entry;
+		overflow.pop();
+		insert(moved);
+	}
+}
+
+#ifdef REPAST_SCHEDULE_THREADS
+
+/**
+ * Pool of worker threads that, together with the calling thread, execute
+ * the events of a parallel group. The workers wait between groups.
+ */
+class EventThreadPool {
+private:
+	boost::thread_group workers;
+	boost::mutex mutex;
+	boost::condition_variable workReady, workDone;
+	const std::vector<ScheduledEvent*>* events;
+	std::vector<double>* times;
+	size_t next;
+	int busy;
+	unsigned long generation;
+	bool shutdown;
+	boost::exception_ptr error;
+
+	void work();
+	void runEvents();
+
+public:
+	EventThreadPool(int threads);
+	~EventThreadPool();
+
+	/**
+	 * Executes the events and returns once all of them have executed.
+	 * If any of them throws, the first exception thrown is rethrown here.
+	 * If eventTimes is not 0 it is filled with the wall time of each event.
+	 */
+	void run(const std::vector<ScheduledEvent*>& toRun, std::vector<double>* eventTimes);
+};
+
+EventThreadPool::EventThreadPool(int threads) :
+	events(0), times(0), next(0), busy(0), generation(0), shutdown(false) {
+	for (int i = 1; i < threads; i++)
+		workers.create_thread(boost::bind(&EventThreadPool::work, this));
+}
+
+EventThreadPool::~EventThreadPool() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		shutdown = true;
+	}
+	workReady.notify_all();
+	workers.join_all();
+}
+
+// executes events from the current group until there are none left
+void EventThreadPool::runEvents() {
+	while (true) {
+		size_t index;
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			if (next >= events->size()) return;
+			index = next++;
+		}
+		try {
+			// each event's time is written by the one thread that runs it
+			double begin = (times == 0 ? 0 : MPI_Wtime());
+			(*events)[index]->get_event()->execute();
+			if (times != 0) (*times)[index] = MPI_Wtime() - begin;
+		} catch (...) {
+			boost::mutex::scoped_lock lock(mutex);
+			if (!error) error = boost::current_exception();
+		}
+	}
+}
+
+void EventThreadPool::work() {
+	unsigned long seen = 0;
+	while (true) {
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			while (!shutdown && generation == seen)
+				workReady.wait(lock);
+			if (shutdown) return;
+			seen = generation;
+		}
+		runEvents();
+		boost::mutex::scoped_lock lock(mutex);
+		if (--busy == 0) workDone.notify_one();
+	}
+}
+
+void EventThreadPool::run(const std::vector<ScheduledEvent*>& toRun, std::vector<double>* eventTimes) {
+	if (eventTimes != 0) eventTimes->assign(toRun.size(), 0.0);
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		events = &toRun;
+		times = eventTimes;
+		next = 0;
+		busy = (int) workers.size();
+		error = boost::exception_ptr();
+		generation++;
+	}
+	workReady.notify_all();
+	runEvents();
+	boost::mutex::scoped_lock lock(mutex);
+	// every worker must finish this group before the next one can start
+	while (busy > 0)
+		workDone.wait(lock);
+	events = 0;
+	times = 0;
+	if (error) {
+		boost::exception_ptr thrown = error;
+		error = boost::exception_ptr();
+		boost::rethrow_exception(thrown);
+	}
+}
+
+#endif
+
+EventQueue* Schedule::createQueue(QUEUE_TYPE type) {
+	if (type == CALENDAR) return new CalendarEventQueue();
+	return new HeapEventQueue();
+}
+
+Schedule::Schedule(QUEUE_TYPE type) :
+	queue(createQueue(type)), queueType(type), currentTick(0), pool(0), threadCount(1), profiler(0) {
+}
+
 Schedule::~Schedule() {
-	while (!queue.empty()) {
-		ScheduledEvent *evt = queue.top();
+	while (!queue->empty()) {
+		ScheduledEvent *evt = queue->top();
 
-		queue.pop();
+		queue->pop();
 		delete evt;
 	}
+	delete queue;
+#ifdef REPAST_SCHEDULE_THREADS
+	delete pool;
+#endif
+}
+
+void Schedule::setThreadCount(int threads) {
+#ifdef REPAST_SCHEDULE_THREADS
+	if (threads < 1) throw Repast_Error_63(threads);
+	if (threads == threadCount) return;
+	delete pool;
+	pool = (threads > 1 ? new EventThreadPool(threads) : 0);
+#else
+	if (threads != 1) throw Repast_Error_63(threads);
+#endif
+	threadCount = threads;
+}
+
+void Schedule::setQueueType(QUEUE_TYPE type) {
+	if (type == queueType) return;
+	EventQueue* newQueue = createQueue(type);
+	while (!queue->empty()) {
+		newQueue->push(queue->top());
+		queue->pop();
+	}
+	delete queue;
+	queue = newQueue;
+	queueType = type;
+}
+
+// labels are kept in a set, whose elements do not move, so that each event
+// only holds a pointer to its label
+ScheduledEvent* Schedule::labelEvent(ScheduledEvent* evt, const std::string& label) {
+	if (!label.empty()) evt->label = &*labels.insert(label).first;
+	return evt;
+}
+
+ScheduledEvent* Schedule::push(ScheduledEvent* evt, const std::string& label) {
+	labelEvent(evt, label);
+	queue->push(evt);
+	return evt;
+}
+
+ScheduledEvent* Schedule::schedule_event(double start, FunctorPtr func, const std::string& label) {
+	return labelEvent(schedule_event(start, func), label);
+}
+
+ScheduledEvent* Schedule::schedule_event(double start, double interval, FunctorPtr func, const std::string& label) {
+	return labelEvent(schedule_event(start, interval, func), label);
+}
+
+void Schedule::executeEvent(ScheduledEvent* evt) {
+	if (profiler == 0) {
+		evt->get_event()->execute();
+	} else {
+		double begin = MPI_Wtime();
+		evt->get_event()->execute();
+		profiler->record(evt->getLabel(), MPI_Wtime() - begin);
+	}
 }
 
 ScheduledEvent* Schedule::schedule_event(double start, FunctorPtr func) {
@@ -103,7 +413,7 @@ ScheduledEvent* Schedule::schedule_event(double start, FunctorPtr func) {
 	evt->func_ptr = func;
 	evt->tick = start;
 	OneTimeEvent *event = new OneTimeEvent(start, evt);
-	queue.push(event);
+	queue->push(event);
 	return event;
 }
 
@@ -112,27 +422,96 @@ ScheduledEvent* Schedule::schedule_event(double start, double interval, FunctorP
 	evt->func_ptr = func;
 	evt->tick = start;
 	RepeatingEvent *event = new RepeatingEvent(start, interval, evt);
-	queue.push(event);
+	queue->push(event);
 	return event;
 }
 
+// Executes the events due at next with the parallel groups run on the pool.
+// Each pass takes all the events that are due, so events scheduled for next
+// by those events execute in a later pass.
+void Schedule::executeGroups(double next) {
+	std::vector<std::pair<int, size_t> > grouped;
+	std::vector<ScheduledEvent*> group;
+	std::vector<double> times;
+	while (!queue->empty() && queue->top()->get_event()->tick == next) {
+		due.clear();
+		while (!queue->empty() && queue->top()->get_event()->tick == next) {
+			due.push_back(queue->top());
+			queue->pop();
+		}
+
+		grouped.clear();
+		for (size_t i = 0; i < due.size(); i++) {
+			if (due[i]->getParallelGroup() != 0) grouped.push_back(std::make_pair(due[i]->getParallelGroup(), i));
+		}
+		std::sort(grouped.begin(), grouped.end());
+
+		std::vector<bool> executed(due.size(), false);
+		try {
+			for (size_t i = 0; i < due.size(); i++) {
+				if (executed[i]) continue;
+				int groupId = due[i]->getParallelGroup();
+				if (groupId == 0) {
+					executeEvent(due[i]);
+					continue;
+				}
+				std::vector<std::pair<int, size_t> >::iterator first = std::lower_bound(grouped.begin(), grouped.end(),
+						std::make_pair(groupId, (size_t) 0));
+				group.clear();
+				for (std::vector<std::pair<int, size_t> >::iterator iter = first; iter != grouped.end() && iter->first
+						== groupId; ++iter) {
+					executed[iter->second] = true;
+					group.push_back(due[iter->second]);
+				}
+#ifdef REPAST_SCHEDULE_THREADS
+				if (group.size() > 1) {
+					pool->run(group, profiler == 0 ? 0 : &times);
+					for (size_t j = 0; j < times.size() && profiler != 0; j++)
+						profiler->record(group[j]->getLabel(), times[j]);
+					continue;
+				}
+#endif
+				for (size_t j = 0; j < group.size(); j++)
+					executeEvent(group[j]);
+			}
+		} catch (...) {
+			// the due events are off the queue, so put them back (or free
+			// them) before letting the exception out
+			rescheduleDue();
+			throw;
+		}
+		rescheduleDue();
+	}
+}
+
+void Schedule::rescheduleDue() {
+	for (size_t i = 0; i < due.size(); i++) {
+		if (!due[i]->reschedule(*queue)) delete due[i];
+	}
+	due.clear();
+}
+
 void Schedule::execute() {
-	if (!queue.empty()) {
-		ScheduledEvent *evt = queue.top();
+	if (!queue->empty() && pool != 0) {
+		currentTick = queue->top()->get_event()->tick;
+		executeGroups(currentTick);
+		return;
+	}
+	if (!queue->empty()) {
+		ScheduledEvent *evt = queue->top();
 		double next = evt->get_event()->tick;
 		currentTick = next;
 		//std::cout << "execute at: " << currentTick << std::endl;
 		bool go = true;
 		while (go) {
-			queue.pop();
-			Functor *func = evt->get_event()->func_ptr.get();
-			(*func)();
-			bool isLive = evt->reschedule(queue);
+			queue->pop();
+			executeEvent(evt);
+			bool isLive = evt->reschedule(*queue);
 			if (!isLive) delete evt;
-			if (queue.empty())
+			if (queue->empty())
 				go = false;
 			else {
-				evt = queue.top();
+				evt = queue->top();
 				go = evt->get_event()->tick == next;
 			}
 		}
@@ -140,10 +519,24 @@ void Schedule::execute() {
 	//std::cout << "execute at: " << getCurrentTick() << std::endl;
 }
 
-ScheduleRunner::ScheduleRunner(boost::mpi::communicator* communicator) : go(true), comm(communicator) {
+ScheduleRunner::ScheduleRunner(boost::mpi::communicator* communicator) : go(true), lookahead(0), profiler_(0),
+	comm(communicator) {
+}
+
+ScheduleRunner::~ScheduleRunner() {
+	delete profiler_;
 }
 
-ScheduleRunner::~ScheduleRunner() {}
+void ScheduleRunner::setProfiling(bool on, const std::string& file) {
+	if (on) {
+		if (profiler_ == 0) profiler_ = new ScheduleProfiler(file);
+		profiler_->setFile(file);
+	} else {
+		delete profiler_;
+		profiler_ = 0;
+	}
+	schedule_.setProfiler(profiler_);
+}
 
 void ScheduleRunner::nextTick() {
 	localNextTick = schedule_.getNextTick();
@@ -167,6 +560,19 @@ ScheduledEvent* ScheduleRunner::scheduleEvent(double start, double interval, Sch
 	return evt;
 }
 
+ScheduledEvent* ScheduleRunner::scheduleEvent(double at, Schedule::FunctorPtr func, const std::string& label) {
+	ScheduledEvent *evt = schedule_.schedule_event(at, func, label);
+	nextTick();
+	return evt;
+}
+
+ScheduledEvent* ScheduleRunner::scheduleEvent(double start, double interval, Schedule::FunctorPtr func,
+		const std::string& label) {
+	ScheduledEvent *evt = schedule_.schedule_event(start, interval, func, label);
+	nextTick();
+	return evt;
+}
+
 void ScheduleRunner::stop() {
 	go = false;
 }
@@ -175,20 +581,36 @@ void ScheduleRunner::scheduleEndEvent(Schedule::FunctorPtr func) {
 	endEvents.push_back(func);
 }
 
+void ScheduleRunner::setLookahead(double ticks) {
+	if (ticks < 0) throw Repast_Error_62(ticks);
+	lookahead = ticks;
+}
+
 void ScheduleRunner::run() {
 	//Timer timer;
 	while (go) {
 		//timer.start();
 		all_reduce(*comm, localNextTick, globalNextTick, boost::mpi::minimum<double>());//&localNextTick, &globalNextTick, 1, MPI::DOUBLE, MPI::MIN);
 		//Log4CL::instance()->get_logger("root").log(INFO, "schedule idle, time: " + boost::lexical_cast<std::string>(timer.stop()));
-		if (localNextTick == globalNextTick)
-			schedule_.execute();
-		nextTick();
+		if (lookahead > 0) {
+			// execute the local events in the window without agreeing on each tick;
+			// an empty schedule (next tick of -1) waits for the next reduction
+			double horizon = globalNextTick + lookahead;
+			while (go && localNextTick >= globalNextTick && localNextTick < horizon) {
+				schedule_.execute();
+				nextTick();
+			}
+		} else {
+			if (localNextTick == globalNextTick)
+				schedule_.execute();
+			nextTick();
+		}
 	}
 	// execute end events
 	for (size_t i = 0; i < endEvents.size(); i++) {
 		(*endEvents[i])();
 	}
+	if (profiler_ != 0) profiler_->report(*comm);
 }
 
 }
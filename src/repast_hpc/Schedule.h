@@ -41,11 +41,25 @@
 #ifndef SCHEDULE_H_
 #define SCHEDULE_H_
 
+/*
+ * If defined, the events of a tick that share a parallel group (see
+ * ScheduledEvent::setParallelGroup) can be executed concurrently on a
+ * pool of worker threads (see Schedule::setThreadCount). This requires
+ * linking against boost_thread.
+ */
+//#define REPAST_SCHEDULE_THREADS
+
 #include <vector>
 #include <queue>
+#include <set>
+#include <string>
+#include <cstddef>
+#include <new>
 #include <boost/mpi/communicator.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 
 namespace repast {
 
@@ -83,6 +97,104 @@ public:
 	}
 };
 
+/**
+ * Calls a no-arg method on an object instance. Unlike MethodFunctor
+ * this is a plain value, small enough to be scheduled inline (see
+ * Schedule::schedule_call).
+ *
+ * @tparam T the object type on which the call will be made.
+ */
+template<typename T>
+class MethodCall {
+private:
+	T *obj;
+	void (T::*fptr)();
+public:
+	MethodCall(T *_obj, void(T::*_fptr)()) :
+		obj(_obj), fptr(_fptr) {
+	}
+
+	void operator()() const {
+		(obj->*fptr)();
+	}
+};
+
+/**
+ * Creates a MethodCall of the method on the object.
+ */
+template<typename T>
+MethodCall<T> methodCall(T* obj, void(T::*fptr)()) {
+	return MethodCall<T>(obj, fptr);
+}
+
+/**
+ * Type erased no-arg callable that is stored in place rather than
+ * on the heap. Any copyable callable type of at most CAPACITY bytes can
+ * be stored; the check is made at compile time.
+ */
+class InlineFunctor: public boost::noncopyable {
+public:
+	static const size_t CAPACITY = 4 * sizeof(void*);
+
+private:
+	union Storage {
+		void* pointer;
+		double number;
+		long integer;
+		unsigned char bytes[CAPACITY];
+	} storage;
+	void (*invoker)(void*);
+	void (*destroyer)(void*);
+
+	template<typename F>
+	static void invokeAs(void* callable) {
+		(*static_cast<F*>(callable))();
+	}
+
+	template<typename F>
+	static void destroyAs(void* callable) {
+		static_cast<F*>(callable)->~F();
+	}
+
+public:
+	InlineFunctor() : invoker(0), destroyer(0) {
+	}
+
+	~InlineFunctor() {
+		reset();
+	}
+
+	/**
+	 * Stores a copy of the callable, replacing any stored before.
+	 */
+	template<typename F>
+	void set(const F& callable) {
+		BOOST_STATIC_ASSERT(sizeof(F) <= CAPACITY);
+		BOOST_STATIC_ASSERT(boost::alignment_of<F>::value <= boost::alignment_of<Storage>::value);
+		reset();
+		new (storage.bytes) F(callable);
+		invoker = &invokeAs<F>;
+		destroyer = &destroyAs<F>;
+	}
+
+	/**
+	 * Destroys the stored callable, if any.
+	 */
+	void reset() {
+		if (destroyer != 0) destroyer(storage.bytes);
+		invoker = 0;
+		destroyer = 0;
+	}
+
+	bool empty() const {
+		return invoker == 0;
+	}
+
+	void operator()() {
+		invoker(storage.bytes);
+	}
+};
+
 /**
  * General class linking a function pointer to a specific tick.
  */
@@ -91,12 +203,34 @@ class RepastEvent {
 public:
 	double tick;
 	boost::shared_ptr<Functor> func_ptr;
+	/**
+	 * The callable of an event scheduled with Schedule::schedule_call,
+	 * used instead of func_ptr.
+	 */
+	InlineFunctor call;
 
 	virtual ~RepastEvent();
 
+	/**
+	 * Calls the inline callable if there is one, otherwise func_ptr.
+	 */
+	void execute() {
+		if (call.empty())
+			(*func_ptr)();
+		else
+			call();
+	}
+
+	/**
+	 * RepastEvents are allocated from a pool of fixed size nodes.
+	 */
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
+
 };
 
 class EventCompare;
+class EventQueue;
 
 /**
  * The object that is placed (scheduled) in the priority queue for execution.
@@ -106,15 +240,55 @@ class ScheduledEvent {
 protected:
 	RepastEvent *event;
 	double start;
+	int parallelGroup;
+	const std::string* label;
 
 public:
 	friend class EventCompare;
+	friend class Schedule;
 	ScheduledEvent(double, RepastEvent *);
 	virtual ~ScheduledEvent();
+
+	/**
+	 * Puts this event in the specified parallel group. Events that execute
+	 * at the same tick and are in the same nonzero group are independent of
+	 * each other: they may execute concurrently, in any order, when the
+	 * Schedule uses more than one thread. Such events must not schedule
+	 * other events, nor communicate with other processes. Events in group 0
+	 * (the default) always execute one at a time, in tick order, on the
+	 * thread that executes the Schedule.
+	 *
+	 * @param group the parallel group
+	 */
+	void setParallelGroup(int group) {
+		parallelGroup = group;
+	}
+
+	/**
+	 * Gets the parallel group of this event.
+	 */
+	int getParallelGroup() const {
+		return parallelGroup;
+	}
+
+	/**
+	 * Gets the label this event was scheduled with, or the empty string
+	 * if it was scheduled without one.
+	 */
+	const std::string& getLabel() const;
+
+	/**
+	 * ScheduledEvents are allocated from a pool of fixed size nodes, so
+	 * that scheduling large numbers of one time events does not go through
+	 * the general purpose allocator for each of them.
+	 */
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
+
 	/**
 	 * Returns true if this event is rescheduled on the specified queue, otherwise false.
 	 */
-	virtual bool reschedule(std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare>&) = 0;
+	virtual bool reschedule(EventQueue&) = 0;
 
 	/**
 	 * Gets the RepastEvent that this ScheduleEvent wraps.
@@ -136,7 +310,7 @@ public:
 	/**
 	 * Always returns false, as it does not reschedule itself.
 	 */
-	virtual bool reschedule(std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare>&);
+	virtual bool reschedule(EventQueue&);
 };
 
 /**
@@ -151,7 +325,7 @@ private:
 public:
 	RepeatingEvent(double start, double _interval, RepastEvent*);
 	~RepeatingEvent();
-	virtual bool reschedule(std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare>&);
+	virtual bool reschedule(EventQueue&);
 };
 
 /**
@@ -167,22 +341,249 @@ public:
 };
 
 /**
- * The simulation schedule queue. This wraps a priority queue
+ * Interface for the queues that hold a Schedule's ScheduledEvents
+ * in tick order.
+ */
+class EventQueue {
+public:
+	virtual ~EventQueue();
+
+	/**
+	 * Adds the event to the queue at the tick of its RepastEvent.
+	 */
+	virtual void push(ScheduledEvent* evt) = 0;
+
+	/**
+	 * Gets the event with the lowest tick. The queue must not be empty.
+	 */
+	virtual ScheduledEvent* top() const = 0;
+
+	/**
+	 * Removes the event with the lowest tick. The queue must not be empty.
+	 */
+	virtual void pop() = 0;
+
+	virtual bool empty() const = 0;
+	virtual size_t size() const = 0;
+};
+
+/**
+ * EventQueue implemented as a binary heap of ScheduledEvents. Insertion
+ * and removal are O(log n); events scheduled for the same tick execute
+ * in no particular order.
+ */
+class HeapEventQueue: public EventQueue {
+private:
+	std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare> queue;
+
+public:
+	virtual ~HeapEventQueue();
+
+	virtual void push(ScheduledEvent* evt) {
+		queue.push(evt);
+	}
+
+	virtual ScheduledEvent* top() const {
+		return queue.top();
+	}
+
+	virtual void pop() {
+		queue.pop();
+	}
+
+	virtual bool empty() const {
+		return queue.empty();
+	}
+
+	virtual size_t size() const {
+		return queue.size();
+	}
+};
+
+/**
+ * EventQueue implemented as a calendar queue: a ring of buckets, each of
+ * which holds the events whose tick falls within one whole tick
+ * [n, n + 1). The ring covers a window of bucketCount ticks starting at the
+ * tick that is currently executing; events outside of that window are kept
+ * in an overflow heap and moved into the ring as the window advances.
+ * For the common case of events scheduled at integer ticks within the
+ * window, insertion and removal are O(1) amortized, and the bucket storage
+ * is reused so that a steady state schedule does no allocation.
+ *
+ * Events scheduled for the same tick execute in the order in which they were
+ * scheduled.
+ */
+class CalendarEventQueue: public EventQueue {
+private:
+	struct Entry {
+		double tick;
+		unsigned long long order;
+		ScheduledEvent* evt;
+
+		bool operator<(const Entry& other) const {
+			return tick < other.tick || (tick == other.tick && order < other.order);
+		}
+	};
+
+	struct EntryLater {
+		bool operator()(const Entry& one, const Entry& two) const {
+			return two < one;
+		}
+	};
+
+	// the events of a bucket live in [head, events.size()) in tick order
+	struct Bucket {
+		std::vector<Entry> events;
+		size_t head;
+
+		Bucket() : head(0) {}
+		bool empty() const {
+			return head == events.size();
+		}
+	};
+
+	std::vector<Bucket> buckets;
+	size_t mask;
+	long base;				// first tick of the window the ring covers
+	mutable long front;		// no bucket in [base, front) holds any events
+	size_t ringCount;
+	unsigned long long order;
+	std::priority_queue<Entry, std::vector<Entry>, EntryLater> overflow;
+
+	bool inWindow(double tick) const {
+		return tick >= base && tick < base + (double) buckets.size();
+	}
+
+	Bucket& bucket(long index) {
+		return buckets[(unsigned long) index & mask];
+	}
+
+	const Bucket& bucket(long index) const {
+		return buckets[(unsigned long) index & mask];
+	}
+
+	void insert(const Entry& entry);
+	const Bucket* frontBucket() const;
+	void advance(double tick);
+
+public:
+	/**
+	 * Creates a CalendarEventQueue.
+	 *
+	 * @param bucketCount the number of whole ticks covered by the ring of
+	 * buckets. This is rounded up to a power of two.
+	 */
+	CalendarEventQueue(size_t bucketCount = 1024);
+	virtual ~CalendarEventQueue();
+
+	virtual void push(ScheduledEvent* evt);
+	virtual ScheduledEvent* top() const;
+	virtual void pop();
+
+	virtual bool empty() const {
+		return ringCount == 0 && overflow.empty();
+	}
+
+	virtual size_t size() const {
+		return ringCount + overflow.size();
+	}
+};
+
+class EventThreadPool;
+class ScheduleProfiler;
+
+/**
+ * The simulation schedule queue. This wraps an EventQueue
  * to schedule repast ScheduledEvents.
  */
 class Schedule {
+public:
+	/**
+	 * The kinds of EventQueue that a Schedule can use. HEAP is a
+	 * binary heap (the default); CALENDAR is a calendar queue that
+	 * is faster for schedules with many events at integer ticks.
+	 */
+	enum QUEUE_TYPE {
+		HEAP, CALENDAR
+	};
+
 private:
-	typedef std::priority_queue<ScheduledEvent *, std::vector<ScheduledEvent*>, EventCompare> QueueType;
-	QueueType queue;
+	EventQueue* queue;
+	QUEUE_TYPE queueType;
 	double currentTick;
+	EventThreadPool* pool;
+	int threadCount;
+	std::vector<ScheduledEvent*> due;
+	std::set<std::string> labels;
+	ScheduleProfiler* profiler;
+
+	static EventQueue* createQueue(QUEUE_TYPE type);
+	void executeGroups(double next);
+	void rescheduleDue();
+	void executeEvent(ScheduledEvent* evt);
+	ScheduledEvent* labelEvent(ScheduledEvent* evt, const std::string& label);
+	ScheduledEvent* push(ScheduledEvent* evt, const std::string& label);
 
 public:
 	/**
 	 * Typedef of for the functors that get scheduled.
 	 */
 	typedef boost::shared_ptr<Functor> FunctorPtr;
+	Schedule(QUEUE_TYPE type = HEAP);
 	virtual ~Schedule();
 
+	/**
+	 * Sets the kind of queue that this Schedule uses. Any events that are
+	 * already scheduled are moved to the new queue.
+	 *
+	 * @param type the kind of queue to use
+	 */
+	void setQueueType(QUEUE_TYPE type);
+
+	/**
+	 * Gets the kind of queue that this Schedule uses.
+	 */
+	QUEUE_TYPE getQueueType() const {
+		return queueType;
+	}
+
+	/**
+	 * Sets the number of threads, including the calling thread, used to
+	 * execute the events of a tick that are in the same parallel group
+	 * (see ScheduledEvent::setParallelGroup). With more than one thread,
+	 * execute() first takes all the events due at the tick, executes them
+	 * in tick order except that all of the events in a parallel group
+	 * execute together, concurrently, where the first of them would have,
+	 * and then reschedules them. With one thread (the default) execute()
+	 * runs every event in turn, as if there were no parallel groups.
+	 * More than one thread requires REPAST_SCHEDULE_THREADS.
+	 *
+	 * @param threads the number of threads
+	 */
+	void setThreadCount(int threads);
+
+	/**
+	 * Gets the number of threads used to execute parallel groups.
+	 */
+	int getThreadCount() const {
+		return threadCount;
+	}
+
+	/**
+	 * Sets the profiler that records the time each executed event takes,
+	 * or 0 to stop profiling. The profiler is not owned by this Schedule.
+	 */
+	void setProfiler(ScheduleProfiler* eventProfiler) {
+		profiler = eventProfiler;
+	}
+
+	/**
+	 * Gets the number of events currently scheduled.
+	 */
+	size_t size() const {
+		return queue->size();
+	}
+
 	/**
 	 * Schedule the specified functor to execute once at the specified tick.
 	 *
@@ -204,6 +605,94 @@ public:
 	 * @return the event that has been scheduled
 	 */
 	ScheduledEvent* schedule_event(double start, double interval, FunctorPtr func);
+
+	/**
+	 * Schedule the specified functor to execute once at the specified tick,
+	 * labelled for profiling.
+	 *
+	 * @param at the tick to execute at
+	 * @param functor the functor to schedule
+	 * @param label the label the event's time is recorded under
+	 *
+	 * @return the event that has been scheduled
+	 */
+	ScheduledEvent* schedule_event(double at, FunctorPtr functor, const std::string& label);
+
+	/**
+	 * Schedules the specified functor to execute start at start, and at the specified interval
+	 * thereafter, labelled for profiling.
+	 *
+	 * @param start
+	 * @param interval
+	 * @param func
+	 * @param label the label the event's time is recorded under
+	 *
+	 * @return the event that has been scheduled
+	 */
+	ScheduledEvent* schedule_event(double start, double interval, FunctorPtr func, const std::string& label);
+
+	/**
+	 * Schedules a copy of the callable to execute once at the specified tick.
+	 * The callable is stored in the event itself (see InlineFunctor), so
+	 * unlike schedule_event this makes no heap allocation nor shared_ptr
+	 * for it. Use MethodCall (e.g. methodCall(agent, &Agent::recover)) to
+	 * call a method.
+	 *
+	 * @param at the tick to execute at
+	 * @param callable a copyable callable of at most InlineFunctor::CAPACITY bytes
+	 * @param label the label the event's time is recorded under when profiling
+	 *
+	 * @return the event that has been scheduled
+	 */
+	template<typename F>
+	ScheduledEvent* schedule_call(double at, const F& callable, const std::string& label = "") {
+		RepastEvent *evt = new RepastEvent();
+		evt->call.set(callable);
+		evt->tick = at;
+		return push(new OneTimeEvent(at, evt), label);
+	}
+
+	/**
+	 * Schedules a copy of the callable to execute at start, and at the
+	 * specified interval thereafter. The callable is stored in the event
+	 * itself, as with schedule_call(double, const F&, const std::string&).
+	 *
+	 * @param start the tick to start at
+	 * @param interval the interval to execute at
+	 * @param callable a copyable callable of at most InlineFunctor::CAPACITY bytes
+	 * @param label the label the event's time is recorded under when profiling
+	 *
+	 * @return the event that has been scheduled
+	 */
+	template<typename F>
+	ScheduledEvent* schedule_call(double start, double interval, const F& callable, const std::string& label = "") {
+		RepastEvent *evt = new RepastEvent();
+		evt->call.set(callable);
+		evt->tick = start;
+		return push(new RepeatingEvent(start, interval, evt), label);
+	}
+
+	/**
+	 * Schedules the method to be called once at the specified tick on each
+	 * of the objects in the range, e.g. on every agent of a Context. Each
+	 * call is a separate event, scheduled as with schedule_call.
+	 *
+	 * @param at the tick to execute at
+	 * @param first the start of the range of pointers (or shared_ptrs) to the objects
+	 * @param last the end of the range
+	 * @param fptr the method to call
+	 * @param label the label the events' time is recorded under when profiling
+	 *
+	 * @return the number of events scheduled
+	 */
+	template<typename Iterator, typename T>
+	size_t schedule_calls(double at, Iterator first, Iterator last, void(T::*fptr)(), const std::string& label = "") {
+		size_t count = 0;
+		for (; first != last; ++first, ++count)
+			schedule_call(at, MethodCall<T> (&**first, fptr), label);
+		return count;
+	}
+
 	void execute();
 
 	/**
@@ -222,9 +711,9 @@ public:
 	 * @return the next tick at which the next events will be executed.
 	 */
 	double getNextTick() const {
-		if (queue.empty())
+		if (queue->empty())
 			return -1;
-		return queue.top()->get_event()->tick;
+		return queue->top()->get_event()->tick;
 	}
 	;
 };
@@ -242,6 +731,8 @@ private:
 	bool go;
 	Schedule schedule_;
 	double globalNextTick, localNextTick;
+	double lookahead;
+	ScheduleProfiler* profiler_;
 	void nextTick();
 	boost::mpi::communicator* comm;
 	std::vector<boost::shared_ptr<Functor> > endEvents;
@@ -272,6 +763,73 @@ public:
 	 */
 	ScheduledEvent* scheduleEvent(double start, double interval, Schedule::FunctorPtr func);
 
+	/**
+	 * Schedules the Functor to execute at the specified tick. When profiling,
+	 * the time it takes is recorded under the label.
+	 *
+	 * @param at the time to execute at
+	 * @param func the functor to execute
+	 * @param label the label of the event
+	 *
+	 * @return the event that was scheduled for the func
+	 */
+	ScheduledEvent* scheduleEvent(double at, Schedule::FunctorPtr func, const std::string& label);
+
+	/**
+	 * Schedules the Functor to execute at the specified start tick
+	 * and every interval thereafter. When profiling, the time it takes
+	 * is recorded under the label.
+	 *
+	 * @param start the time to start at
+	 * @param interval the interval to execute at
+	 * @param func the functor to execute
+	 * @param label the label of the event
+	 *
+	 * @return the event that was scheduled for the func
+	 */
+	ScheduledEvent* scheduleEvent(double start, double interval, Schedule::FunctorPtr func, const std::string& label);
+
+	/**
+	 * Schedules a copy of the callable to execute at the specified tick,
+	 * stored inline in the event.
+	 *
+	 * @see Schedule::schedule_call
+	 */
+	template<typename F>
+	ScheduledEvent* scheduleCall(double at, const F& callable, const std::string& label = "") {
+		ScheduledEvent *evt = schedule_.schedule_call(at, callable, label);
+		nextTick();
+		return evt;
+	}
+
+	/**
+	 * Schedules a copy of the callable to execute at the specified start tick
+	 * and every interval thereafter, stored inline in the event.
+	 *
+	 * @see Schedule::schedule_call
+	 */
+	template<typename F>
+	ScheduledEvent* scheduleCall(double start, double interval, const F& callable, const std::string& label = "") {
+		ScheduledEvent *evt = schedule_.schedule_call(start, interval, callable, label);
+		nextTick();
+		return evt;
+	}
+
+	/**
+	 * Schedules the method to be called at the specified tick on each of the
+	 * objects in the range.
+	 *
+	 * @return the number of events scheduled
+	 *
+	 * @see Schedule::schedule_calls
+	 */
+	template<typename Iterator, typename T>
+	size_t scheduleCalls(double at, Iterator first, Iterator last, void(T::*fptr)(), const std::string& label = "") {
+		size_t count = schedule_.schedule_calls(at, first, last, fptr, label);
+		nextTick();
+		return count;
+	}
+
 	/**
 	 * Schedules the specified functor to execute when the simulation ends.
 	 *
@@ -279,6 +837,16 @@ public:
 	 */
 	void scheduleEndEvent(Schedule::FunctorPtr func);
 
+	/**
+	 * Sets the kind of queue used by the schedule executed by this
+	 * simulation runner. Any events that are already scheduled are kept.
+	 *
+	 * @param type the kind of queue to use
+	 */
+	void setQueueType(Schedule::QUEUE_TYPE type) {
+		schedule_.setQueueType(type);
+	}
+
 	/**
 	 * Schedules the simulation to stop at the specified tick.
 	 *
@@ -286,6 +854,70 @@ public:
 	 */
 	void scheduleStop(double at);
 
+	/**
+	 * Sets the number of threads used to execute the parallel groups of
+	 * the schedule executed by this simulation runner.
+	 *
+	 * @param threads the number of threads
+	 *
+	 * @see Schedule::setThreadCount
+	 */
+	void setThreadCount(int threads) {
+		schedule_.setThreadCount(threads);
+	}
+
+	/**
+	 * Sets the lookahead used when running the schedule. With a lookahead
+	 * of 0 (the default) the processes agree on the next tick to execute
+	 * before every tick, with a global reduction. With a positive lookahead
+	 * they agree on the earliest next tick of all processes and then each
+	 * executes all of its own events that are earlier than that tick plus
+	 * the lookahead, without communicating, before agreeing again. A model
+	 * whose processes all have the same repeating schedule can use a
+	 * lookahead of several ticks to do one reduction per window of ticks
+	 * instead of one per tick.
+	 *
+	 * Each process still executes exactly its own events, in tick order.
+	 * Events that communicate with other processes (e.g. synchronizations)
+	 * must, as always, be scheduled at the same ticks on all the processes,
+	 * and the simulation must be stopped at the same tick on all of them;
+	 * with a positive lookahead, however, nothing else keeps the processes
+	 * in step within a window.
+	 *
+	 * @param ticks the lookahead, in ticks. This must be the same on all the
+	 * processes.
+	 */
+	void setLookahead(double ticks);
+
+	/**
+	 * Gets the lookahead used when running the schedule.
+	 *
+	 * @return the lookahead used when running the schedule.
+	 */
+	double getLookahead() const {
+		return lookahead;
+	}
+
+	/**
+	 * Turns profiling of the scheduled events on or off. While profiling
+	 * is on, the wall time of every executed event is recorded under its
+	 * label (see scheduleEvent), and at the end of run() a summary across
+	 * all processes is written to the file (see ScheduleProfiler). Profiling
+	 * must be on for all the processes or for none of them.
+	 *
+	 * @param on whether to profile
+	 * @param file the file the summary is written to
+	 */
+	void setProfiling(bool on, const std::string& file = "schedule_profile.csv");
+
+	/**
+	 * Gets the profiler recording the scheduled events, or 0 if profiling
+	 * is off.
+	 */
+	const ScheduleProfiler* profiler() const {
+		return profiler_;
+	}
+
 	/**
 	 * Starts and runs the simulation schedule.
 	 */
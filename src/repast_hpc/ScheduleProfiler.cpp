@@ -0,0 +1,168 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ScheduleProfiler.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "ScheduleProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace repast {
+
+namespace {
+
+const char* UNLABELED = "unlabeled";
+
+// the values sent per label: calls, time, min, max and the bins
+const int VALUE_COUNT = 4 + ScheduleProfiler::BIN_COUNT;
+
+struct Aggregate {
+	int processes;
+	double calls, timeMin, timeMax, timeSum, callMin, callMax;
+	double bins[ScheduleProfiler::BIN_COUNT];
+
+	Aggregate() : processes(0), calls(0), timeMin(0), timeMax(0), timeSum(0), callMin(0), callMax(0) {
+		std::fill(bins, bins + ScheduleProfiler::BIN_COUNT, 0.0);
+	}
+};
+
+}
+
+ScheduleProfiler::Measures::Measures() : calls(0), time(0), min(0), max(0) {
+	std::fill(bins, bins + BIN_COUNT, 0.0);
+}
+
+ScheduleProfiler::ScheduleProfiler(const std::string& file) : _file(file) {
+}
+
+int ScheduleProfiler::bin(double seconds) {
+	double micros = seconds * 1e6;
+	int index = 0;
+	for (double upper = 1; index < BIN_COUNT - 1 && micros >= upper; upper *= 2)
+		index++;
+	return index;
+}
+
+void ScheduleProfiler::record(const std::string& label, double seconds) {
+	Measures& m = measures[label.empty() ? UNLABELED : label];
+	if (m.calls == 0 || seconds < m.min) m.min = seconds;
+	if (m.calls == 0 || seconds > m.max) m.max = seconds;
+	m.calls++;
+	m.time += seconds;
+	m.bins[bin(seconds)]++;
+}
+
+double ScheduleProfiler::calls(const std::string& label) const {
+	std::map<std::string, Measures>::const_iterator iter = measures.find(label.empty() ? UNLABELED : label);
+	return iter == measures.end() ? 0 : iter->second.calls;
+}
+
+void ScheduleProfiler::report(boost::mpi::communicator& comm) {
+	std::vector<std::string> labels;
+	std::vector<double> values;
+	for (std::map<std::string, Measures>::const_iterator iter = measures.begin(); iter != measures.end(); ++iter) {
+		const Measures& m = iter->second;
+		labels.push_back(iter->first);
+		values.push_back(m.calls);
+		values.push_back(m.time);
+		values.push_back(m.min);
+		values.push_back(m.max);
+		values.insert(values.end(), m.bins, m.bins + BIN_COUNT);
+	}
+
+	std::vector<std::vector<std::string> > allLabels;
+	std::vector<std::vector<double> > allValues;
+	boost::mpi::gather(comm, labels, allLabels, 0);
+	boost::mpi::gather(comm, values, allValues, 0);
+	if (comm.rank() != 0)
+		return;
+
+	std::map<std::string, Aggregate> aggregates;
+	for (size_t p = 0; p < allLabels.size(); p++) {
+		for (size_t l = 0; l < allLabels[p].size(); l++) {
+			const double* v = &allValues[p][l * VALUE_COUNT];
+			Aggregate& agg = aggregates[allLabels[p][l]];
+			if (agg.processes == 0) {
+				agg.timeMin = agg.timeMax = v[1];
+				agg.callMin = v[2];
+				agg.callMax = v[3];
+			} else {
+				agg.timeMin = std::min(agg.timeMin, v[1]);
+				agg.timeMax = std::max(agg.timeMax, v[1]);
+				agg.callMin = std::min(agg.callMin, v[2]);
+				agg.callMax = std::max(agg.callMax, v[3]);
+			}
+			agg.processes++;
+			agg.calls += v[0];
+			agg.timeSum += v[1];
+			for (int b = 0; b < BIN_COUNT; b++)
+				agg.bins[b] += v[4 + b];
+		}
+	}
+
+	// processes that never executed a label count as spending no time in it
+	std::ofstream out(_file.c_str());
+	out << "label,processes,calls,time_min,time_max,time_mean,imbalance,call_min,call_max,call_mean";
+	for (int b = 0; b < BIN_COUNT; b++) {
+		if (b < BIN_COUNT - 1)
+			out << ",lt_" << (1L << b) << "us";
+		else
+			out << ",ge_" << (1L << (b - 1)) << "us";
+	}
+	out << std::endl;
+	for (std::map<std::string, Aggregate>::const_iterator iter = aggregates.begin(); iter != aggregates.end();
+			++iter) {
+		const Aggregate& agg = iter->second;
+		double timeMin = agg.processes < comm.size() ? 0 : agg.timeMin;
+		double timeMean = agg.timeSum / comm.size();
+		out << iter->first << "," << agg.processes << "," << agg.calls << "," << timeMin << "," << agg.timeMax
+				<< "," << timeMean << "," << (timeMean > 0 ? agg.timeMax / timeMean : 1) << "," << agg.callMin
+				<< "," << agg.callMax << "," << (agg.calls > 0 ? agg.timeSum / agg.calls : 0);
+		for (int b = 0; b < BIN_COUNT; b++)
+			out << "," << agg.bins[b];
+		out << std::endl;
+	}
+}
+
+}
@@ -0,0 +1,133 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ScheduleProfiler.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef SCHEDULEPROFILER_H_
+#define SCHEDULEPROFILER_H_
+
+#include <map>
+#include <string>
+
+#include <boost/mpi/communicator.hpp>
+
+namespace repast {
+
+/**
+ * Records the wall time (MPI_Wtime) of every scheduled event executed by
+ * a ScheduleRunner, per event label across all ticks: the number of calls,
+ * the total, minimum and maximum time of a call, and a histogram of call
+ * times in power of two bins of microseconds. Events that were scheduled
+ * without a label are recorded under "unlabeled".
+ *
+ * Used by ScheduleRunner when profiling is turned on (see
+ * ScheduleRunner::setProfiling); report() is called at the end of
+ * ScheduleRunner::run() and writes, for each label, the spread across
+ * processes of the total time spent in it, so that both the most expensive
+ * event and the events that are most unequal across processes stand out.
+ */
+class ScheduleProfiler {
+
+public:
+	/**
+	 * The number of histogram bins. Bin 0 counts calls shorter than 1
+	 * microsecond, bin i calls of [2^(i-1), 2^i) microseconds, and the last
+	 * bin all longer calls.
+	 */
+	static const int BIN_COUNT = 24;
+
+private:
+	struct Measures {
+		double calls, time, min, max;
+		double bins[BIN_COUNT];
+		Measures();
+	};
+
+	std::string _file;
+	std::map<std::string, Measures> measures;
+
+public:
+	/**
+	 * Creates a ScheduleProfiler that writes its report to the specified file.
+	 */
+	ScheduleProfiler(const std::string& file = "schedule_profile.csv");
+
+	/**
+	 * Gets the histogram bin of a call of the specified duration.
+	 *
+	 * @param seconds the duration of the call in seconds
+	 */
+	static int bin(double seconds);
+
+	/**
+	 * Sets the file the report is written to.
+	 */
+	void setFile(const std::string& file) {
+		_file = file;
+	}
+
+	/**
+	 * Records one call of an event.
+	 *
+	 * @param label the label of the event, or the empty string if it has none
+	 * @param seconds the wall time the call took
+	 */
+	void record(const std::string& label, double seconds);
+
+	/**
+	 * Gets the number of calls recorded for the label on this process.
+	 */
+	double calls(const std::string& label) const;
+
+	/**
+	 * Discards everything recorded so far.
+	 */
+	void clear() {
+		measures.clear();
+	}
+
+	/**
+	 * Aggregates the measures of all processes in comm and writes them as
+	 * CSV from rank 0. This is a collective operation.
+	 */
+	void report(boost::mpi::communicator& comm);
+};
+
+}
+
+#endif /* SCHEDULEPROFILER_H_ */
@@ -46,6 +46,7 @@
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <functional>
 
 #include "BaseGrid.h"
 #include "GridComponents.h"
@@ -144,6 +145,19 @@ public:
 std::ostream& operator<<(std::ostream& os, const Neighbors& nghs);
 
 
+/**
+ * Cost function for SharedBaseGrid::repartition that counts every
+ * agent as one unit of work, so that the partition balances the
+ * number of agents on each process.
+ */
+struct AgentCountCost {
+  template<typename T>
+  double operator()(const T* agent) const {
+    return 1;
+  }
+};
+
+
 
 /**
  * Grid / Space implementation specialized for the distributed context.
@@ -163,12 +177,29 @@ std::ostream& operator<<(std::ostream& os, const Neighbors& nghs);
  * @tparam Adder determines how objects are added to the grid from its associated context.
  * @tparam GPType the coordinate type of the grid point locations. This must
  * be an int or a double.
+ * @tparam CellAccessor implements the storage of the grid's locations; this
+ * holds the locations of the local bounds and the buffer around them.
  */
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-class SharedBaseGrid: public BaseGrid<T, MultipleOccupancy<T, GPType> , GPTransformer, Adder, GPType> {
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor = MultipleOccupancy<T, GPType> >
+class SharedBaseGrid: public BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType> {
 
 private:
   CartesianTopology* cartTopology;
+  int partitionVersion; // The version of the topology's partition that localBounds and nghs reflect
+
+  void initNeighbors();
+
+  /**
+   * Updates the local bounds and the neighbors' bounds if the partition
+   * of the Cartesian topology has changed since they were set.
+   */
+  void updatePartition();
+
+  /**
+   * Sets the region held by the cell accessor to the local bounds
+   * and the buffer around them.
+   */
+  void initCells();
 
 protected:
 	int _buffer;
@@ -182,12 +213,57 @@ protected:
 	virtual void synchMoveTo(const AgentId& id, const Point<GPType>& pt) = 0;
 
 	int rank;
-	typedef typename repast::BaseGrid<T, MultipleOccupancy<T, GPType> , GPTransformer, Adder, GPType> GridBaseType;
+	typedef typename repast::BaseGrid<T, CellAccessor, GPTransformer, Adder, GPType> GridBaseType;
 	boost::mpi::communicator* comm;
 
 public:
+  /**
+   * Marks the local agents that are no longer within the local bounds
+   * to be moved to the process whose bounds they are in. If the partition of
+   * the process topology has been changed (by a call to repartition on this
+   * or another space that shares it), the bounds are updated first.
+   */
   void balance();
 
+  /**
+   * Measures the work on each process, as the sum of the cost of its local
+   * agents, and if the busiest slab of processes in any dimension has more
+   * than 'tolerance' times the mean work of that dimension's slabs, moves
+   * the boundaries between the slabs toward an equal share of the work.
+   * No boundary moves past the current position of the boundaries on either
+   * side of it, so an agent moves at most one process in each dimension, and
+   * no slab becomes narrower than the buffer; a very uneven load is balanced
+   * over several calls. If the boundaries change, balance() is called to mark
+   * agents to move, and the move is completed by
+   * RepastProcess::synchronizeAgentStatus as usual.
+   *
+   * The partition belongs to the process topology, which is shared by all spaces
+   * and value layers with the same process dimensions and periodicity; these are
+   * updated by their next call to balance() or synchronize() respectively.
+   * This must be called on all processes.
+   *
+   * @param cost the cost of each agent, called as cost(const T* agent)
+   * and returning a double
+   * @param tolerance the ratio of the largest to the mean slab work above
+   * which the boundaries are moved
+   *
+   * @return true if the boundaries changed
+   */
+  template<typename Cost>
+  bool repartition(const Cost& cost, double tolerance = 1.1);
+
+  /**
+   * Repartitions so as to balance the number of local agents on each process.
+   *
+   * @param tolerance the ratio of the largest to the mean slab agent count above
+   * which the boundaries are moved
+   *
+   * @return true if the boundaries changed
+   */
+  bool repartition(double tolerance = 1.1) {
+    return repartition(AgentCountCost(), tolerance);
+  }
+
 	// overriding moveTo that takes newLocation hides the moveTo in the
 	// Grid base class that takes a Point. This using directive
 	// makes the Point arg moveTo available.
@@ -199,7 +275,7 @@ public:
 	 * @param name the name of this SharedBaseGrid
 	 * @param gridDims the dimensions of the entire pan-process grid
 	 * @param processDims the number of processes in each dimension. This must
-	 * divide evenly into gridDims.
+	 * divide evenly into gridDims unless the grid will be repartitioned.
 	 * @param buffer the size of the buffer between this part of the pan-process grid
 	 * and its neighbors.
 	 */
@@ -237,9 +313,9 @@ public:
 
 	// doc inherited from Projection.h
 
-  virtual void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsRequired){ } // Grids don't keep agents
+  virtual void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsRequired){ } // Grids don't keep agents
 
-  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush);
+  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush);
 
 
   virtual void getInfoExchangePartners(std::set<int>& psToSendTo, std::set<int>& psToReceiveFrom){
@@ -256,8 +332,8 @@ public:
 
 };
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-SharedBaseGrid<T, GPTransformer, Adder, GPType>::SharedBaseGrid(std::string name, GridDimensions gridDims, std::vector<
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::SharedBaseGrid(std::string name, GridDimensions gridDims, std::vector<
 		int> processDims, int buffer, boost::mpi::communicator* communicator) :
 	GridBaseType(name, gridDims), _buffer(buffer), comm(communicator), globalBounds(gridDims) {
 
@@ -269,14 +345,21 @@ SharedBaseGrid<T, GPTransformer, Adder, GPType>::SharedBaseGrid(std::string name
 	bool periodic = GridBaseType::gpTransformer.isPeriodic();
 
 	cartTopology = RepastProcess::instance()->getCartesianTopology(processDims, periodic);
-
-	std::vector<int> coords;
-	cartTopology->getCoordinates(rank, coords);
+	partitionVersion = cartTopology->getPartitionVersion();
 
 	localBounds = cartTopology->getDimensions(rank, gridDims);
 	GridBaseType::adder.init(localBounds, this);
+	initCells();
 
-  RelativeLocation relLocUntrimmed(dimCount);
+	initNeighbors();
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::initNeighbors() {
+	std::vector<int> coords;
+	cartTopology->getCoordinates(rank, coords);
+
+  RelativeLocation relLocUntrimmed(globalBounds.dimensionCount());
   RelativeLocation relLoc = cartTopology->trim(rank, relLocUntrimmed);
 
 	nghs = new Neighbors(relLoc.getMaxIndex() + 1);
@@ -285,15 +368,35 @@ SharedBaseGrid<T, GPTransformer, Adder, GPType>::SharedBaseGrid(std::string name
     vector<int> currentVal = relLoc.getCurrentValue();
     int rankOfNeighbor = cartTopology->getRank(coords, currentVal);
     if(rankOfNeighbor != rank && rankOfNeighbor != MPI_PROC_NULL){ // Note: the test for MPI_PROC_NULL is vestigial; by trimming the Relative Location, there should never be any
-      Neighbor* ngh = new Neighbor(rankOfNeighbor, cartTopology->getDimensions(rankOfNeighbor, gridDims));
+      Neighbor* ngh = new Neighbor(rankOfNeighbor, cartTopology->getDimensions(rankOfNeighbor, globalBounds));
       nghs->addNeighbor(ngh, relLoc);
     }
   }while(relLoc.increment());
+}
 
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::updatePartition() {
+  if(partitionVersion == cartTopology->getPartitionVersion()) return;
+  partitionVersion = cartTopology->getPartitionVersion();
+  localBounds = cartTopology->getDimensions(rank, globalBounds);
+  GridBaseType::adder.init(localBounds, this);
+  initCells();
+  delete nghs;
+  initNeighbors();
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-SharedBaseGrid<T, GPTransformer, Adder, GPType>::~SharedBaseGrid() {
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::initCells() {
+  std::vector<double> origin, extents;
+  for(size_t i = 0; i < localBounds.dimensionCount(); i++){
+    origin.push_back(localBounds.origin(i) - _buffer);
+    extents.push_back(localBounds.extents(i) + 2 * _buffer);
+  }
+  GridBaseType::cellAccessor.init(GridDimensions(Point<double>(origin), Point<double>(extents)));
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::~SharedBaseGrid() {
   delete nghs;
 }
 
@@ -340,8 +443,9 @@ SharedBaseGrid<T, GPTransformer, Adder, GPType>::~SharedBaseGrid() {
 //}
 
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::balance() {
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::balance() {
+  updatePartition();
   int r = comm->rank();
   typename GridBaseType::LocationMapConstIter iterEnd = GridBaseType::locationsEnd();
   for (typename GridBaseType::LocationMapConstIter iter = GridBaseType::locationsBegin(); iter != iterEnd; ++iter) {
@@ -356,28 +460,103 @@ void SharedBaseGrid<T, GPTransformer, Adder, GPType>::balance() {
   }
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-bool SharedBaseGrid<T, GPTransformer, Adder, GPType>::moveTo(const AgentId& id, const Point<GPType>& newLocation) {
-	return SharedBaseGrid<T, GPTransformer, Adder, GPType>::moveTo(id, newLocation.coords());
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+template<typename Cost>
+bool SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::repartition(const Cost& cost, double tolerance) {
+  updatePartition();
+  int r = comm->rank();
+  int numDims = globalBounds.dimensionCount();
+  int minWidth = std::max(1, _buffer);
+  const std::vector<int>& procsPerDim = cartTopology->getProcessesPerDimension();
+  std::vector<std::vector<double> > fractions;
+  cartTopology->getPartition(fractions);
+
+  bool changed = false;
+  for(int i = 0; i < numDims; i++){
+    int procs = procsPerDim[i];
+    if(procs < 2) continue;
+
+    // The work in each unit-wide cell along this dimension, summed over all processes
+    int cells = (int)std::ceil(globalBounds.extents(i));
+    double origin = globalBounds.origin(i);
+    std::vector<double> localWork(cells, 0);
+    typename GridBaseType::LocationMapConstIter iterEnd = GridBaseType::locationsEnd();
+    for (typename GridBaseType::LocationMapConstIter iter = GridBaseType::locationsBegin(); iter != iterEnd; ++iter) {
+      const T* agent = &*iter->second->ptr;
+      if(agent->getId().currentRank() != r || !iter->second->inGrid) continue; // Local agents only
+      int cell = (int)std::floor(iter->second->point[i] - origin);
+      localWork[std::min(std::max(cell, 0), cells - 1)] += cost(agent);
+    }
+    std::vector<double> work(cells, 0);
+    boost::mpi::reduce(*comm, &localWork[0], cells, &work[0], std::plus<double>(), 0);
+
+    // The new boundaries are found on process 0 and sent to the others, so that all use the same
+    std::vector<int> cuts(procs + 1);
+    for(int k = 0; k <= procs; k++) cuts[k] = (int)std::floor(fractions[i][k] * cells + 0.5);
+    std::vector<int> newCuts(cuts);
+    if(r == 0){
+      std::vector<double> cumulative(cells + 1, 0); // Work in the cells before each cell
+      for(int c = 0; c < cells; c++) cumulative[c + 1] = cumulative[c] + work[c];
+      double total = cumulative[cells];
+      double maxWork = 0;
+      for(int k = 0; k < procs; k++) maxWork = std::max(maxWork, cumulative[cuts[k + 1]] - cumulative[cuts[k]]);
+      if(total > 0 && maxWork > tolerance * total / procs){
+        // Place each boundary at its share of the work, but no farther than the current boundaries on either side
+        for(int k = 1; k < procs; k++){
+          double target = total * k / procs;
+          int c = (int)(std::lower_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin());
+          if(c > 0 && target - cumulative[c - 1] < cumulative[c] - target) c--;
+          newCuts[k] = std::min(std::max(c, cuts[k - 1]), cuts[k + 1]);
+        }
+        // Keep every slab at least as wide as the buffer
+        for(int k = 1; k < procs; k++)     newCuts[k] = std::max(newCuts[k], newCuts[k - 1] + minWidth);
+        for(int k = procs - 1; k > 0; k--) newCuts[k] = std::min(newCuts[k], newCuts[k + 1] - minWidth);
+        for(int k = 1; k <= procs; k++){
+          if(newCuts[k] - newCuts[k - 1] < minWidth){
+            newCuts = cuts;
+            break;
+          }
+        }
+      }
+    }
+    boost::mpi::broadcast(*comm, newCuts, 0);
+
+    if(newCuts != cuts){
+      for(int k = 1; k < procs; k++) fractions[i][k] = (double)newCuts[k] / (double)cells;
+      changed = true;
+    }
+  }
+
+  if(changed){
+    cartTopology->setPartition(fractions);
+    balance();
+  }
+  return changed;
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-bool SharedBaseGrid<T, GPTransformer, Adder, GPType>::moveTo(const AgentId& id, const std::vector<GPType>& newLocation) {
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+bool SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::moveTo(const AgentId& id, const Point<GPType>& newLocation) {
+	return SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::moveTo(id, newLocation.coords());
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+bool SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::moveTo(const AgentId& id, const std::vector<GPType>& newLocation) {
 	return GridBaseType::moveTo(id, newLocation);
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::removeAgent(T* agent) {
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::removeAgent(T* agent) {
 	GridBaseType::removeAgent(agent);
 }
 
 
 // Beta
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush){
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush){
 
   if(_buffer == 0) return; // A buffer zone of zero means that no agents will be pushed.
+  updatePartition();
 
   int numDims = localBounds.dimensionCount();
   RelativeLocation relLocOrig(numDims);
@@ -445,40 +624,35 @@ void SharedBaseGrid<T, GPTransformer, Adder, GPType>::getAgentsToPush(std::set<A
 
 
   // Local agents that are in other processes' 'buffer zones' must be exported to those other processes.
+  // Agents found are removed from the set to test in bulk, once all have been tested
   int r = comm->rank();
-  std::set<AgentId>::iterator idIter = agentsToTest.begin();
-  while(idIter != agentsToTest.end()){
-    AgentId id = *idIter;
-    bool found = false;
+  AgentIdSet found;
+  std::vector<GPType> locationVector;
+  for(AgentIdSet::const_iterator idIter = agentsToTest.begin(), idIterEnd = agentsToTest.end(); idIter != idIterEnd; ++idIter){
+    const AgentId& id = *idIter;
+    bool pushed = false;
     if(id.currentRank() == r){ // Local agents only
-      std::vector<GPType> locationVector;
       GridBaseType::getLocation(id, locationVector);
       Point<GPType> loc(locationVector);
       if(!unbuffered.contains(loc)){
         for(int i = 0; i < numOutgoing; i++){
           if((outgoing[i] > 0) && (outgoing[i]->contains(loc))){
             agentsToPush[outRanks[i]].insert(id);
-            found = true;
+            pushed = true;
           }
         }
       }
     }
-    if(found){
-      std::set<AgentId>::iterator tmp = idIter;
-      idIter++;
-      agentsToTest.erase(tmp);
-    }
-    else{
-      idIter++;
-    }
+    if(pushed) found.insert(id);
   }
+  agentsToTest.erase(found);
 //  if(NW_set.size() > 0) agentsToPush[NW_rank].insert(NW_set.begin(), NW_set.end());
   delete[] outgoing;
   delete[] outRanks;
 }
 
-template<typename T, typename GPTransformer, typename Adder, typename GPType>
-void SharedBaseGrid<T, GPTransformer, Adder, GPType>::updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context){
+template<typename T, typename GPTransformer, typename Adder, typename GPType, typename CellAccessor>
+void SharedBaseGrid<T, GPTransformer, Adder, GPType, CellAccessor>::updateProjectionInfo(ProjectionInfoPacket* pip, Context<T>* context){
   SpecializedProjectionInfoPacket<GPType>* spip = static_cast<SpecializedProjectionInfoPacket<GPType>*>(pip);
   synchMoveTo(spip->id, spip->data);
 }
@@ -109,6 +109,14 @@ void rpRemoveAgent(const AgentId& id);
  * whose behavior is run on the SharedContext's process and foreign agents,
  * that is, copies of agents whose behavior is run on some other process.
  *
+ * When delta state synchronization is on (see
+ * RepastProcess::setDeltaAgentStateSync), a model must call
+ * RepastProcess::instance()->markAgentDirty(id) whenever it changes the state
+ * of a local agent in this context, and before the next call to
+ * synchronizeAgentStates. Copies of unmarked agents on other processes keep
+ * the state they last received. Agents added with addAgent or moved here by
+ * synchronizeAgentStatus need not be marked.
+ *
  * @param T the type of agents in the context.
  */
 template<typename T>
@@ -126,6 +134,29 @@ private:
 	RefMap projRefMap;
 	int _rank;
 
+	typedef typename std::vector<boost::shared_ptr<T> > AgentList;
+
+	// where an agent is in the local or non-local agent list
+	struct ListPosition {
+		bool local;
+		size_t index;
+	};
+	typedef typename boost::unordered_map<AgentId, ListPosition, HashId> PositionMap;
+
+	// the local and non-local agents, kept up to date as agents are added,
+	// removed and change rank so that iterating over either is a walk
+	// along a vector rather than a filtered walk over all the agents
+	AgentList localAgents;
+	AgentList nonLocalAgents;
+	PositionMap listPositions;
+
+	void listAgent(const boost::shared_ptr<T>& agent, bool local);
+	boost::shared_ptr<T> unlistAgent(const AgentId& id);
+
+protected:
+	virtual void agentAdded(const boost::shared_ptr<T>& agent);
+	virtual void agentRemoved(const AgentId& id);
+
 public:
 
 	// Create single instances for these and reuse them
@@ -136,20 +167,27 @@ public:
   // For more efficient 'push' during projection sync
   std::vector<std::string> getAgentsToPushProjOrder;
 
-	typedef typename boost::filter_iterator<IsLocalAgent<T> , typename Context<T>::const_iterator> const_local_iterator;
+	typedef typename AgentList::const_iterator const_local_iterator;
 
-  typedef typename boost::filter_iterator<AgentStateFilter<T> , typename Context<T>::const_iterator>        const_state_aware_iterator;
+  typedef typename AgentList::const_iterator                                                   const_state_aware_iterator;
   typedef typename boost::filter_iterator<AgentStateFilter<T> , typename Context<T>::const_bytype_iterator> const_state_aware_bytype_iterator;
 
   typedef typename Projection<T>::RADIUS RADIUS;
 
-	SharedContext(boost::mpi::communicator* comm);
+	/**
+	 * Creates a SharedContext on the communicator, storing its agents as specified.
+	 *
+	 * @param comm the communicator
+	 * @param storage how the agents are stored
+	 */
+	SharedContext(boost::mpi::communicator* comm, typename Context<T>::STORAGE storage = Context<T>::HASH_MAP);
 	virtual ~SharedContext();
 
 	/**
 	 * Gets the start of iterator over the local agents in this context.
 	 * The iterator derefrences into shared_ptr<T>. The actual
 	 * agent can be accessed by dereferencing the iter: (*iter)->getId() for example.
+	 * Adding or removing agents invalidates the iterator.
 	 *
 	 * @return the start of iterator over the local agents in this context.
 	 */
@@ -189,6 +227,16 @@ public:
 	 */
 	void importedAgentRemoved(const AgentId& id);
 
+	/**
+	 * Sets the current rank of the specified agent, moving it between the
+	 * local and non-local agents if that changes. The current rank of an
+	 * agent in this context should only be changed through this method.
+	 *
+	 * @param agent the agent, which must be in this context
+	 * @param rank the agent's new current rank
+	 */
+	void updateAgentRank(T* agent, int rank);
+
 	/**
 	 * Increments the projection reference count for the specified
 	 * agent.
@@ -227,7 +275,8 @@ public:
     using Context<T>::size;
 	
 	/**
-	 * Gets the start of an iterator that will iterate over only local or non-local agents
+	 * Gets the start of an iterator that will iterate over only local or non-local agents.
+	 * Adding or removing agents invalidates the iterator.
 	 *
 	 * @param local flag indicating whether local or non-local agents are to be included
 	 */
@@ -764,22 +813,22 @@ public:
    * Given a set of agents to test, returns the set of those agents that must be kept in order
    * to keep required projection information.
    */
-  void getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsToKeep, RADIUS radius = Projection<T>::PRIMARY);
+  void getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsToKeep, RADIUS radius = Projection<T>::PRIMARY);
 
   /**
    * Given an initial set of agents that must be kept a priori, add any agents that must be kept due to
    * projection requirements, and return the set of all non-local agents that can be dropped.
    */
-  void getNonlocalAgentsToDrop(std::set<AgentId>& agentsToKeep, std::set<AgentId>& agentsToDrop, RADIUS radius = Projection<T>::PRIMARY);
+  void getNonlocalAgentsToDrop(AgentIdSet& agentsToKeep, AgentIdSet& agentsToDrop, RADIUS radius = Projection<T>::PRIMARY);
 
-  void getAgentsToPushToOtherProcesses(std::map<int, std::set<AgentId> >& agentsToPush);
+  void getAgentsToPushToOtherProcesses(std::map<int, AgentIdSet>& agentsToPush);
 
   virtual void addProjection(Projection<T>* projection);
 
 };
 
 template<typename T>
-SharedContext<T>::SharedContext(boost::mpi::communicator* comm) : Context<T> (), _rank(comm->rank()), localPredicate(comm->rank()),
+SharedContext<T>::SharedContext(boost::mpi::communicator* comm, typename Context<T>::STORAGE storage) : Context<T> (storage), _rank(comm->rank()), localPredicate(comm->rank()),
   LOCAL_FILTER(true, comm->rank()),
   NON_LOCAL_FILTER(false, comm->rank()){
 }
@@ -835,41 +884,83 @@ void SharedContext<T>::decrementProjRefCount(const AgentId& id) {
 
 }
 
+template<typename T>
+void SharedContext<T>::updateAgentRank(T* agent, int rank) {
+	bool wasLocal = agent->getId().currentRank() == _rank;
+	agent->getId().currentRank(rank);
+	if (wasLocal != (rank == _rank)) listAgent(unlistAgent(agent->getId()), rank == _rank);
+}
+
+template<typename T>
+void SharedContext<T>::agentAdded(const boost::shared_ptr<T>& agent) {
+	listAgent(agent, agent->getId().currentRank() == _rank);
+}
+
+template<typename T>
+void SharedContext<T>::agentRemoved(const AgentId& id) {
+	unlistAgent(id);
+}
+
+template<typename T>
+void SharedContext<T>::listAgent(const boost::shared_ptr<T>& agent, bool local) {
+	AgentList& list = local ? localAgents : nonLocalAgents;
+	ListPosition position = { local, list.size() };
+	list.push_back(agent);
+	listPositions[agent->getId()] = position;
+}
+
+template<typename T>
+boost::shared_ptr<T> SharedContext<T>::unlistAgent(const AgentId& id) {
+	typename PositionMap::iterator iter = listPositions.find(id);
+	ListPosition position = iter->second;
+	listPositions.erase(iter);
+
+	// the last agent in the list takes the place of the one removed
+	AgentList& list = position.local ? localAgents : nonLocalAgents;
+	boost::shared_ptr<T> agent = list[position.index];
+	if (position.index + 1 < list.size()) {
+		list[position.index] = list.back();
+		listPositions[list[position.index]->getId()].index = position.index;
+	}
+	list.pop_back();
+	return agent;
+}
+
 // Local Agents Only
 
 template<typename T>
-boost::filter_iterator<IsLocalAgent<T> , typename Context<T>::const_iterator> SharedContext<T>::localBegin() const {
-	return const_local_iterator(localPredicate, Context<T>::begin(), Context<T>::end());
+typename SharedContext<T>::const_local_iterator SharedContext<T>::localBegin() const {
+	return localAgents.begin();
 }
 
 template<typename T>
-boost::filter_iterator<IsLocalAgent<T> , typename Context<T>::const_iterator> SharedContext<T>::localEnd() const {
-	return const_local_iterator(localPredicate, Context<T>::end(), Context<T>::end());
+typename SharedContext<T>::const_local_iterator SharedContext<T>::localEnd() const {
+	return localAgents.end();
 }
 
 
 // Iterator creation
 
 template<typename T>
-boost::filter_iterator<AgentStateFilter<T> , typename Context<T>::const_iterator> SharedContext<T>::begin(filterLocalFlag local){
-	if(local) return const_state_aware_iterator(LOCAL_FILTER, Context<T>::begin(), Context<T>::end());
-	else      return const_state_aware_iterator(NON_LOCAL_FILTER, Context<T>::begin(), Context<T>::end());
+typename SharedContext<T>::const_state_aware_iterator SharedContext<T>::begin(filterLocalFlag local){
+	if(local) return localAgents.begin();
+	else      return nonLocalAgents.begin();
 }
 
 template<typename T>
-boost::filter_iterator<AgentStateFilter<T> , typename Context<T>::const_iterator> SharedContext<T>::end(filterLocalFlag local){
-	if(local) return const_state_aware_iterator(LOCAL_FILTER, Context<T>::end(), Context<T>::end());
-	else      return const_state_aware_iterator(NON_LOCAL_FILTER, Context<T>::end(), Context<T>::end());
+typename SharedContext<T>::const_state_aware_iterator SharedContext<T>::end(filterLocalFlag local){
+	if(local) return localAgents.end();
+	else      return nonLocalAgents.end();
 }
 
 template<typename T>
-boost::filter_iterator<AgentStateFilter<T> , typename Context<T>::const_bytype_iterator> SharedContext<T>::byTypeBegin(filterLocalFlag local, int type){
+typename SharedContext<T>::const_state_aware_bytype_iterator SharedContext<T>::byTypeBegin(filterLocalFlag local, int type){
 	if(local) return const_state_aware_bytype_iterator(LOCAL_FILTER, Context<T>::byTypeBegin(type), Context<T>::byTypeEnd(type));
 	else      return const_state_aware_bytype_iterator(NON_LOCAL_FILTER, Context<T>::byTypeBegin(type), Context<T>::byTypeEnd(type));
 }
 
 template<typename T>
-boost::filter_iterator<AgentStateFilter<T> , typename Context<T>::const_bytype_iterator> SharedContext<T>::byTypeEnd(filterLocalFlag local, int type){
+typename SharedContext<T>::const_state_aware_bytype_iterator SharedContext<T>::byTypeEnd(filterLocalFlag local, int type){
 	if(local) return const_state_aware_bytype_iterator(LOCAL_FILTER, Context<T>::byTypeEnd(type), Context<T>::byTypeEnd(type));
 	else      return const_state_aware_bytype_iterator(NON_LOCAL_FILTER, Context<T>::byTypeEnd(type), Context<T>::byTypeEnd(type));
 }
@@ -1047,44 +1138,32 @@ void SharedContext<T>::getAgentStatusInfoExchangePartners(std::set<int>& sends,
 
 
 template<typename T>
-void SharedContext<T>::getRequiredAgents(std::set<AgentId>& agentsToTest, std::set<AgentId>& agentsToKeep, RADIUS radius){
+void SharedContext<T>::getRequiredAgents(AgentIdSet& agentsToTest, AgentIdSet& agentsToKeep, RADIUS radius){
   typename std::vector<Projection<T> *>::iterator iter    = Context<T>::projections.begin();
   typename std::vector<Projection<T> *>::iterator iterEnd = Context<T>::projections.end();
-  while((iter != iterEnd) && (agentsToTest.size() > 0)){
+  while((iter != iterEnd) && !agentsToTest.empty()){
     (*iter)->getRequiredAgents(agentsToTest, agentsToKeep, radius);
     iter++;
   }
 }
 
 template<typename T>
-void SharedContext<T>::getNonlocalAgentsToDrop(std::set<AgentId>& agentsToKeep, std::set<AgentId>& agentsToDrop, RADIUS radius){
-  if(agentsToKeep.size() > 0){
-    const_state_aware_iterator iter = begin(NON_LOCAL), iterEnd = end(NON_LOCAL);
-    std::set<AgentId>::iterator notFound = agentsToKeep.end();
-    while(iter != iterEnd){
-      AgentId id = (*iter)->getId();
-      if(agentsToKeep.find(id) == notFound) agentsToDrop.insert((*iter)->getId());
-      iter++;
-    }
-  }
-  else{
-    const_state_aware_iterator iter = begin(NON_LOCAL), iterEnd = end(NON_LOCAL);
-    while(iter != iterEnd){
-      agentsToDrop.insert((*iter)->getId());
-      iter++;
-    }
+void SharedContext<T>::getNonlocalAgentsToDrop(AgentIdSet& agentsToKeep, AgentIdSet& agentsToDrop, RADIUS radius){
+  const_state_aware_iterator iter = begin(NON_LOCAL), iterEnd = end(NON_LOCAL);
+  while(iter != iterEnd){
+    agentsToDrop.insert((*iter)->getId());
+    iter++;
   }
+  agentsToDrop.erase(agentsToKeep);
   getRequiredAgents(agentsToDrop, agentsToKeep, radius);
 }
 
 template<typename T>
-void SharedContext<T>::getAgentsToPushToOtherProcesses(std::map<int, std::set<AgentId> >& agentsToPush){
-  std::vector<AgentId> tmp;
-  std::set<AgentId> agentsToTest;
+void SharedContext<T>::getAgentsToPushToOtherProcesses(std::map<int, AgentIdSet>& agentsToPush){
+  AgentIdSet agentsToTest;
   for(const_state_aware_iterator iter = begin(LOCAL), iterEnd = end(LOCAL); iter != iterEnd; ++iter){
-    tmp.push_back((*iter)->getId());
+    agentsToTest.insert((*iter)->getId());
   }
-  agentsToTest.insert(tmp.begin(), tmp.end());
   for(typename std::vector<std::string>::iterator iter = getAgentsToPushProjOrder.begin(), iterEnd = getAgentsToPushProjOrder.end(); iter != iterEnd; iter++){
      Context<T>::getProjection(*iter)->getAgentsToPush(agentsToTest, agentsToPush);
   }
@@ -41,16 +41,20 @@
 #ifndef SHAREDCONTINUOUSSPACE_H_
 #define SHAREDCONTINUOUSSPACE_H_
 
+#include <limits>
+#include <algorithm>
 #include <boost/mpi/communicator.hpp>
 
 #include "SharedBaseGrid.h"
+#include "BinnedOccupancy.h"
 
 namespace repast {
 
 /**
  * Continuous space SharedBaseGrid implementation. This
  * primarily adds the buffer synchronization appropriate for this
- * type. Default templated typical SharedContinuousSpaces are defined in SharedGrids.
+ * type and queries for the agents within a radius or a box.
+ * Default templated typical SharedContinuousSpaces are defined in SharedGrids.
  *
  * @see SharedBaseGrid for more details.
  *
@@ -58,31 +62,127 @@ namespace repast {
  * @tparam GPTransformer transforms cell points according to the topology (e.g. periodic)
  * of the BaseGrid.
  * @tparam Adder determines how objects are added to the grid from its associated context.
+ * @tparam CellAccessor implements the storage of the space's locations. The default
+ * BinnedOccupancy sorts the agents into uniform bins, which getAgentsWithin and
+ * getAgentsInBox require.
  */
-template<typename T, typename GPTransformer, typename Adder>
-class SharedContinuousSpace: public SharedBaseGrid<T, GPTransformer, Adder, double> {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor = BinnedOccupancy<T, double> >
+class SharedContinuousSpace: public SharedBaseGrid<T, GPTransformer, Adder, double, CellAccessor> {
 
 protected:
 	virtual void synchMoveTo(const AgentId& id, const Point<double>& pt);
 
 private:
 
-	typedef SharedBaseGrid<T, GPTransformer, Adder, double> SharedBaseGridType;
+	typedef SharedBaseGrid<T, GPTransformer, Adder, double, CellAccessor> SharedBaseGridType;
+
+	/**
+	 * Gets the agents in the box from lower to upper, and within the radius
+	 * of the center if center is not null, from the cell accessor. If the
+	 * space is periodic, the parts of the box beyond the borders are looked
+	 * for on the opposite side of the space.
+	 */
+	template<typename Out>
+	void doGetAgents(const std::vector<double>& lower, const std::vector<double>& upper, const Point<double>* center,
+			double radius, std::vector<Out>& out) const;
+
+	void getFromCells(const std::vector<double>& lower, const std::vector<double>& upper, const Point<double>* center,
+			double radius, std::vector<T*>& out) const;
+
+	void getFromCells(const std::vector<double>& lower, const std::vector<double>& upper, const Point<double>* center,
+			double radius, std::vector<std::pair<double, T*> >& out) const;
+
+	bool doGetNearestAgents(const Point<double>& center, int k, int type, std::vector<T*>& out) const;
 
 public:
 	virtual ~SharedContinuousSpace();
 	SharedContinuousSpace(std::string name, GridDimensions gridDims, std::vector<int> processDims, int buffer, boost::mpi::communicator* communicator);
 
+	/**
+	 * Sets the width of the bins that the agents are sorted into. A width close to
+	 * the radius of the typical getAgentsWithin query is usually fastest. This
+	 * defaults to 1.
+	 *
+	 * @param width the bin width
+	 */
+	void setBinWidth(double width) {
+		SharedBaseGridType::GridBaseType::cellAccessor.setBinWidth(width);
+	}
+
+	/**
+	 * Gets the agents in this part of the space, including its buffer, that are
+	 * within the specified distance of the specified center. If the space is
+	 * periodic, the distance is measured across the borders, and the radius
+	 * must be less than half of the extent of the space in each dimension.
+	 *
+	 * @param center the center
+	 * @param radius the distance
+	 * @param [out] out the found agents will be added to this vector
+	 */
+	void getAgentsWithin(const Point<double>& center, double radius, std::vector<T*>& out) const;
+
+	/**
+	 * Gets the agents in this part of the space, including its buffer, whose
+	 * locations are within the box with the specified lower and upper corners,
+	 * including its borders. If the space is periodic, a box that extends over a
+	 * border continues on the opposite side of the space; the box must be smaller
+	 * than the space in each dimension.
+	 *
+	 * @param lower the lower corner of the box
+	 * @param upper the upper corner of the box
+	 * @param [out] out the found agents will be added to this vector
+	 */
+	void getAgentsInBox(const Point<double>& lower, const Point<double>& upper, std::vector<T*>& out) const;
+
+	/**
+	 * Gets the k agents in this part of the space, including its buffer, that are
+	 * nearest to the specified center, nearest first. An agent at the center is
+	 * included. If the space is periodic, distances are measured across the borders.
+	 *
+	 * Agents beyond the buffer are not known to this process, so the result may be
+	 * incomplete if the kth nearest agent is farther from the center than the outer
+	 * edge of the buffer, or if fewer than k agents are found. This is reported by
+	 * returning false.
+	 *
+	 * @param center the center
+	 * @param k the number of agents to get
+	 * @param [out] out the found agents will be added to this vector
+	 *
+	 * @return true if no agent beyond the buffer can be nearer than the found
+	 * agents, otherwise false.
+	 */
+	bool getNearestAgents(const Point<double>& center, int k, std::vector<T*>& out) const {
+		return doGetNearestAgents(center, k, -1, out);
+	}
+
+	/**
+	 * Gets the k agents of the specified type in this part of the space, including
+	 * its buffer, that are nearest to the specified center, nearest first.
+	 *
+	 * @see getNearestAgents(const Point<double>&, int, std::vector<T*>&)
+	 *
+	 * @param center the center
+	 * @param k the number of agents to get
+	 * @param type the type of the agents to get
+	 * @param [out] out the found agents will be added to this vector
+	 *
+	 * @return true if no agent beyond the buffer can be nearer than the found
+	 * agents, otherwise false.
+	 */
+	bool getNearestAgents(const Point<double>& center, int k, int type, std::vector<T*>& out) const {
+		return doGetNearestAgents(center, k, type, out);
+	}
+
 };
 
-template<typename T, typename GPTransformer, typename Adder>
-SharedContinuousSpace<T, GPTransformer, Adder>::SharedContinuousSpace(std::string name, GridDimensions gridDims,
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::SharedContinuousSpace(std::string name, GridDimensions gridDims,
 		std::vector<int> processDims, int buffer, boost::mpi::communicator* communicator) :
-	SharedBaseGrid<T, GPTransformer, Adder, double> (name, gridDims, processDims, buffer, communicator) {
+	SharedBaseGrid<T, GPTransformer, Adder, double, CellAccessor> (name, gridDims, processDims, buffer, communicator) {
 }
 
-template<typename T, typename GPTransformer, typename Adder>
-void SharedContinuousSpace<T, GPTransformer, Adder>::synchMoveTo(const AgentId& id, const Point<double>& pt) {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::synchMoveTo(const AgentId& id, const Point<double>& pt) {
 	//unlikely chance that agent could have
 	// moved and then "died" and so removed from sending context, in which case
 	// it would never get sent to this grid.
@@ -91,9 +191,164 @@ void SharedContinuousSpace<T, GPTransformer, Adder>::synchMoveTo(const AgentId&
 	}
 }
 
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::getAgentsWithin(const Point<double>& center, double radius,
+		std::vector<T*>& out) const {
+	std::vector<double> lower, upper;
+	for (size_t i = 0, n = center.dimensionCount(); i < n; i++) {
+		lower.push_back(center[i] - radius);
+		upper.push_back(center[i] + radius);
+	}
+	doGetAgents(lower, upper, &center, radius, out);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::getAgentsInBox(const Point<double>& lower,
+		const Point<double>& upper, std::vector<T*>& out) const {
+	doGetAgents(lower.coords(), upper.coords(), 0, 0, out);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+template<typename Out>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::doGetAgents(const std::vector<double>& lower,
+		const std::vector<double>& upper, const Point<double>* center, double radius, std::vector<Out>& out) const {
+	const GridDimensions& bounds = SharedBaseGridType::globalBounds;
+	size_t dimCount = lower.size();
+
+	// The shifts that bring each part of the box that is beyond a border
+	// of a periodic space to the opposite side
+	std::vector<std::vector<double> > shifts(dimCount, std::vector<double>(1, 0));
+	if (SharedBaseGridType::GridBaseType::gpTransformer.isPeriodic()) {
+		for (size_t i = 0; i < dimCount; i++) {
+			if (lower[i] < bounds.origin(i)) shifts[i].push_back(bounds.extents(i));
+			if (upper[i] >= bounds.origin(i) + bounds.extents(i)) shifts[i].push_back(-bounds.extents(i));
+		}
+	}
+
+	std::vector<size_t> shiftIndex(dimCount, 0);
+	std::vector<double> shiftedLower(lower), shiftedUpper(upper);
+	while (true) {
+		for (size_t i = 0; i < dimCount; i++) {
+			double shift = shifts[i][shiftIndex[i]];
+			shiftedLower[i] = lower[i] + shift;
+			shiftedUpper[i] = upper[i] + shift;
+		}
+		if (center == 0) {
+			getFromCells(shiftedLower, shiftedUpper, 0, radius, out);
+		} else {
+			std::vector<double> shiftedCenter(dimCount);
+			for (size_t i = 0; i < dimCount; i++) shiftedCenter[i] = (*center)[i] + shifts[i][shiftIndex[i]];
+			Point<double> shiftedPt(shiftedCenter);
+			getFromCells(shiftedLower, shiftedUpper, &shiftedPt, radius, out);
+		}
+
+		size_t i = 0;
+		while (i < dimCount && shiftIndex[i] == shifts[i].size() - 1) {
+			shiftIndex[i] = 0;
+			i++;
+		}
+		if (i == dimCount) break;
+		shiftIndex[i]++;
+	}
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::getFromCells(const std::vector<double>& lower,
+		const std::vector<double>& upper, const Point<double>* center, double radius, std::vector<T*>& out) const {
+	if (center == 0) SharedBaseGridType::GridBaseType::cellAccessor.getAllInBox(lower, upper, out);
+	else             SharedBaseGridType::GridBaseType::cellAccessor.getAllWithin(*center, radius, out);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::getFromCells(const std::vector<double>& lower,
+		const std::vector<double>& upper, const Point<double>* center, double radius,
+		std::vector<std::pair<double, T*> >& out) const {
+	SharedBaseGridType::GridBaseType::cellAccessor.getAllWithin(*center, radius, out);
+}
+
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+bool SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::doGetNearestAgents(const Point<double>& center, int k,
+		int type, std::vector<T*>& out) const {
+	if (k <= 0) return true;
+
+	const GridDimensions& bounds = SharedBaseGridType::globalBounds;
+	const GridDimensions& local = SharedBaseGridType::localBounds;
+	double buffer = SharedBaseGridType::_buffer;
+	bool periodic = SharedBaseGridType::GridBaseType::gpTransformer.isPeriodic();
+	size_t dimCount = center.dimensionCount();
+
+	// The distance beyond which there are no agents in this part of the space,
+	// and the distance within which this part of the space sees every agent
+	double maxRadiusSq = 0;
+	double seen = std::numeric_limits<double>::max();
+	double minExtent = std::numeric_limits<double>::max();
+	for (size_t i = 0; i < dimCount; i++) {
+		double globalLower = bounds.origin(i);
+		double globalUpper = bounds.origin(i) + bounds.extents(i);
+		double lower = local.origin(i) - buffer;
+		double upper = local.origin(i) + local.extents(i) + buffer;
+		double farthest;
+		minExtent = std::min(minExtent, bounds.extents(i));
+		if (periodic) {
+			farthest = bounds.extents(i) / 2;
+			if (local.extents(i) + 2 * buffer < bounds.extents(i)) seen = std::min(seen, std::min(center[i] - lower, upper - center[i]));
+		} else {
+			farthest = std::max(std::abs(center[i] - globalLower), std::abs(globalUpper - center[i]));
+			if (lower > globalLower) seen = std::min(seen, center[i] - lower);
+			if (upper < globalUpper) seen = std::min(seen, upper - center[i]);
+		}
+		maxRadiusSq += farthest * farthest;
+	}
+	double maxRadius = sqrt(maxRadiusSq);
+
+	// Widen the search until it finds k agents; the k nearest of these are the
+	// k nearest of all, as any agent not found is farther than all those found.
+	std::vector<std::pair<double, T*> > found;
+	double radius = SharedBaseGridType::GridBaseType::cellAccessor.getBinWidth();
+	while (true) {
+		bool last = radius >= maxRadius;
+		if (last) radius = maxRadius;
+
+		std::vector<double> lower, upper;
+		for (size_t i = 0; i < dimCount; i++) {
+			lower.push_back(center[i] - radius);
+			upper.push_back(center[i] + radius);
+		}
+		found.clear();
+		doGetAgents(lower, upper, &center, radius, found);
+
+		size_t kept = 0;
+		for (size_t i = 0; i < found.size(); i++) {
+			if (type < 0 || found[i].second->getId().agentType() == type) found[kept++] = found[i];
+		}
+		found.resize(kept);
+
+		// A periodic search as wide as the space can find the same agent
+		// on both sides; keep only its nearest image.
+		if (periodic && 2 * radius >= minExtent) {
+			std::vector<std::pair<T*, double> > byAgent;
+			for (size_t i = 0; i < found.size(); i++) byAgent.push_back(std::make_pair(found[i].second, found[i].first));
+			std::sort(byAgent.begin(), byAgent.end());
+			found.clear();
+			for (size_t i = 0; i < byAgent.size(); i++) {
+				if (i == 0 || byAgent[i].first != byAgent[i - 1].first) found.push_back(std::make_pair(byAgent[i].second, byAgent[i].first));
+			}
+		}
+		std::sort(found.begin(), found.end());
+
+		if ((int) found.size() >= k || last) break;
+		radius *= 2;
+	}
+
+	if ((int) found.size() > k) found.resize(k);
+	for (size_t i = 0; i < found.size(); i++) out.push_back(found[i].second);
+
+	if ((int) found.size() < k) return seen == std::numeric_limits<double>::max();
+	return sqrt(found.back().first) <= seen;
+}
 
-template<typename T, typename GPTransformer, typename Adder>
-SharedContinuousSpace<T, GPTransformer, Adder>::~SharedContinuousSpace() {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+SharedContinuousSpace<T, GPTransformer, Adder, CellAccessor>::~SharedContinuousSpace() {
 }
 
 }
@@ -44,6 +44,7 @@
 #include <boost/mpi/communicator.hpp>
 
 #include "SharedBaseGrid.h"
+#include "DenseOccupancy.h"
 
 namespace repast {
 
@@ -58,33 +59,36 @@ namespace repast {
  * @tparam GPTransformer transforms cell points according to the topology (e.g. periodic)
  * of the BaseGrid.
  * @tparam Adder determines how objects are added to the grid from its associated context.
+ * @tparam CellAccessor implements the storage of the grid's locations. DenseOccupancy
+ * keeps the locations in an array, which is faster to query than the default
+ * MultipleOccupancy map when the local grid is densely populated.
  */
-template<typename T, typename GPTransformer, typename Adder>
-class SharedDiscreteSpace: public SharedBaseGrid<T, GPTransformer, Adder, int> {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor = MultipleOccupancy<T, int> >
+class SharedDiscreteSpace: public SharedBaseGrid<T, GPTransformer, Adder, int, CellAccessor> {
 
 protected:
 	virtual void synchMoveTo(const AgentId& id, const Point<int>& pt);
 
 private:
 
-	typedef SharedBaseGrid<T, GPTransformer, Adder, int> SharedBaseGridType;
+	typedef SharedBaseGrid<T, GPTransformer, Adder, int, CellAccessor> SharedBaseGridType;
 
 public:
 	virtual ~SharedDiscreteSpace();
 	SharedDiscreteSpace(std::string name, GridDimensions gridDims, std::vector<int> processDims, int buffer, boost::mpi::communicator* communicator);
 
-//  virtual void getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush);
+//  virtual void getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush);
 
 };
 
-template<typename T, typename GPTransformer, typename Adder>
-SharedDiscreteSpace<T, GPTransformer, Adder>::SharedDiscreteSpace(std::string name, GridDimensions gridDims,
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+SharedDiscreteSpace<T, GPTransformer, Adder, CellAccessor>::SharedDiscreteSpace(std::string name, GridDimensions gridDims,
 		std::vector<int> processDims, int buffer, boost::mpi::communicator* communicator) :
-	SharedBaseGrid<T, GPTransformer, Adder, int> (name, gridDims, processDims, buffer, communicator) {
+	SharedBaseGrid<T, GPTransformer, Adder, int, CellAccessor> (name, gridDims, processDims, buffer, communicator) {
 }
 
-template<typename T, typename GPTransformer, typename Adder>
-void SharedDiscreteSpace<T, GPTransformer, Adder>::synchMoveTo(const AgentId& id, const Point<int>& pt) {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+void SharedDiscreteSpace<T, GPTransformer, Adder, CellAccessor>::synchMoveTo(const AgentId& id, const Point<int>& pt) {
 	//unlikely chance that agent could have
 	// moved and then "died" and so removed from sending context, in which case
 	// it would never get sent to this grid.
@@ -94,13 +98,13 @@ void SharedDiscreteSpace<T, GPTransformer, Adder>::synchMoveTo(const AgentId& id
 }
 
 
-template<typename T, typename GPTransformer, typename Adder>
-SharedDiscreteSpace<T, GPTransformer, Adder>::~SharedDiscreteSpace() {
+template<typename T, typename GPTransformer, typename Adder, typename CellAccessor>
+SharedDiscreteSpace<T, GPTransformer, Adder, CellAccessor>::~SharedDiscreteSpace() {
 }
 
 
 //template<typename T, typename GPTransformer, typename Adder>
-//void SharedDiscreteSpace<T, GPTransformer, Adder>::getAgentsToPush(std::set<AgentId>& agentsToTest, std::map<int, std::set<AgentId> >& agentsToPush){
+//void SharedDiscreteSpace<T, GPTransformer, Adder>::getAgentsToPush(AgentIdSet& agentsToTest, std::map<int, AgentIdSet>& agentsToPush){
 //
 //  int buffer = SharedBaseGrid<T, GPTransformer, Adder, int>::_buffer;
 //  if(buffer == 0) return; // A buffer zone of zero means that no agents will be pushed.
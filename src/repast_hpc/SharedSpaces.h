@@ -66,6 +66,22 @@ struct SharedSpaces {
 	 */
 	typedef SharedDiscreteSpace<T, StrictBorders, SimpleAdder<T> > SharedStrictDiscreteSpace;
 
+	/**
+	 * Discrete grid space with periodic (toroidal) borders whose locations
+	 * are kept in an array rather than a map. Any added
+	 * agents are not given a location, but are in "grid limbo" until
+	 * moved via a grid move call.
+	 */
+	typedef SharedDiscreteSpace<T, WrapAroundBorders, SimpleAdder<T>, DenseOccupancy<T, int> > SharedDenseWrappedDiscreteSpace;
+
+	/**
+	 * Discrete grid space with strict borders whose locations
+	 * are kept in an array rather than a map. Any added
+	 * agents are not given a location, but are in "grid limbo" until
+	 * moved via a grid move call.
+	 */
+	typedef SharedDiscreteSpace<T, StrictBorders, SimpleAdder<T>, DenseOccupancy<T, int> > SharedDenseStrictDiscreteSpace;
+
 	/**
 	 * Continuous space with periodic (toroidal) borders. Any added
 	 * agents are not given a location, but are in "grid limbo" until
@@ -0,0 +1,201 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  SyncProfiler.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "SyncProfiler.h"
+#include "RepastProcess.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <mpi.h>
+#include <boost/mpi/collectives.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace repast {
+
+namespace {
+
+const int MEASURE_COUNT = 5;
+
+struct Aggregate {
+	int processes;
+	double min[MEASURE_COUNT], max[MEASURE_COUNT], sum[MEASURE_COUNT];
+	Aggregate() : processes(0) {}
+};
+
+}
+
+SyncProfiler* SyncProfiler::instance_ = 0;
+
+SyncProfiler::SyncProfiler() : _file("sync_profile.csv") {
+}
+
+SyncProfiler::~SyncProfiler() {
+	instance_ = 0;
+}
+
+SyncProfiler* SyncProfiler::instance() {
+	if (instance_ == 0)
+		instance_ = new SyncProfiler();
+	return instance_;
+}
+
+const char* SyncProfiler::phaseName(Phase phase) {
+	switch (phase) {
+	case AGENT_STATUS:
+		return "agent_status";
+	case PROJECTION_INFO:
+		return "projection_info";
+	case AGENT_STATES:
+		return "agent_states";
+	case AGENT_REQUEST:
+		return "agent_request";
+	case RETRIEVE_SOURCES:
+		return "retrieve_sources";
+	case VALUE_LAYER:
+		return "value_layer";
+	default:
+		return "unknown";
+	}
+}
+
+void SyncProfiler::begin(Phase phase) {
+	bool nested = std::find(running.begin(), running.end(), phase) != running.end();
+	running.push_back(phase);
+	// A nested begin of a running phase is marked with a negative start time
+	startTimes.push_back(nested ? -1 : MPI_Wtime());
+	startTicks.push_back(RepastProcess::instance()->getScheduleRunner().currentTick());
+}
+
+void SyncProfiler::end(Phase phase) {
+	if (running.empty() || running.back() != phase)
+		return;
+	double start = startTimes.back();
+	if (start >= 0) {
+		Measures& m = current();
+		m.calls++;
+		m.time += MPI_Wtime() - start;
+	}
+	running.pop_back();
+	startTimes.pop_back();
+	startTicks.pop_back();
+}
+
+SyncProfiler::Measures& SyncProfiler::current() {
+	return measures[std::make_pair(startTicks.back(), (int) running.back())];
+}
+
+void SyncProfiler::sent(size_t messages, size_t bytes) {
+	if (running.empty())
+		return;
+	Measures& m = current();
+	m.messages += messages;
+	m.bytes += bytes;
+}
+
+void SyncProfiler::partners(size_t sendPartners, size_t receivePartners) {
+	if (running.empty())
+		return;
+	current().partners += sendPartners + receivePartners;
+}
+
+void SyncProfiler::clear() {
+	measures.clear();
+	running.clear();
+	startTimes.clear();
+	startTicks.clear();
+}
+
+void SyncProfiler::report(boost::mpi::communicator& comm) {
+	// Each record is the tick, the phase and the measures
+	std::vector<double> local;
+	for (std::map<std::pair<double, int>, Measures>::const_iterator iter = measures.begin(); iter != measures.end();
+			++iter) {
+		const Measures& m = iter->second;
+		local.push_back(iter->first.first);
+		local.push_back(iter->first.second);
+		local.push_back(m.calls);
+		local.push_back(m.time);
+		local.push_back(m.messages);
+		local.push_back(m.bytes);
+		local.push_back(m.partners);
+	}
+
+	std::vector<std::vector<double> > all;
+	boost::mpi::gather(comm, local, all, 0);
+	if (comm.rank() != 0)
+		return;
+
+	std::map<std::pair<double, int>, Aggregate> aggregates;
+	for (size_t p = 0; p < all.size(); p++) {
+		const std::vector<double>& records = all[p];
+		for (size_t r = 0; r + MEASURE_COUNT + 2 <= records.size(); r += MEASURE_COUNT + 2) {
+			Aggregate& agg = aggregates[std::make_pair(records[r], (int) records[r + 1])];
+			const double* values = &records[r + 2];
+			for (int i = 0; i < MEASURE_COUNT; i++) {
+				if (agg.processes == 0) {
+					agg.min[i] = agg.max[i] = agg.sum[i] = values[i];
+				} else {
+					agg.min[i] = std::min(agg.min[i], values[i]);
+					agg.max[i] = std::max(agg.max[i], values[i]);
+					agg.sum[i] += values[i];
+				}
+			}
+			agg.processes++;
+		}
+	}
+
+	const char* measureNames[MEASURE_COUNT] = { "calls", "time", "messages", "bytes", "partners" };
+	std::ofstream out(_file.c_str());
+	out << "tick,phase,processes";
+	for (int i = 0; i < MEASURE_COUNT; i++)
+		out << "," << measureNames[i] << "_min," << measureNames[i] << "_max," << measureNames[i] << "_mean";
+	out << std::endl;
+	for (std::map<std::pair<double, int>, Aggregate>::const_iterator iter = aggregates.begin();
+			iter != aggregates.end(); ++iter) {
+		const Aggregate& agg = iter->second;
+		out << iter->first.first << "," << phaseName((Phase) iter->first.second) << "," << agg.processes;
+		for (int i = 0; i < MEASURE_COUNT; i++)
+			out << "," << agg.min[i] << "," << agg.max[i] << "," << agg.sum[i] / agg.processes;
+		out << std::endl;
+	}
+}
+
+}
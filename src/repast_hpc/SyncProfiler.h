@@ -0,0 +1,233 @@
+/*
+ *   Repast for High Performance Computing (Repast HPC)
+ *
+ *   Copyright (c) 2010 Argonne National Laboratory
+ *   All rights reserved.
+ *
+ *   Redistribution and use in source and binary forms, with
+ *   or without modification, are permitted provided that the following
+ *   conditions are met:
+ *
+ *     Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *     Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *     Neither the name of the Argonne National Laboratory nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ *   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ *  SyncProfiler.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef SYNCPROFILER_H_
+#define SYNCPROFILER_H_
+
+/*
+ * If defined, the synchronization phases of RepastProcess, SRManager
+ * and ValueLayerND record their wall time, messages, bytes and partner
+ * counts, and RepastProcess::done() writes a report of them (see
+ * SyncProfiler). Otherwise the instrumentation compiles to nothing.
+ */
+//#define REPAST_SYNC_PROFILING
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/packed_oarchive.hpp>
+#include <boost/mpi/request.hpp>
+
+namespace repast {
+
+/**
+ * Records the cost of the synchronization phases on this process, per phase
+ * per tick: wall time (MPI_Wtime), the number of calls, the number and size
+ * of the messages sent, and the number of send and receive partners.
+ *
+ * Times are inclusive: a phase that runs another (for example agent status
+ * synchronization requesting agents) includes the time of the nested
+ * phase, while messages are counted by the innermost phase that sent them.
+ * An agent state synchronization that is begun and finished separately is
+ * counted as two calls, and its time excludes whatever ran in between.
+ * Bytes are the size of the data sent: the raw MPI buffers, and the packed
+ * archives of the messages serialized with boost::serialization (see
+ * isendSerialized), including any projection information and exporter data
+ * they carry. The size headers boost.mpi sends ahead of serialized messages
+ * are not counted.
+ *
+ * Only compiled in if REPAST_SYNC_PROFILING is defined. report() is called
+ * by RepastProcess::done() and writes, for each tick and phase, the minimum,
+ * maximum and mean of every measure across processes as CSV.
+ */
+class SyncProfiler {
+
+public:
+	/**
+	 * The profiled synchronization phases.
+	 */
+	enum Phase {
+		AGENT_STATUS, PROJECTION_INFO, AGENT_STATES, AGENT_REQUEST, RETRIEVE_SOURCES, VALUE_LAYER, PHASE_COUNT
+	};
+
+	/**
+	 * Times the phase for as long as it is in scope.
+	 */
+	class Scope {
+
+	private:
+		Phase _phase;
+
+	public:
+		Scope(Phase phase) : _phase(phase) {
+			SyncProfiler::instance()->begin(phase);
+		}
+
+		~Scope() {
+			SyncProfiler::instance()->end(_phase);
+		}
+	};
+
+private:
+	struct Measures {
+		double calls, time, messages, bytes, partners;
+		Measures() : calls(0), time(0), messages(0), bytes(0), partners(0) {}
+	};
+
+	static SyncProfiler* instance_;
+
+	std::string _file;
+	std::map<std::pair<double, int>, Measures> measures;
+	std::vector<Phase> running;
+	std::vector<double> startTimes, startTicks;
+
+	SyncProfiler();
+
+	Measures& current();
+
+public:
+	/**
+	 * Gets the singleton instance of this SyncProfiler.
+	 */
+	static SyncProfiler* instance();
+
+	virtual ~SyncProfiler();
+
+	/**
+	 * Gets the name of the phase.
+	 */
+	static const char* phaseName(Phase phase);
+
+	/**
+	 * Gets the size in bytes of count elements of the MPI datatype.
+	 */
+	static size_t bytes(MPI_Datatype datatype, int count = 1) {
+		int size = 0;
+		MPI_Type_size(datatype, &size);
+		return (size_t) size * count;
+	}
+
+	/**
+	 * Sets the file the report is written to. The default is "sync_profile.csv".
+	 */
+	void setFile(const std::string& file) {
+		_file = file;
+	}
+
+	/**
+	 * Starts timing the phase. Phases can be nested; a phase that is
+	 * already running is timed once, from its outermost begin.
+	 */
+	void begin(Phase phase);
+
+	/**
+	 * Stops timing the phase started by the matching begin.
+	 */
+	void end(Phase phase);
+
+	/**
+	 * Records messages sent by the innermost running phase.
+	 *
+	 * @param messages the number of messages
+	 * @param bytes their total size in bytes
+	 */
+	void sent(size_t messages, size_t bytes);
+
+	/**
+	 * Records the partners of the innermost running phase.
+	 *
+	 * @param sendPartners the number of processes sent to
+	 * @param receivePartners the number of processes received from
+	 */
+	void partners(size_t sendPartners, size_t receivePartners);
+
+	/**
+	 * Discards everything recorded so far.
+	 */
+	void clear();
+
+	/**
+	 * Aggregates the measures of all processes in comm and writes them from
+	 * rank 0. This is a collective operation.
+	 */
+	void report(boost::mpi::communicator& comm);
+};
+
+}
+
+#ifdef REPAST_SYNC_PROFILING
+#define REPAST_SYNC_PROFILE(phase) repast::SyncProfiler::Scope repastSyncProfileScope(repast::SyncProfiler::phase)
+#define REPAST_SYNC_SENT(messages, bytes) repast::SyncProfiler::instance()->sent(messages, bytes)
+#define REPAST_SYNC_PARTNERS(sends, receives) repast::SyncProfiler::instance()->partners(sends, receives)
+#else
+#define REPAST_SYNC_PROFILE(phase)
+#define REPAST_SYNC_SENT(messages, bytes)
+#define REPAST_SYNC_PARTNERS(sends, receives)
+#endif
+
+namespace repast {
+
+/**
+ * Starts sending the value to the specified process as comm.isend(dest, tag, value)
+ * does for a type without an MPI datatype, and records the message and its
+ * serialized size with the SyncProfiler. The receiver receives the value with
+ * irecv as usual.
+ *
+ * @param archives the archive the value is serialized into is added to this;
+ * it must be kept until the send has completed
+ */
+template<typename T>
+boost::mpi::request isendSerialized(const boost::mpi::communicator& comm, int dest, int tag, const T& value,
+		std::vector<boost::shared_ptr<boost::mpi::packed_oarchive> >& archives) {
+	boost::shared_ptr<boost::mpi::packed_oarchive> archive(new boost::mpi::packed_oarchive(comm));
+	*archive << value;
+	archives.push_back(archive);
+	REPAST_SYNC_SENT(1, archive->size());
+	return comm.isend(dest, tag, *archive);
+}
+
+}
+
+#endif /* SYNCPROFILER_H_ */
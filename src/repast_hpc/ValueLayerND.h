@@ -257,7 +257,10 @@ private:
 
 protected:
   CartesianTopology*         cartTopology;
+  GridDimensions             globalBoundaries;
   GridDimensions             localBoundaries;
+  int                        bufferSize;             // Size of the buffer zone
+  int                        partitionVersion;       // Version of the topology's partition that localBoundaries reflects
   int                        length;                 // Total length of the entire array (one data space)
 
   int                        numDims;                // Number of dimensions
@@ -284,6 +287,33 @@ protected:
   AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries, int bufferSize, bool periodic);
   virtual ~AbstractValueLayerND();
 
+  /**
+   * Calculates the per-dimension and per-neighbor data for the
+   * current local boundaries
+   */
+  void initGeometry();
+
+  /**
+   * Returns true if the partition of the Cartesian topology has
+   * changed since the local boundaries were set
+   */
+  bool partitionChanged(){
+    return partitionVersion != cartTopology->getPartitionVersion();
+  }
+
+  /**
+   * Updates the local boundaries to the current partition of the
+   * Cartesian topology, replacing each of the data spaces given
+   * with one sized for the new boundaries. The values in the local
+   * cells are sent to the processes that now own them; buffer zones
+   * are left zeroed, to be filled by the next synchronization.
+   * Must be called on all processes.
+   *
+   * @param dataSpaces the data spaces to move; the old arrays are deleted
+   * and the pointers replaced
+   */
+  void repartitionDataSpaces(vector<T*>& dataSpaces);
+
 
 public:
 
@@ -315,6 +345,42 @@ public:
     return localBoundaries;
   }
 
+  /**
+   * Gets the number of dimensions of this value layer
+   *
+   * @return the number of dimensions
+   */
+  int getDimensionCount(){
+    return numDims;
+  }
+
+  /**
+   * Gets the contribution of one coordinate to the index of a cell
+   * in the data space returned by getDataSpace. Summing this over all
+   * dimensions gives the cell's index. The coordinate is in global
+   * simulation coordinates and need not be simplified; on a periodic
+   * layer it is wrapped into the global boundaries first, and a
+   * coordinate held both locally and in the buffer zone resolves to
+   * the local copy.
+   *
+   * @param dimension the dimension of the coordinate
+   * @param coord the coordinate
+   *
+   * @return the index contribution, or -1 if this process does not hold
+   * the coordinate in its local area or buffer zone
+   */
+  int getAxisIndex(int dimension, int coord);
+
+  /**
+   * Gets the base of the currently readable data space, which
+   * getAxisIndex indexes. The pointer is invalidated when the
+   * partition changes and, for layers that switch data spaces,
+   * when the layer is synchronized or switched.
+   *
+   * @return the base pointer of the data space
+   */
+  virtual const T* getDataSpace() = 0;
+
 protected:
   // Methods implemented in this class but visible only to child classes:
 
@@ -474,6 +540,18 @@ protected:
    */
   virtual void synchronize() = 0;
 
+  /**
+   * Moves this layer to the current partition of its Cartesian topology,
+   * if that has changed since the layer was created or last moved (see
+   * SharedBaseGrid::repartition). Each process's local values are sent to
+   * the processes that now own them. This is done at the start of every
+   * synchronize(), so need not be called directly. Must be called on all
+   * processes.
+   *
+   * @return true if the local boundaries changed
+   */
+  virtual bool updatePartition() = 0;
+
 private:
 
   /**
@@ -559,21 +637,33 @@ template<typename T>
 int AbstractValueLayerND<T>::instanceCount = 0;
 
 template<typename T>
-AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries,int bufferSize, bool periodic): globalSpaceIsPeriodic(periodic), syncCount(0){
+AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridDimensions globalBoundaries,int bufferSize, bool periodic): globalBoundaries(globalBoundaries), bufferSize(bufferSize),
+    globalSpaceIsPeriodic(periodic), syncCount(0){
   instanceID = AbstractValueLayerND<T>::instanceCount;
   AbstractValueLayerND<T>::instanceCount++;
   cartTopology = RepastProcess::instance()->getCartesianTopology(processesPerDim, periodic);
+  partitionVersion = cartTopology->getPartitionVersion();
   // Calculate the size to be used for the buffers
   numDims = processesPerDim.size();
 
   int rank = RepastProcess::instance()->rank();
   localBoundaries = cartTopology->getDimensions(rank, globalBoundaries);
 
+  initGeometry();
+}
+
+template<typename T>
+void AbstractValueLayerND<T>::initGeometry(){
+  int rank = RepastProcess::instance()->rank();
+
   // First create the basic coordinate data per dimension
+  dimensionData.clear();
+  places.clear();
+  strides.clear();
   length = 1;
   int val = 1;
   for(int i = 0; i < numDims; i++){
-    DimensionDatum<T> datum(i, globalBoundaries, localBoundaries, bufferSize, periodic);
+    DimensionDatum<T> datum(i, globalBoundaries, localBoundaries, bufferSize, globalSpaceIsPeriodic);
     length *= datum.width;
     dimensionData.push_back(datum);
     places.push_back(val);
@@ -612,6 +702,117 @@ AbstractValueLayerND<T>::AbstractValueLayerND(vector<int> processesPerDim, GridD
   requests = new MPI_Request[neighborCount * 2];
 }
 
+template<typename T>
+void AbstractValueLayerND<T>::repartitionDataSpaces(vector<T*>& dataSpaces){
+  MPI_Comm comm = cartTopology->topologyComm;
+  int rank, worldSize;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &worldSize);
+  partitionVersion = cartTopology->getPartitionVersion();
+
+  // Every process's old local boundaries, as (min, max) for each dimension
+  vector<int> oldBounds(2 * numDims);
+  for(int i = 0; i < numDims; i++){
+    oldBounds[2 * i]     = dimensionData[i].localBoundariesMin;
+    oldBounds[2 * i + 1] = dimensionData[i].localBoundariesMax;
+  }
+  vector<int> allOldBounds(2 * numDims * worldSize);
+  MPI_Allgather(&oldBounds[0], 2 * numDims, MPI_INT, &allOldBounds[0], 2 * numDims, MPI_INT, comm);
+
+  // And every process's new ones
+  vector<int> allNewBounds(2 * numDims * worldSize);
+  for(int r = 0; r < worldSize; r++){
+    GridDimensions dims = cartTopology->getDimensions(r, globalBoundaries);
+    for(int i = 0; i < numDims; i++){
+      allNewBounds[2 * (r * numDims + i)]     = (int)dims.origin(i);
+      allNewBounds[2 * (r * numDims + i) + 1] = (int)(dims.origin(i) + dims.extents(i));
+    }
+  }
+
+  // The cells sent from process 'from' to process 'to' are those in the intersection of
+  // from's old and to's new boundaries; both sides visit them in the same order, lowest
+  // dimension fastest, so only the values need be sent.
+  vector<int> sendCounts(worldSize, 0), sendOffsets(worldSize, 0), recvCounts(worldSize, 0), recvOffsets(worldSize, 0);
+  vector<vector<int> > sendBoxes(worldSize), recvBoxes(worldSize);
+  int sendTotal = 0, recvTotal = 0;
+  for(int r = 0; r < worldSize; r++){
+    vector<int>& sendBox = sendBoxes[r];
+    vector<int>& recvBox = recvBoxes[r];
+    int sendCells = 1, recvCells = 1;
+    for(int i = 0; i < numDims; i++){
+      int sendMin = std::max(oldBounds[2 * i], allNewBounds[2 * (r * numDims + i)]);
+      int sendMax = std::min(oldBounds[2 * i + 1], allNewBounds[2 * (r * numDims + i) + 1]);
+      int recvMin = std::max(allOldBounds[2 * (r * numDims + i)], allNewBounds[2 * (rank * numDims + i)]);
+      int recvMax = std::min(allOldBounds[2 * (r * numDims + i) + 1], allNewBounds[2 * (rank * numDims + i) + 1]);
+      sendBox.push_back(sendMin);
+      sendBox.push_back(sendMax);
+      recvBox.push_back(recvMin);
+      recvBox.push_back(recvMax);
+      sendCells *= std::max(0, sendMax - sendMin);
+      recvCells *= std::max(0, recvMax - recvMin);
+    }
+    sendCounts[r]  = sendCells * dataSpaces.size();
+    sendOffsets[r] = sendTotal;
+    sendTotal     += sendCounts[r];
+    recvCounts[r]  = recvCells * dataSpaces.size();
+    recvOffsets[r] = recvTotal;
+    recvTotal     += recvCounts[r];
+  }
+
+  vector<T> sendValues(sendTotal + 1), recvValues(recvTotal + 1);
+  T* out = &sendValues[0];
+  for(int r = 0; r < worldSize; r++){
+    if(sendCounts[r] == 0) continue;
+    for(size_t d = 0; d < dataSpaces.size(); d++){
+      vector<int> coords;
+      for(int i = 0; i < numDims; i++) coords.push_back(sendBoxes[r][2 * i]);
+      do{
+        *out++ = dataSpaces[d][getIndex(coords, true)];
+        int i = 0;
+        while(i < numDims && ++coords[i] == sendBoxes[r][2 * i + 1]){
+          coords[i] = sendBoxes[r][2 * i];
+          i++;
+        }
+        if(i == numDims) break;
+      }while(true);
+    }
+  }
+
+  MPI_Alltoallv(&sendValues[0], &sendCounts[0], &sendOffsets[0], getRawMPIDataType(),
+                &recvValues[0], &recvCounts[0], &recvOffsets[0], getRawMPIDataType(), comm);
+
+  // Replace the geometry and the data spaces with ones for the new boundaries
+  for(int i = 0; i < neighborCount; i++) MPI_Type_free(&neighborData[i].datatype);
+  delete[] neighborData;
+  delete[] requests;
+  localBoundaries = cartTopology->getDimensions(rank, globalBoundaries);
+  initGeometry();
+
+  for(size_t d = 0; d < dataSpaces.size(); d++){
+    delete[] dataSpaces[d];
+    dataSpaces[d] = new T[length];
+    for(int j = 0; j < length; j++) dataSpaces[d][j] = 0;
+  }
+
+  const T* in = &recvValues[0];
+  for(int r = 0; r < worldSize; r++){
+    if(recvCounts[r] == 0) continue;
+    for(size_t d = 0; d < dataSpaces.size(); d++){
+      vector<int> coords;
+      for(int i = 0; i < numDims; i++) coords.push_back(recvBoxes[r][2 * i]);
+      do{
+        dataSpaces[d][getIndex(coords, true)] = *in++;
+        int i = 0;
+        while(i < numDims && ++coords[i] == recvBoxes[r][2 * i + 1]){
+          coords[i] = recvBoxes[r][2 * i];
+          i++;
+        }
+        if(i == numDims) break;
+      }while(true);
+    }
+  }
+}
+
 template<typename T>
 AbstractValueLayerND<T>::~AbstractValueLayerND(){
   delete[] neighborData; // Should Free MPI Datatypes first...
@@ -654,6 +855,27 @@ int AbstractValueLayerND<T>::getIndex(Point<int> location){
   return getIndex(location.coords());
 }
 
+template<typename T>
+int AbstractValueLayerND<T>::getAxisIndex(int dimension, int coord){
+  DimensionDatum<T>& datum = dimensionData[dimension];
+  if(coord < datum.globalCoordinateMin || coord >= datum.globalCoordinateMax){
+    if(!datum.periodic) return -1;
+    coord = (coord - datum.globalCoordinateMin) % datum.globalWidth;
+    if(coord < 0) coord += datum.globalWidth;
+    coord += datum.globalCoordinateMin;
+  }
+  // The buffer zone may hold the coordinate one global width away on either side
+  int simplified = coord;
+  if(simplified < datum.simplifiedBoundariesMin || simplified >= datum.simplifiedBoundariesMax){
+    simplified = coord - datum.globalWidth;
+    if(!datum.periodic || simplified < datum.simplifiedBoundariesMin || simplified >= datum.simplifiedBoundariesMax){
+      simplified = coord + datum.globalWidth;
+      if(!datum.periodic || simplified < datum.simplifiedBoundariesMin || simplified >= datum.simplifiedBoundariesMax) return -1;
+    }
+  }
+  return (simplified - datum.simplifiedBoundariesMin) * places[dimension];
+}
+
 
 template<typename T>
 void AbstractValueLayerND<T>::getMPIDataType(RelativeLocation relLoc, MPI_Datatype &datatype){
@@ -821,11 +1043,23 @@ public:
    */
   virtual T getValueAt(vector<int> location, bool& errFlag);
 
+  /**
+   * Inherited from AbstractValueLayerND
+   */
+  virtual const T* getDataSpace(){
+    return dataSpace;
+  }
+
   /**
    * Inherited from AbstractValueLayerND
    */
   virtual void synchronize();
 
+  /**
+   * Inherited from AbstractValueLayerND
+   */
+  virtual bool updatePartition();
+
   /**
    * Write the values in this ValueLayer to a .csv file.
    *
@@ -946,11 +1180,23 @@ public:
    */
   virtual T getValueAt(vector<int> location, bool& errFlag);
 
+  /**
+   * Inherited from AbstractValueLayerND
+   */
+  virtual const T* getDataSpace(){
+    return currentDataSpace;
+  }
+
   /**
    * Inherited from AbstractValueLayerND
    */
   virtual void synchronize();
 
+  /**
+   * Inherited from AbstractValueLayerND
+   */
+  virtual bool updatePartition();
+
   /**
    * Write this rank's data to a CSV file
    */
@@ -1167,10 +1413,22 @@ T ValueLayerND<T>::getValueAt(Point<int> location, bool& errFlag){
   return dataSpace[indx];
 }
 
+template<typename T>
+bool ValueLayerND<T>::updatePartition(){
+  if(!AbstractValueLayerND<T>::partitionChanged()) return false;
+  vector<T*> dataSpaces(1, dataSpace);
+  AbstractValueLayerND<T>::repartitionDataSpaces(dataSpaces);
+  dataSpace = dataSpaces[0];
+  return true;
+}
+
 template<typename T>
 void ValueLayerND<T>::synchronize(){
+  updatePartition();
   AbstractValueLayerND<T>::syncCount++;
   if(AbstractValueLayerND<T>::syncCount > 9) AbstractValueLayerND<T>::syncCount = 0;
+  REPAST_SYNC_PROFILE(VALUE_LAYER);
+  REPAST_SYNC_PARTNERS(AbstractValueLayerND<T>::neighborCount, AbstractValueLayerND<T>::neighborCount);
   int mpiTag = AbstractValueLayerND<T>::instanceID * 10 + AbstractValueLayerND<T>::syncCount;
   // Note: the syncCount and send/recv directions are used to create a unique tag value for the
   // mpi sends and receives. The tag value must be unique in two ways: first, successive calls to this
@@ -1183,6 +1441,7 @@ void ValueLayerND<T>::synchronize(){
   // For each entry in neighbors:
   MPI_Status statuses[AbstractValueLayerND<T>::neighborCount * 2];
   for(int i = 0; i < AbstractValueLayerND<T>::neighborCount; i++){
+    REPAST_SYNC_SENT(1, SyncProfiler::bytes(AbstractValueLayerND<T>::neighborData[i].datatype));
     MPI_Isend(&dataSpace[AbstractValueLayerND<T>::neighborData[i].sendPtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
         AbstractValueLayerND<T>::neighborData[i].rank, 10 * (AbstractValueLayerND<T>::neighborData[i].sendDir + 1) + mpiTag, AbstractValueLayerND<T>::cartTopology->topologyComm, &AbstractValueLayerND<T>::requests[i]);
     MPI_Irecv(&dataSpace[AbstractValueLayerND<T>::neighborData[i].receivePtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
@@ -1408,10 +1667,25 @@ T ValueLayerNDSU<T>::getValueAt(vector<int> location, bool& errFlag){
 }
 
 
+template<typename T>
+bool ValueLayerNDSU<T>::updatePartition(){
+  if(!AbstractValueLayerND<T>::partitionChanged()) return false;
+  vector<T*> dataSpaces;
+  dataSpaces.push_back(currentDataSpace);
+  dataSpaces.push_back(otherDataSpace);
+  AbstractValueLayerND<T>::repartitionDataSpaces(dataSpaces);
+  dataSpace1 = currentDataSpace = dataSpaces[0];
+  dataSpace2 = otherDataSpace   = dataSpaces[1];
+  return true;
+}
+
 template<typename T>
 void ValueLayerNDSU<T>::synchronize(){
+  updatePartition();
   AbstractValueLayerND<T>::syncCount++;
   if(AbstractValueLayerND<T>::syncCount > 9) AbstractValueLayerND<T>::syncCount = 0;
+  REPAST_SYNC_PROFILE(VALUE_LAYER);
+  REPAST_SYNC_PARTNERS(AbstractValueLayerND<T>::neighborCount, AbstractValueLayerND<T>::neighborCount);
   int mpiTag = AbstractValueLayerND<T>::instanceID * 10 + AbstractValueLayerND<T>::syncCount;
   // Note: the syncCount and send/recv directions are used to create a unique tag value for the
   // mpi sends and receives. The tag value must be unique in two ways: first, successive calls to this
@@ -1424,6 +1698,7 @@ void ValueLayerNDSU<T>::synchronize(){
   // For each entry in neighbors:
   MPI_Status statuses[AbstractValueLayerND<T>::neighborCount * 2];
   for(int i = 0; i < AbstractValueLayerND<T>::neighborCount; i++){
+    REPAST_SYNC_SENT(1, SyncProfiler::bytes(AbstractValueLayerND<T>::neighborData[i].datatype));
     MPI_Isend(&currentDataSpace[AbstractValueLayerND<T>::neighborData[i].sendPtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
         AbstractValueLayerND<T>::neighborData[i].rank, 10 * (AbstractValueLayerND<T>::neighborData[i].sendDir + 1) + mpiTag, AbstractValueLayerND<T>::cartTopology->topologyComm, &AbstractValueLayerND<T>::requests[i]);
     MPI_Irecv(&currentDataSpace[AbstractValueLayerND<T>::neighborData[i].receivePtrOffset], 1, AbstractValueLayerND<T>::neighborData[i].datatype,
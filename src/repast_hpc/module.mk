@@ -1,4 +1,5 @@
 SOURCES = AgentId.cpp \
+AgentIdSet.cpp \
 NCDataSetBuilder.cpp \
 SharedNetwork.cpp \
 AgentImporterExporter.cpp \
@@ -6,7 +7,11 @@ NCDataSet.cpp \
 spatial_math.cpp \
 AgentRequest.cpp \
 NetworkBuilder.cpp \
+NodePool.cpp \
 SRManager.cpp \
+NeighborhoodCommunicator.cpp \
+NeighborhoodStencil.cpp \
+SyncProfiler.cpp \
 AgentStatus.cpp \
 Properties.cpp \
 SVDataSetBuilder.cpp \
@@ -21,6 +26,7 @@ RepastProcess.cpp \
 ValueLayer.cpp \
 initialize_random.cpp \
 Schedule.cpp \
+ScheduleProfiler.cpp \
 Variable.cpp \
 io.cpp \
 SharedBaseGrid.cpp \
@@ -57,6 +57,21 @@ const int EXPORTER_UPDATE_IMPORTERS = 1008;
 const int AGENT_MOVED_SENDERS = 1009;
 const int AGENT_MOVED_AGENT = 1010;
 
+// Two tags are used by the SPARSE_NBX agent request exchange so that
+// consecutive rounds can never be confused with one another
+const int AGENT_REQUEST_SPARSE_EVEN = 1011;
+const int AGENT_REQUEST_SPARSE_ODD = 1012;
+
+// Tags for agent Content sent as raw buffers (see ContentTraits)
+const int AGENT_REQUEST_CONTENT = 1013;
+const int PROJECTION_INFO_CONTENT = 1015;
+const int AGENT_MOVED_CONTENT = 1016;
+
+// Agent state exchanges may be in flight together, so each is given its own
+// tag from AGENT_STATE_CONTENT to AGENT_STATE_CONTENT + AGENT_STATE_CONTENT_TAGS - 1
+const int AGENT_STATE_CONTENT = 1024;
+const int AGENT_STATE_CONTENT_TAGS = 64;
+
 
 }
 
@@ -43,6 +43,7 @@
 #define AGENTPACKAGE_H
 
 #include "repast_hpc/AgentId.h"
+#include "repast_hpc/RawContent.h"
 
 struct AgentPackage {
 
@@ -67,6 +68,9 @@ struct AgentPackage {
 	}
 };
 
+// AgentPackage is plain data, so it can be sent without serialization
+REPAST_RAW_CONTENT(AgentPackage)
+
 
 
 #endif /* AGENTCONTENT_H_ */
@@ -0,0 +1,177 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * agent_id_set_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include "repast_hpc/AgentIdSet.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using namespace repast;
+
+namespace {
+
+// Checks that the set holds the same ids, in the same order and with the
+// same current ranks, as the std::set it replaces
+void expectSameAs(const std::set<AgentId>& expected, const AgentIdSet& actual) {
+	ASSERT_EQ(expected.size(), actual.size());
+	std::set<AgentId>::const_iterator exp = expected.begin();
+	for (AgentIdSet::const_iterator iter = actual.begin(); iter != actual.end(); ++iter, ++exp) {
+		ASSERT_EQ(*exp, *iter);
+		ASSERT_EQ(exp->currentRank(), iter->currentRank());
+	}
+}
+
+}
+
+TEST(AgentIdSet, OutOfOrderInsert)
+{
+	AgentIdSet ids;
+	std::set<AgentId> expected;
+	int order[] = { 5, 1, 9, 3, 7, 2, 8, 0, 6, 4 };
+	for (int i = 0; i < 10; i++) {
+		ids.insert(AgentId(order[i], 0, 0));
+		expected.insert(AgentId(order[i], 0, 0));
+		// reading the set in between inserts merges what has been added so far
+		if (i % 3 == 0) {
+			ASSERT_TRUE(ids.contains(AgentId(order[i], 0, 0)));
+		}
+	}
+	expectSameAs(expected, ids);
+	ASSERT_FALSE(ids.contains(AgentId(10, 0, 0)));
+	ASSERT_FALSE(ids.contains(AgentId(1, 0, 1)));
+	ASSERT_FALSE(ids.contains(AgentId(1, 1, 0)));
+
+	// ids in increasing order are appended
+	AgentIdSet inOrder;
+	for (int i = 0; i < 10; i++)
+		inOrder.insert(AgentId(i, 0, 0));
+	expectSameAs(expected, inOrder);
+}
+
+TEST(AgentIdSet, DuplicatesKeepFirstCopy)
+{
+	AgentIdSet ids;
+	std::set<AgentId> expected;
+	for (int i = 9; i >= 0; i--) {
+		AgentId first(i, 0, 0, 1);
+		ids.insert(first);
+		expected.insert(first);
+	}
+	for (int i = 0; i < 10; i += 2) {
+		AgentId second(i, 0, 0, 2);
+		ids.insert(second);
+		expected.insert(second);
+	}
+	expectSameAs(expected, ids);
+	for (AgentIdSet::const_iterator iter = ids.begin(); iter != ids.end(); ++iter)
+		ASSERT_EQ(1, iter->currentRank());
+
+	ids.insert(AgentId(3, 0, 0, 2));
+	ASSERT_EQ(10, ids.size());
+	ids.clear();
+	ASSERT_TRUE(ids.empty());
+	ASSERT_FALSE(ids.contains(AgentId(3, 0, 0)));
+}
+
+TEST(AgentIdSet, InsertAndEraseSets)
+{
+	AgentIdSet evens, threes;
+	std::set<AgentId> expectedEvens, expectedThrees;
+	for (int i = 20; i >= 0; i--) {
+		if (i % 2 == 0) {
+			evens.insert(AgentId(i, 0, 0, 1));
+			expectedEvens.insert(AgentId(i, 0, 0, 1));
+		}
+		if (i % 3 == 0) {
+			threes.insert(AgentId(i, 0, 0, 2));
+			expectedThrees.insert(AgentId(i, 0, 0, 2));
+		}
+	}
+
+	// ids already in the set are kept over the equal ids inserted
+	AgentIdSet all;
+	all.insert(evens);
+	all.insert(threes);
+	std::set<AgentId> expected(expectedEvens);
+	expected.insert(expectedThrees.begin(), expectedThrees.end());
+	expectSameAs(expected, all);
+	ASSERT_EQ(1, std::find(all.begin(), all.end(), AgentId(6, 0, 0))->currentRank());
+	ASSERT_EQ(2, std::find(all.begin(), all.end(), AgentId(9, 0, 0))->currentRank());
+
+	all.erase(threes);
+	std::set<AgentId> remaining;
+	for (std::set<AgentId>::iterator iter = expected.begin(); iter != expected.end(); ++iter)
+		if (expectedThrees.find(*iter) == expectedThrees.end()) remaining.insert(*iter);
+	expectSameAs(remaining, all);
+	ASSERT_FALSE(all.contains(AgentId(6, 0, 0)));
+	ASSERT_TRUE(all.contains(AgentId(4, 0, 0)));
+
+	// erasing and inserting empty sets, and erasing everything
+	AgentIdSet empty;
+	all.insert(empty);
+	all.erase(empty);
+	expectSameAs(remaining, all);
+	all.erase(evens);
+	ASSERT_TRUE(all.empty());
+	empty.insert(threes);
+	expectSameAs(expectedThrees, empty);
+}
+
+TEST(AgentIdSet, CurrentRankIsIgnored)
+{
+	AgentIdSet ids;
+	ids.insert(AgentId(1, 0, 0, 0));
+	ids.insert(AgentId(1, 0, 0, 3));
+	ids.insert(AgentId(0, 0, 0, 3));
+	ASSERT_EQ(2, ids.size());
+	ASSERT_TRUE(ids.contains(AgentId(1, 0, 0, 5)));
+	ASSERT_EQ(0, std::find(ids.begin(), ids.end(), AgentId(1, 0, 0))->currentRank());
+
+	AgentIdSet moved;
+	moved.insert(AgentId(1, 0, 0, 7));
+	ids.erase(moved);
+	ASSERT_EQ(1, ids.size());
+	ASSERT_FALSE(ids.contains(AgentId(1, 0, 0, 0)));
+	ASSERT_TRUE(ids.contains(AgentId(0, 0, 0, 0)));
+}
@@ -87,6 +87,25 @@ public:
 
 };
 
+class CountingGraph : public TestGraph {
+
+protected:
+
+	virtual bool addAgent(boost::shared_ptr<TestAgent> agent) {
+		added++;
+		return TestGraph::addAgent(agent);
+	}
+
+public:
+
+	int added;
+
+	CountingGraph(std::string name) :
+			TestGraph(name, true), added(0) {
+	}
+
+};
+
 TEST_F(ContextTest, AddRemove)
 {
 	ASSERT_EQ(0, context.size());
@@ -110,6 +129,50 @@ TEST_F(ContextTest, AddRemove)
 	//}
 }
 
+TEST_F(ContextTest, AddAgents)
+{
+	TestGraph* graph = new TestGraph ("graph", true);
+	context.addProjection(graph);
+
+	TestAgent* existing = new TestAgent(3, 0, 0);
+	context.addAgent(existing);
+
+	std::vector<TestAgent*> toAdd, inContext;
+	for (int i = 0; i < 10; i++) {
+		toAdd.push_back(new TestAgent(i, 0, 0));
+	}
+	context.addAgents(toAdd.begin(), toAdd.end(), inContext);
+
+	ASSERT_EQ(10, context.size());
+	ASSERT_EQ(10, graph->vertexCount());
+	ASSERT_EQ(10, inContext.size());
+	for (int i = 0; i < 10; i++) {
+		if (i == 3) {
+			ASSERT_EQ(existing, inContext[i]);
+			delete toAdd[i];
+		} else {
+			ASSERT_EQ(toAdd[i], inContext[i]);
+		}
+		ASSERT_TRUE(context.contains(AgentId(i, 0, 0)));
+	}
+}
+
+TEST_F(ContextTest, AddAgentsCallsAddAgent)
+{
+	CountingGraph* graph = new CountingGraph ("graph");
+	context.addProjection(graph);
+
+	std::vector<TestAgent*> toAdd, inContext;
+	for (int i = 0; i < 5; i++) {
+		toAdd.push_back(new TestAgent(i, 0, 0));
+	}
+	context.addAgents(toAdd.begin(), toAdd.end(), inContext);
+
+	// an overridden addAgent sees every agent added in bulk
+	ASSERT_EQ(5, graph->added);
+	ASSERT_EQ(5, graph->vertexCount());
+}
+
 TEST_F(ContextTest, ValueLayer)
 {
 	DiscreteValueLayer<int, StrictBorders>* discrete = new DiscreteValueLayer<int, StrictBorders> ("D", GridDimensions(
@@ -499,6 +562,90 @@ TEST_F(ContextTest, AgentByType)
 	ASSERT_EQ(0, expected.size());
 }
 
+TEST_F(ContextTest, SizeByType)
+{
+	for (int i = 0; i < 100; i++) {
+		context.addAgent(new TestAgent(i, 0, i % 4 == 0 ? 5 : 2));
+	}
+	ASSERT_EQ(25, context.size(5));
+	ASSERT_EQ(75, context.size(2));
+	ASSERT_EQ(0, context.size(3));
+
+	for (int i = 0; i < 100; i += 4) {
+		context.removeAgent(AgentId(i, 0, 5));
+	}
+	ASSERT_EQ(0, context.size(5));
+	ASSERT_EQ(75, context.size(2));
+	ASSERT_TRUE(context.byTypeBegin(5) == context.byTypeEnd(5));
+
+	std::vector<int> types;
+	context.getAgentTypes(types);
+	ASSERT_EQ(2, types.size());
+	ASSERT_EQ(2, types[0]);
+	ASSERT_EQ(5, types[1]);
+}
+
+TEST_F(ContextTest, SlabStorage)
+{
+	Context<TestAgent> slabContext(Context<TestAgent>::SLABS);
+	ASSERT_EQ(Context<TestAgent>::SLABS, slabContext.getStorage());
+	ASSERT_EQ(0, slabContext.size());
+	ASSERT_TRUE(slabContext.begin() == slabContext.end());
+
+	TestAgent* agent = new TestAgent(0, 1, 1);
+	ASSERT_EQ(agent, slabContext.addAgent(agent));
+	TestAgent* duplicate = new TestAgent(0, 1, 1);
+	ASSERT_EQ(agent, slabContext.addAgent(duplicate));
+	delete duplicate;
+	ASSERT_EQ(1, slabContext.size());
+	ASSERT_EQ(agent, slabContext.getAgent(AgentId(0, 1, 1)));
+
+	slabContext.removeAgent(agent->getId());
+	ASSERT_EQ(0, slabContext.size());
+	ASSERT_TRUE(!slabContext.contains(AgentId(0, 1, 1)));
+	ASSERT_TRUE(slabContext.getAgent(AgentId(0, 1, 1)) == 0);
+
+	// add and remove enough agents to grow the index and reuse slots
+	boost::unordered_set<AgentId, HashId> expected;
+	for (int i = 0; i < 1000; i++) {
+		slabContext.addAgent(new TestAgent(i, 0, i % 3));
+		expected.insert(AgentId(i, 0, i % 3));
+	}
+	for (int i = 0; i < 1000; i += 2) {
+		slabContext.removeAgent(AgentId(i, 0, i % 3));
+		expected.erase(AgentId(i, 0, i % 3));
+	}
+	for (int i = 1000; i < 1300; i++) {
+		slabContext.addAgent(new TestAgent(i, 0, i % 3));
+		expected.insert(AgentId(i, 0, i % 3));
+	}
+	ASSERT_EQ((int) expected.size(), slabContext.size());
+
+	for (boost::unordered_set<AgentId, HashId>::iterator iter = expected.begin(); iter != expected.end(); ++iter) {
+		ASSERT_TRUE(slabContext.contains(*iter));
+		ASSERT_EQ(*iter, slabContext.getAgent(*iter)->getId());
+	}
+	for (int i = 0; i < 1000; i += 2) {
+		ASSERT_TRUE(!slabContext.contains(AgentId(i, 0, i % 3)));
+	}
+
+	// iteration visits every agent once, grouped by type
+	int lastType = -1;
+	for (Context<TestAgent>::const_iterator iter = slabContext.begin(); iter != slabContext.end(); ++iter) {
+		ASSERT_TRUE((*iter)->getId().agentType() >= lastType);
+		lastType = (*iter)->getId().agentType();
+		ASSERT_EQ(1, expected.erase((*iter)->getId()));
+	}
+	ASSERT_EQ(0, expected.size());
+
+	int count = 0;
+	for (Context<TestAgent>::const_bytype_iterator iter = slabContext.byTypeBegin(2); iter != slabContext.byTypeEnd(2); ++iter) {
+		ASSERT_EQ(2, (*iter)->getId().agentType());
+		count++;
+	}
+	ASSERT_EQ(266, count);
+}
+
 
 
 
@@ -1030,6 +1177,59 @@ TEST_F(ContextTest, AgentSelection_Basic)
 
 
 
+TEST_F(ContextTest, AgentSelection_AfterRemoval){
+	Context<TestAgent>::STORAGE storages[] = { Context<TestAgent>::HASH_MAP, Context<TestAgent>::SLABS };
+	for(int s = 0; s < 2; s++){
+		Context<TestAgent> agents(storages[s]);
+		for(int i = 0; i < 1000; i++) agents.addAgent(new TestAgent(i, 0, i % 3));
+		// removals move other agents of the same type into the removed agents' places
+		for(int i = 0; i < 1000; i += 4) agents.removeAgent(AgentId(i, 0, i % 3));
+		ASSERT_EQ(750, agents.size());
+
+		for(int type = 0; type < 3; type++){
+			int count = 0;
+			for(Context<TestAgent>::const_bytype_iterator iter = agents.byTypeBegin(type); iter != agents.byTypeEnd(type); ++iter){
+				ASSERT_EQ(type, (*iter)->getId().agentType());
+				ASSERT_TRUE((*iter)->getId().id() % 4 != 0);
+				count++;
+			}
+			ASSERT_EQ(250, count);
+			ASSERT_EQ(250, countOf(agents.byTypeBegin(type), agents.byTypeEnd(type)));
+		}
+		ASSERT_EQ(0, countOf(agents.byTypeBegin(3), agents.byTypeEnd(3)));
+
+		vector<TestAgent*> randomAgents;
+		agents.getRandomAgents(300, randomAgents);
+		set<TestAgent*> distinct(randomAgents.begin(), randomAgents.end());
+		ASSERT_EQ(300, distinct.size());
+		for(set<TestAgent*>::iterator iter = distinct.begin(); iter != distinct.end(); ++iter)
+			ASSERT_TRUE(agents.contains((*iter)->getId()));
+
+		// picking every agent, and more than that, returns each agent once
+		randomAgents.clear();
+		agents.getRandomAgents(agents.size(), randomAgents);
+		ASSERT_EQ(750, randomAgents.size());
+		ASSERT_EQ(750, set<TestAgent*>(randomAgents.begin(), randomAgents.end()).size());
+		randomAgents.erase(randomAgents.begin() + 700, randomAgents.end());
+		agents.getRandomAgents(100, randomAgents);
+		ASSERT_EQ(750, randomAgents.size());
+		ASSERT_EQ(750, set<TestAgent*>(randomAgents.begin(), randomAgents.end()).size());
+
+		set<TestAgent*> resultSet;
+		agents.selectAgents(500, resultSet);
+		ASSERT_EQ(500, resultSet.size());
+		for(set<TestAgent*>::iterator iter = resultSet.begin(); iter != resultSet.end(); ++iter)
+			ASSERT_TRUE((*iter)->getId().id() % 4 != 0);
+
+		vector<TestAgent*> resultVec;
+		agents.selectAgents(100, resultVec, 2);
+		ASSERT_EQ(100, resultVec.size());
+		for(size_t i = 0; i < resultVec.size(); i++) ASSERT_EQ(2, resultVec[i]->getId().agentType());
+	}
+}
+
+
+
 TEST_F(ContextTest, AgentSelection_ByType){
 
 	for(int i = 0; i < 1000; i++){
@@ -41,6 +41,8 @@
 
 #include "repast_hpc/GridComponents.h"
 #include "repast_hpc/MultipleOccupancy.h"
+#include "repast_hpc/DenseOccupancy.h"
+#include "repast_hpc/BinnedOccupancy.h"
 #include "repast_hpc/SingleOccupancy.h"
 #include "test.h"
 
@@ -271,3 +273,148 @@ TEST(MultipleOccupancy, All)
 	mo.put(agents[2], pt);
 	ASSERT_EQ(agents[2].get(), mo.get(pt));
 }
+
+TEST(DenseOccupancy, All)
+{
+	DenseOccupancy<TestAgent, int> dense;
+	dense.init(GridDimensions(Point<double> (-2, -2), Point<double> (10, 10)));
+
+	vector<boost::shared_ptr<TestAgent> > agents;
+	for (int i = 0; i < 10; i++) {
+		agents.push_back(boost::shared_ptr<TestAgent>(new TestAgent(i, 0, 0)));
+	}
+
+	// in the array, at its corners, and outside it
+	Point<int> pt(0, 0);
+	Point<int> low(-2, -2);
+	Point<int> high(7, 7);
+	Point<int> outside(20, -5);
+	ASSERT_EQ(NULL, dense.get(pt));
+	ASSERT_EQ(NULL, dense.get(outside));
+
+	ASSERT_TRUE(dense.put(agents[0], pt));
+	ASSERT_TRUE(dense.put(agents[1], pt));
+	ASSERT_TRUE(dense.put(agents[1], pt));
+	ASSERT_TRUE(dense.put(agents[2], low));
+	ASSERT_TRUE(dense.put(agents[3], high));
+	ASSERT_TRUE(dense.put(agents[4], outside));
+
+	vector<TestAgent*> vec;
+	dense.getAll(pt, vec);
+	ASSERT_EQ(2, vec.size());
+	ASSERT_TRUE((vec[0] == agents[0].get() && vec[1] == agents[1].get()) ||
+			(vec[0] == agents[1].get() && vec[1] == agents[0].get()));
+	ASSERT_EQ(agents[2].get(), dense.get(low));
+	ASSERT_EQ(agents[3].get(), dense.get(high));
+	ASSERT_EQ(agents[4].get(), dense.get(outside));
+	ASSERT_EQ(NULL, dense.get(Point<int> (1, 0)));
+
+	dense.remove(agents[0], pt);
+	ASSERT_EQ(agents[1].get(), dense.get(pt));
+	dense.remove(agents[1], pt);
+	ASSERT_EQ(NULL, dense.get(pt));
+	vec.clear();
+	dense.getAll(pt, vec);
+	ASSERT_EQ(0, vec.size());
+
+	// an emptied cell is reused
+	dense.put(agents[6], pt);
+	vec.clear();
+	dense.getAll(pt, vec);
+	ASSERT_EQ(1, vec.size());
+	ASSERT_EQ(agents[6].get(), vec[0]);
+	dense.remove(agents[6], pt);
+	ASSERT_EQ(NULL, dense.get(pt));
+	dense.remove(agents[4], outside);
+	ASSERT_EQ(NULL, dense.get(outside));
+
+	// occupants are kept when the region moves
+	dense.put(agents[5], pt);
+	dense.init(GridDimensions(Point<double> (5, 5), Point<double> (20, 20)));
+	ASSERT_EQ(agents[5].get(), dense.get(pt));
+	ASSERT_EQ(agents[2].get(), dense.get(low));
+	ASSERT_EQ(agents[3].get(), dense.get(high));
+	dense.remove(agents[3], high);
+	ASSERT_EQ(NULL, dense.get(high));
+	dense.put(agents[3], outside);
+	ASSERT_EQ(agents[3].get(), dense.get(outside));
+}
+
+TEST(BinnedOccupancy, All)
+{
+	BinnedOccupancy<TestAgent, double> binned;
+	binned.init(GridDimensions(Point<double> (0, 0), Point<double> (10, 10)));
+	binned.setBinWidth(2);
+	ASSERT_EQ(2, binned.getBinWidth());
+
+	vector<boost::shared_ptr<TestAgent> > agents;
+	for (int i = 0; i < 10; i++) {
+		agents.push_back(boost::shared_ptr<TestAgent>(new TestAgent(i, 0, 0)));
+	}
+
+	Point<double> pt(1.5, 1.5);
+	Point<double> near(1.9, 1.1);
+	Point<double> far(8.5, 9.5);
+	Point<double> outside(-3.5, 12.25);
+	ASSERT_TRUE(binned.put(agents[0], pt));
+	ASSERT_TRUE(binned.put(agents[1], pt));
+	ASSERT_TRUE(binned.put(agents[2], near));
+	ASSERT_TRUE(binned.put(agents[3], far));
+	ASSERT_TRUE(binned.put(agents[4], outside));
+
+	// exact locations
+	vector<TestAgent*> vec;
+	binned.getAll(pt, vec);
+	ASSERT_EQ(2, vec.size());
+	ASSERT_EQ(agents[2].get(), binned.get(near));
+	ASSERT_EQ(agents[4].get(), binned.get(outside));
+	ASSERT_EQ(NULL, binned.get(Point<double> (1.5, 1.6)));
+
+	// radius and box queries, in and out of the bin array
+	vec.clear();
+	binned.getAllWithin(Point<double> (1.5, 1.0), 0.6, vec);
+	ASSERT_EQ(3, vec.size());
+	vec.clear();
+	binned.getAllWithin(Point<double> (1.5, 1.0), 0.45, vec);
+	ASSERT_EQ(1, vec.size());
+	ASSERT_EQ(agents[2].get(), vec[0]);
+	vec.clear();
+	binned.getAllWithin(Point<double> (-3, 12), 1, vec);
+	ASSERT_EQ(1, vec.size());
+	ASSERT_EQ(agents[4].get(), vec[0]);
+
+	vec.clear();
+	std::vector<double> lower, upper;
+	lower.push_back(1.5);
+	lower.push_back(1.5);
+	upper.push_back(8.5);
+	upper.push_back(9.5);
+	binned.getAllInBox(lower, upper, vec);
+	ASSERT_EQ(3, vec.size());
+
+	// a box far larger than the region, covering the outside occupant
+	vec.clear();
+	lower[0] = lower[1] = -1e6;
+	upper[0] = upper[1] = 1e6;
+	binned.getAllInBox(lower, upper, vec);
+	ASSERT_EQ(5, vec.size());
+	vec.clear();
+	binned.getAllWithin(Point<double> (1.5, 1.5), 1e6, vec);
+	ASSERT_EQ(5, vec.size());
+	vec.clear();
+	lower[0] = 12;
+	binned.getAllInBox(lower, upper, vec);
+	ASSERT_EQ(0, vec.size());
+
+	// occupants are kept when the bins change
+	binned.setBinWidth(0.5);
+	binned.remove(agents[0], pt);
+	vec.clear();
+	binned.getAllWithin(Point<double> (1.5, 1.0), 0.6, vec);
+	ASSERT_EQ(2, vec.size());
+	binned.init(GridDimensions(Point<double> (-5, -5), Point<double> (20, 20)));
+	ASSERT_EQ(agents[1].get(), binned.get(pt));
+	ASSERT_EQ(agents[4].get(), binned.get(outside));
+	binned.remove(agents[4], outside);
+	ASSERT_EQ(NULL, binned.get(outside));
+}
@@ -43,6 +43,7 @@
 #include "repast_hpc/Context.h"
 #include "repast_hpc/Moore2DGridQuery.h"
 #include "repast_hpc/VN2DGridQuery.h"
+#include "repast_hpc/NDGridQuery.h"
 #include "test.h"
 
 #include <gtest/gtest.h>
@@ -687,3 +688,198 @@ TEST(GridTest, VNQueries)
 
 }
 
+TEST(GridTest, NDQueries)
+{
+	Context<TestAgent> context;
+
+	GridDimensions dims(Point<double> (5, 5, 5));
+	Spaces<TestAgent>::MultipleStrictDiscreteSpace* grid = new Spaces<TestAgent>::MultipleStrictDiscreteSpace("grid", dims);
+	context.addProjection(grid);
+
+	// one agent per cell, id = x + 5y + 25z
+	for (int z = 0; z < 5; z++) {
+		for (int y = 0; y < 5; y++) {
+			for (int x = 0; x < 5; x++) {
+				TestAgent* agent = new TestAgent(x + 5 * y + 25 * z, 0, 0);
+				context.addAgent(agent);
+				grid->moveTo(agent->getId(), Point<int> (x, y, z));
+			}
+		}
+	}
+
+	NDGridQuery<TestAgent> query(grid);
+	vector<TestAgent*> out;
+
+	// moore, range 1, clipped at the corner
+	query.query(Point<int> (0, 0, 0), NeighborhoodStencil::moore(3, 1, true), out);
+	set<int> expected;
+	for (int z = 0; z < 2; z++)
+		for (int y = 0; y < 2; y++)
+			for (int x = 0; x < 2; x++)
+				expected.insert(x + 5 * y + 25 * z);
+	ASSERT_EQ(8, out.size());
+	for (size_t i = 0; i < out.size(); i++) {
+		ASSERT_EQ(1, expected.erase(out[i]->getId().id()));
+	}
+
+	// moore without the center
+	out.clear();
+	query.query(Point<int> (2, 2, 2), NeighborhoodStencil::moore(3, 1, false), out);
+	ASSERT_EQ(26, out.size());
+	for (size_t i = 0; i < out.size(); i++) {
+		ASSERT_NE(62, out[i]->getId().id());
+	}
+
+	// von neumann, range 2
+	out.clear();
+	query.query(Point<int> (2, 2, 2), NeighborhoodStencil::vonNeumann(3, 2, true), out);
+	for (int z = 0; z < 5; z++)
+		for (int y = 0; y < 5; y++)
+			for (int x = 0; x < 5; x++)
+				if (abs(x - 2) + abs(y - 2) + abs(z - 2) <= 2) expected.insert(x + 5 * y + 25 * z);
+	ASSERT_EQ(25, expected.size());
+	ASSERT_EQ(25, out.size());
+	for (size_t i = 0; i < out.size(); i++) {
+		ASSERT_EQ(1, expected.erase(out[i]->getId().id()));
+	}
+
+	// custom stencil, one offset out of bounds
+	NeighborhoodStencil stencil(3);
+	vector<int> offset(3, 0);
+	offset[2] = 3;
+	stencil.add(offset);
+	offset[2] = -3;
+	stencil.add(offset);
+	ASSERT_EQ(3, stencil.range());
+	out.clear();
+	query.query(Point<int> (1, 1, 1), stencil, out);
+	ASSERT_EQ(1, out.size());
+	ASSERT_EQ(1 + 5 + 25 * 4, out[0]->getId().id());
+}
+
+TEST(GridTest, NDQueriesWrapped)
+{
+	Context<TestAgent> context;
+
+	GridDimensions dims(Point<double> (4, 4, 4));
+	Spaces<TestAgent>::MultipleWrappedDiscreteSpace* grid = new Spaces<TestAgent>::MultipleWrappedDiscreteSpace("grid", dims);
+	context.addProjection(grid);
+
+	for (int z = 0; z < 4; z++) {
+		for (int y = 0; y < 4; y++) {
+			for (int x = 0; x < 4; x++) {
+				TestAgent* agent = new TestAgent(x + 4 * y + 16 * z, 0, 0);
+				context.addAgent(agent);
+				grid->moveTo(agent->getId(), Point<int> (x, y, z));
+			}
+		}
+	}
+
+	NDGridQuery<TestAgent> query(grid);
+	vector<TestAgent*> out;
+
+	// wraps across the corner
+	query.query(Point<int> (0, 0, 0), NeighborhoodStencil::moore(3, 1, true), out);
+	set<int> expected;
+	for (int z = -1; z < 2; z++)
+		for (int y = -1; y < 2; y++)
+			for (int x = -1; x < 2; x++)
+				expected.insert((x + 4) % 4 + 4 * ((y + 4) % 4) + 16 * ((z + 4) % 4));
+	ASSERT_EQ(27, out.size());
+	for (size_t i = 0; i < out.size(); i++) {
+		ASSERT_EQ(1, expected.erase(out[i]->getId().id()));
+	}
+
+	// a stencil wider than the grid visits each cell once
+	out.clear();
+	query.query(Point<int> (1, 2, 3), NeighborhoodStencil::moore(3, 2, true), out);
+	ASSERT_EQ(64, out.size());
+	for (size_t i = 0; i < out.size(); i++) {
+		expected.insert(out[i]->getId().id());
+	}
+	ASSERT_EQ(64, expected.size());
+}
+
+TEST(GridTest, FixedPointMoves)
+{
+	Context<TestAgent> context;
+
+	GridDimensions dims(Point<double> (15, 8));
+	Spaces<TestAgent>::SingleStrictDiscreteSpace* grid = new Spaces<TestAgent>::SingleStrictDiscreteSpace("grid", dims);
+	context.addProjection(grid);
+
+	for (int i = 0; i < 10; i++) {
+		TestAgent* agent = new TestAgent(i, 0, 0);
+		context.addAgent(agent);
+	}
+
+	TestAgent* zero = context.getAgent(AgentId(0, 0, 0));
+	ASSERT_TRUE(grid->moveTo(zero->getId(), Point<int, 2>(3, 4)));
+	Point<int, 2> out;
+	ASSERT_TRUE(grid->getLocation(zero->getId(), out));
+	ASSERT_EQ((Point<int, 2>(3, 4)), out);
+	ASSERT_EQ(zero, grid->getObjectAt(Point<int>(3, 4)));
+
+	// the fixed and the runtime points describe the same cell
+	std::vector<int> loc;
+	grid->getLocation(zero, loc);
+	ASSERT_EQ(3, loc[0]);
+	ASSERT_EQ(4, loc[1]);
+
+	pair<bool, Point<int, 2> > result = grid->moveByDisplacement(zero, Point<int, 2>(-2, 3));
+	ASSERT_TRUE(result.first);
+	ASSERT_EQ((Point<int, 2>(1, 7)), result.second);
+	ASSERT_EQ(zero, grid->getObjectAt(Point<int>(1, 7)));
+	ASSERT_TRUE(grid->getObjectAt(Point<int>(3, 4)) == 0);
+
+	// single occupancy still applies
+	TestAgent* one = context.getAgent(AgentId(1, 0, 0));
+	ASSERT_FALSE(grid->moveTo(one->getId(), Point<int, 2>(1, 7)));
+	ASSERT_FALSE(grid->getLocation(one->getId(), out));
+
+	// through the Grid interface
+	Grid<TestAgent, int>* base = grid;
+	ASSERT_TRUE(base->moveTo(one->getId(), Point<int, 2>(14, 0)));
+	ASSERT_EQ(one, grid->getObjectAt(Point<int>(14, 0)));
+
+	Point<int, 2> translated;
+	base->translate(Point<int, 2>(14, 0), Point<int, 2>(-4, 2), translated);
+	ASSERT_EQ((Point<int, 2>(10, 2)), translated);
+}
+
+TEST(GridTest, FixedPointMovesWrapped)
+{
+	Context<TestAgent> context;
+
+	GridDimensions dims(Point<double> (-5, 0, 2), Point<double> (10, 8, 4));
+	Spaces<TestAgent>::MultipleWrappedContinuousSpace* space =
+			new Spaces<TestAgent>::MultipleWrappedContinuousSpace("space", dims);
+	context.addProjection(space);
+
+	TestAgent* agent = new TestAgent(0, 0, 0);
+	context.addAgent(agent);
+
+	ASSERT_TRUE(space->moveTo(agent->getId(), Point<double, 3>(6.5, -1.5, 7)));
+	Point<double, 3> out;
+	ASSERT_TRUE(space->getLocation(agent->getId(), out));
+	ASSERT_NEAR(-3.5, out[0], .0001);
+	ASSERT_NEAR(6.5, out[1], .0001);
+	ASSERT_NEAR(3, out[2], .0001);
+
+	std::vector<double> loc;
+	space->getLocation(agent, loc);
+	ASSERT_EQ(Point<double>(loc), out.toPoint());
+
+	pair<bool, Point<double, 3> > result = space->moveByDisplacement(agent, Point<double, 3>(-2, 2, 4));
+	ASSERT_TRUE(result.first);
+	ASSERT_NEAR(4.5, result.second[0], .0001);
+	ASSERT_NEAR(0.5, result.second[1], .0001);
+	ASSERT_NEAR(3, result.second[2], .0001);
+
+	// the fixed transform agrees with the vector one
+	Point<double, 3> transformed;
+	space->transform(Point<double, 3>(-6, 9, 1.5), transformed);
+	std::vector<double> expected;
+	space->transform(Point<double>(-6, 9, 1.5).coords(), expected);
+	ASSERT_EQ(Point<double>(expected), transformed.toPoint());
+}
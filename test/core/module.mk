@@ -1,4 +1,5 @@
-SOURCES = context_test.cpp \
+SOURCES = agent_id_set_test.cpp \
+          context_test.cpp \
           grid_comp_test.cpp \
           grid_test.cpp \
           main.cpp \
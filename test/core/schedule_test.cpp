@@ -40,7 +40,10 @@
  */
 
 #include "repast_hpc/Schedule.h"
+#include "repast_hpc/Context.h"
 #include <gtest/gtest.h>
+#include <vector>
+#include <stdexcept>
 
 using namespace repast;
 
@@ -127,5 +130,311 @@ TEST_F(ScheduleTest, Mix) {
 	ASSERT_EQ(4.0, agent.y);
 }
 
+class Recorder {
 
+public:
+	Schedule* schedule;
+	std::vector<std::pair<double, int> >* log;
+	int id;
+
+	Recorder(Schedule* s, std::vector<std::pair<double, int> >* l, int i) : schedule(s), log(l), id(i) {}
+
+	void record() {
+		log->push_back(std::make_pair(schedule->getCurrentTick(), id));
+	}
+};
+
+class CalendarScheduleTest : public testing::Test {
+
+protected:
+
+	repast::Schedule s1;
+	std::vector<Recorder*> recorders;
+	std::vector<std::pair<double, int> > log;
+
+	CalendarScheduleTest() : s1(Schedule::CALENDAR) {}
+
+	~CalendarScheduleTest() {
+		for (size_t i = 0; i < recorders.size(); i++) {
+			delete recorders[i];
+		}
+	}
+
+	Schedule::FunctorPtr recorder(int id) {
+		recorders.push_back(new Recorder(&s1, &log, id));
+		return Schedule::FunctorPtr(new repast::MethodFunctor<Recorder>(recorders.back(), &Recorder::record));
+	}
+};
+
+TEST_F(CalendarScheduleTest, Repeat) {
+	TestAgent tf;
+	Schedule::FunctorPtr mf = Schedule::FunctorPtr(new repast::MethodFunctor<TestAgent>(&tf, &TestAgent::Repeat));
+	s1.schedule_event(1, 2, mf);
+	s1.execute();
+	ASSERT_EQ(1, tf._result);
+	ASSERT_EQ(3.0, s1.getNextTick());
+
+	int expected = 1;
+	for (int i = 1; i < 5; i++) {
+		s1.execute();
+		ASSERT_EQ(++expected, tf._result);
+		ASSERT_EQ(3.0 + (i * 2), s1.getNextTick());
+	}
+}
+
+TEST_F(CalendarScheduleTest, SameTickInScheduleOrder) {
+	s1.schedule_event(2, recorder(0));
+	s1.schedule_event(1.5, recorder(1));
+	s1.schedule_event(2, 1, recorder(2));
+	s1.schedule_event(2, recorder(3));
+	s1.schedule_event(1.25, recorder(4));
+
+	s1.execute();
+	s1.execute();
+	s1.execute();
+	ASSERT_EQ(5u, log.size());
+	ASSERT_EQ(std::make_pair(1.25, 4), log[0]);
+	ASSERT_EQ(std::make_pair(1.5, 1), log[1]);
+	ASSERT_EQ(std::make_pair(2.0, 0), log[2]);
+	ASSERT_EQ(std::make_pair(2.0, 2), log[3]);
+	ASSERT_EQ(std::make_pair(2.0, 3), log[4]);
+	ASSERT_EQ(3.0, s1.getNextTick());
+	ASSERT_EQ(1u, s1.size());
+}
+
+TEST_F(CalendarScheduleTest, MatchesHeap) {
+	// events spread well beyond the calendar's window, at fractional ticks
+	// and in the past of the window, must come out in the same tick order
+	// as from the heap
+	Schedule heap;
+	std::vector<double> ticks;
+	for (int i = 0; i < 500; i++) {
+		ticks.push_back((i * 7919) % 5000 + (i % 4) * 0.25);
+	}
+	ticks.push_back(-3);
+	for (size_t i = 0; i < ticks.size(); i++) {
+		s1.schedule_event(ticks[i], recorder(i));
+		heap.schedule_event(ticks[i], recorder(i));
+	}
+	s1.schedule_event(0.5, 1000, recorder(-1));
+	heap.schedule_event(0.5, 1000, recorder(-1));
+
+	int steps = 0;
+	while (heap.getNextTick() < 6000) {
+		ASSERT_EQ(heap.getNextTick(), s1.getNextTick());
+		heap.execute();
+		s1.execute();
+		ASSERT_EQ(heap.getCurrentTick(), s1.getCurrentTick());
+		ASSERT_EQ(heap.size(), s1.size());
+		steps++;
+	}
+	ASSERT_EQ(1u, s1.size());
+	ASSERT_EQ(6000.5, s1.getNextTick());
+	ASSERT_GT(steps, 400);
+}
+
+TEST_F(CalendarScheduleTest, SetQueueType) {
+	Schedule s2;
+	s2.schedule_event(3, recorder(0));
+	s2.schedule_event(1, 1, recorder(1));
+	s2.schedule_event(2000, recorder(2));
+	s2.execute();
+	s2.setQueueType(Schedule::CALENDAR);
+	ASSERT_EQ(Schedule::CALENDAR, s2.getQueueType());
+	ASSERT_EQ(3u, s2.size());
+	ASSERT_EQ(2.0, s2.getNextTick());
+	s2.execute();
+	s2.execute();
+	ASSERT_EQ(3.0, s2.getCurrentTick());
+	ASSERT_EQ(4.0, s2.getNextTick());
+	ASSERT_EQ(2u, s2.size());
+}
+
+struct AddTo {
+	int* target;
+	int amount;
+
+	void operator()() const {
+		*target += amount;
+	}
+};
+
+TEST_F(CalendarScheduleTest, InlineCalls) {
+	TestAgent once, repeat;
+	s1.schedule_call(1, methodCall(&once, &TestAgent::OneTime));
+	s1.schedule_call(1, 2, methodCall(&repeat, &TestAgent::Repeat), "repeat");
+	int total = 0;
+	AddTo add = { &total, 5 };
+	ScheduledEvent* evt = s1.schedule_call(3, add);
+	ASSERT_EQ("", evt->getLabel());
+
+	s1.execute();
+	ASSERT_EQ(1, once._result);
+	ASSERT_EQ(1, repeat._result);
+	s1.execute();
+	ASSERT_EQ(2, repeat._result);
+	ASSERT_EQ(5, total);
+	ASSERT_EQ(5.0, s1.getNextTick());
+	ASSERT_EQ(1u, s1.size());
+}
+
+TEST_F(ScheduleTest, BulkCalls) {
+	std::vector<TestAgent> agents(100);
+	std::vector<TestAgent*> pointers;
+	for (size_t i = 0; i < agents.size(); i++)
+		pointers.push_back(&agents[i]);
+	ASSERT_EQ(100u, s1.schedule_calls(2, pointers.begin(), pointers.end(), &TestAgent::Repeat));
+	ASSERT_EQ(50u, s1.schedule_calls(2, pointers.begin(), pointers.begin() + 50, &TestAgent::Repeat));
+	ASSERT_EQ(150u, s1.size());
+
+	s1.execute();
+	ASSERT_EQ(2.0, s1.getCurrentTick());
+	ASSERT_EQ(0u, s1.size());
+	for (size_t i = 0; i < agents.size(); i++)
+		ASSERT_EQ(i < 50 ? 2 : 1, agents[i]._result);
+}
+
+#ifdef REPAST_SCHEDULE_THREADS
+
+class Accumulator {
+
+public:
+	std::vector<long>* sums;
+	int index;
+
+	Accumulator(std::vector<long>* s, int i) : sums(s), index(i) {}
+
+	void sum() {
+		long total = 0;
+		for (long i = 0; i < 100000; i++)
+			total += i % (index + 2);
+		(*sums)[index] += total;
+	}
+};
+
+TEST_F(CalendarScheduleTest, ParallelGroups) {
+	const int count = 16;
+	std::vector<long> sums(count, 0);
+	std::vector<Accumulator*> accumulators;
+	s1.setThreadCount(4);
+	ASSERT_EQ(4, s1.getThreadCount());
+
+	s1.schedule_event(1, 1, recorder(0));
+	for (int i = 0; i < count; i++) {
+		accumulators.push_back(new Accumulator(&sums, i));
+		ScheduledEvent* evt = s1.schedule_event(1, 1, Schedule::FunctorPtr(new repast::MethodFunctor<Accumulator>(
+				accumulators.back(), &Accumulator::sum)));
+		evt->setParallelGroup(1 + i % 2);
+	}
+	s1.schedule_event(1, 1, recorder(1));
+	s1.schedule_event(2, recorder(2));
+
+	for (int t = 0; t < 3; t++)
+		s1.execute();
+
+	for (int i = 0; i < count; i++) {
+		long total = 0;
+		for (long j = 0; j < 100000; j++)
+			total += j % (i + 2);
+		ASSERT_EQ(3 * total, sums[i]);
+	}
+	ASSERT_EQ(7u, log.size());
+	// the one time event was scheduled before the repeating ones were rescheduled
+	ASSERT_EQ(std::make_pair(2.0, 2), log[2]);
+	ASSERT_EQ(std::make_pair(2.0, 0), log[3]);
+	ASSERT_EQ(std::make_pair(2.0, 1), log[4]);
+	ASSERT_EQ(3.0, s1.getCurrentTick());
+	ASSERT_EQ(count + 2u, s1.size());
+
+	for (size_t i = 0; i < accumulators.size(); i++)
+		delete accumulators[i];
+}
+
+
+class FailOnce {
+
+public:
+	int calls;
+	bool fail;
+
+	FailOnce(bool f) : calls(0), fail(f) {}
+
+	void call() {
+		calls++;
+		if (fail && calls == 1) throw std::runtime_error("event failed");
+	}
+};
+
+TEST_F(CalendarScheduleTest, ParallelGroupThrows) {
+	std::vector<FailOnce*> events;
+	s1.setThreadCount(2);
+	for (int i = 0; i < 4; i++) {
+		events.push_back(new FailOnce(i == 1));
+		ScheduledEvent* evt = s1.schedule_event(1, 1, Schedule::FunctorPtr(new repast::MethodFunctor<FailOnce>(
+				events.back(), &FailOnce::call)));
+		evt->setParallelGroup(1);
+	}
+
+	ASSERT_THROW(s1.execute(), std::runtime_error);
+	// the repeating events of the failed tick are still scheduled
+	ASSERT_EQ(4u, s1.size());
+
+	s1.execute();
+	ASSERT_EQ(2.0, s1.getCurrentTick());
+	for (size_t i = 0; i < events.size(); i++) {
+		ASSERT_EQ(2, events[i]->calls);
+		delete events[i];
+	}
+}
+
+class SlabAgent {
+
+private:
+	AgentId id;
+
+public:
+	SlabAgent(const AgentId& agentId) : id(agentId) {}
+
+	const AgentId& getId() const {
+		return id;
+	}
+};
+
+// Fills and empties its own SLABS context, whose shared_ptr control blocks
+// come from the process wide node pools
+class ContextChurn {
+
+public:
+	Context<SlabAgent> context;
+	int index;
+
+	ContextChurn(int i) : context(Context<SlabAgent>::SLABS), index(i) {}
+
+	void churn() {
+		for (int i = 0; i < 5000; i++)
+			context.addAgent(new SlabAgent(AgentId(i, index, 0)));
+		for (int i = 0; i < 5000; i += 2)
+			context.removeAgent(AgentId(i, index, 0));
+	}
+};
+
+TEST_F(CalendarScheduleTest, ParallelGroupsShareNodePools) {
+	std::vector<ContextChurn*> churns;
+	s1.setThreadCount(4);
+	for (int i = 0; i < 8; i++) {
+		churns.push_back(new ContextChurn(i));
+		ScheduledEvent* evt = s1.schedule_event(1, Schedule::FunctorPtr(new repast::MethodFunctor<ContextChurn>(
+				churns.back(), &ContextChurn::churn)));
+		evt->setParallelGroup(1);
+	}
+	s1.execute();
+
+	for (size_t i = 0; i < churns.size(); i++) {
+		ASSERT_EQ(2500, churns[i]->context.size());
+		for (int j = 0; j < 5000; j++)
+			ASSERT_EQ(j % 2 == 1, churns[i]->context.contains(AgentId(j, churns[i]->index, 0)));
+		delete churns[i];
+	}
+}
 
+#endif
@@ -0,0 +1,467 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*
+*   Redistribution and use in source and binary forms, with
+*   or without modification, are permitted provided that the following
+*   conditions are met:
+*
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * agent_sync_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/GridComponents.h"
+#include "repast_hpc/NeighborhoodCommunicator.h"
+
+#include "model_agent.h"
+
+#include <boost/serialization/vector.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <set>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace repast;
+
+namespace {
+
+const int AGENTS = 6;
+const int SLAB_WIDTH = 4;
+
+int stateOf(int id, int proc, int step) {
+	return step * 10000 + proc * 100 + id;
+}
+
+/**
+ * A context of ModelAgents on each process, whose states encode the
+ * agent and a step, that holds copies of some of the agents of the next
+ * two processes.
+ */
+class SyncModel {
+
+public:
+	SharedContext<ModelAgent> context;
+	AgentCreatorUpdater agents;
+	int rank, worldSize;
+
+	SyncModel(boost::mpi::communicator* comm) : context(comm), agents(&context), rank(comm->rank()), worldSize(comm->size()) {
+		for (int i = 0; i < AGENTS; i++)
+			context.addAgent(new ModelAgent(AgentId(i, rank, 0), stateOf(i, rank, 0)));
+	}
+
+	// Requests the agents first to last - 1 of the next process, and agent
+	// last of the one after that
+	template<typename Content = ModelAgentContent>
+	void requestAgents(int first, int last) {
+		AgentRequest request(rank);
+		if (worldSize > 1) {
+			int next = (rank + 1) % worldSize;
+			for (int i = first; i < last; i++)
+				request.addRequest(AgentId(i, next, 0));
+			int after = (rank + 2) % worldSize;
+			if (after != rank)
+				request.addRequest(AgentId(last, after, 0));
+		}
+		RepastProcess::instance()->requestAgents<ModelAgent, Content, AgentCreatorUpdater,
+				AgentCreatorUpdater, AgentCreatorUpdater>(context, request, agents, agents, agents);
+	}
+
+	void setLocalStates(int step) {
+		for (SharedContext<ModelAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd();
+				++iter)
+			(*iter)->state(stateOf((*iter)->getId().id(), rank, step));
+	}
+
+	// Checks that every copy has the state its owner gave it at the step
+	void checkCopies(int step) {
+		for (SharedContext<ModelAgent>::const_iterator iter = context.begin(); iter != context.end(); ++iter) {
+			const AgentId& id = (*iter)->getId();
+			if (id.currentRank() != rank) {
+				ASSERT_EQ(stateOf(id.id(), id.currentRank(), step), (*iter)->state());
+			}
+		}
+	}
+
+	// Every agent on this process, with its owner and state
+	std::set<std::string> snapshot() {
+		std::set<std::string> out;
+		for (SharedContext<ModelAgent>::const_iterator iter = context.begin(); iter != context.end(); ++iter) {
+			std::stringstream ss;
+			ss << (*iter)->getId() << " " << (*iter)->state();
+			out.insert(ss.str());
+		}
+		return out;
+	}
+};
+
+/**
+ * Requests agents in two rounds with the specified exchange, and returns
+ * the resulting agents and importer/exporter state.
+ */
+std::set<std::string> requestWith(RepastProcess::AGENT_REQUEST_EXCHANGE exchange, std::string& report) {
+	RepastProcess::init("");
+	std::set<std::string> snapshot;
+	{
+		SyncModel model(RepastProcess::instance()->getCommunicator());
+		RepastProcess::instance()->setAgentRequestExchange(exchange);
+		model.requestAgents(0, 2);
+		model.requestAgents(3, 5);
+		model.checkCopies(0);
+		snapshot = model.snapshot();
+		report = RepastProcess::instance()->ImporterExporterReport();
+	}
+	delete RepastProcess::instance();
+	return snapshot;
+}
+
+/**
+ * Requests agents, changes the local states and synchronizes them, either
+ * with synchronizeAgentStates or by beginning and finishing the
+ * synchronization, and returns the resulting agents.
+ */
+template<typename Content = ModelAgentContent>
+std::set<std::string> synchronizeWith(bool splitPhase) {
+	RepastProcess::init("");
+	std::set<std::string> snapshot;
+	{
+		SyncModel model(RepastProcess::instance()->getCommunicator());
+		model.template requestAgents<Content>(0, 2);
+		model.setLocalStates(1);
+		if (splitPhase) {
+			AgentStateSyncHandle<Content> handle;
+			RepastProcess::instance()->beginSynchronizeAgentStates(handle, model.agents);
+			// The states have been sent, so local agents may change in the meantime
+			model.setLocalStates(2);
+			RepastProcess::instance()->finishSynchronizeAgentStates(handle, model.agents);
+		} else {
+			RepastProcess::instance()->synchronizeAgentStates<Content>(model.agents, model.agents);
+			model.setLocalStates(2);
+		}
+		model.checkCopies(1);
+		snapshot = model.snapshot();
+	}
+	delete RepastProcess::instance();
+	return snapshot;
+}
+
+typedef SharedDiscreteSpace<ModelAgent, WrapAroundBorders, SimpleAdder<ModelAgent> > RingSpace;
+
+/**
+ * Agents on a one dimensional wrapped space divided into a ring of processes,
+ * two in every cell, that all move together one cell at a time; so every
+ * process always moves agents to the same neighbor and has agents in the
+ * buffers of both of its neighbors.
+ */
+class RingModel {
+
+public:
+	SharedContext<ModelAgent> context;
+	AgentCreatorUpdater agents;
+	RingSpace* space;
+	boost::mpi::communicator* comm;
+	int rank, width;
+
+	RingModel(boost::mpi::communicator* comm) : context(comm), agents(&context), comm(comm), rank(comm->rank()),
+			width(SLAB_WIDTH * comm->size()) {
+		GridDimensions dims(Point<double>(0), Point<double>(width));
+		std::vector<int> processDims(1, comm->size());
+		space = new RingSpace("ring_space", dims, processDims, 1, comm);
+		context.addProjection(space);
+
+		GridDimensions local = space->dimensions();
+		for (int i = 0; i < 2 * SLAB_WIDTH; i++) {
+			ModelAgent* agent = new ModelAgent(AgentId(i, rank, 0), stateOf(i, rank, 0));
+			context.addAgent(agent);
+			std::vector<int> pt(1, (int) local.origin(0) + i % SLAB_WIDTH);
+			space->moveTo(agent->getId(), pt);
+		}
+	}
+
+	// Moves every local agent dx cells, changes its state and synchronizes
+	template<typename Content = ModelAgentContent>
+	void step(int dx, int step, RepastProcess::EXCHANGE_PATTERN pattern) {
+		std::vector<ModelAgent*> local;
+		for (SharedContext<ModelAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd();
+				++iter)
+			local.push_back(iter->get());
+		for (size_t i = 0; i < local.size(); i++) {
+			const AgentId& id = local[i]->getId();
+			std::vector<int> pt;
+			space->getLocation(id, pt);
+			pt[0] = (pt[0] + dx + width) % width;
+			space->moveTo(id, pt);
+			local[i]->state(stateOf(id.id(), id.startingRank(), step));
+		}
+		space->balance();
+		RepastProcess::instance()->synchronizeAgentStatus<ModelAgent, Content, AgentCreatorUpdater,
+				AgentCreatorUpdater, AgentCreatorUpdater>(context, agents, agents, agents, pattern);
+		RepastProcess::instance()->synchronizeProjectionInfo<ModelAgent, Content, AgentCreatorUpdater,
+				AgentCreatorUpdater, AgentCreatorUpdater>(context, agents, agents, agents, pattern);
+		RepastProcess::instance()->synchronizeAgentStates<Content>(agents, agents);
+
+		// No agent is lost
+		int count = 0;
+		for (SharedContext<ModelAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd();
+				++iter)
+			count++;
+		ASSERT_EQ(width * 2, boost::mpi::all_reduce(*comm, count, std::plus<int>()));
+	}
+
+	// Every agent on this process, with its owner, state and location
+	std::set<std::string> snapshot() {
+		std::set<std::string> out;
+		for (SharedContext<ModelAgent>::const_iterator iter = context.begin(); iter != context.end(); ++iter) {
+			std::vector<int> pt;
+			space->getLocation((*iter)->getId(), pt);
+			std::stringstream ss;
+			ss << (*iter)->getId() << " " << (*iter)->state() << " " << pt[0];
+			out.insert(ss.str());
+		}
+		return out;
+	}
+};
+
+/**
+ * Moves the agents of a RingModel with the specified exchange pattern and
+ * returns the resulting agents.
+ */
+template<typename Content = ModelAgentContent>
+std::set<std::string> ringWith(RepastProcess::EXCHANGE_PATTERN pattern, bool useNeighborhood) {
+	RepastProcess::init("");
+	std::set<std::string> snapshot;
+	{
+		RingModel model(RepastProcess::instance()->getCommunicator());
+		RepastProcess::instance()->setUseNeighborhoodCollectives(useNeighborhood);
+		int step = 1;
+		for (; step <= 3; step++)
+			model.template step<Content>(1, step, pattern);
+		// Polling while agents move the other way changes the partners, so
+		// the neighborhood is rebuilt by the next step
+		model.template step<Content>(-1, step++, RepastProcess::POLL);
+		for (; step <= 7; step++)
+			model.template step<Content>(-1, step, pattern);
+		snapshot = model.snapshot();
+	}
+	delete RepastProcess::instance();
+	return snapshot;
+}
+
+// Sends each partner this process's rank and the partner's, and checks what is received
+void checkExchange(NeighborhoodCommunicator& neighborhood, const std::vector<int>& sends,
+		const std::vector<int>& recvs, int rank) {
+	std::map<int, std::vector<int>*> outgoing, incoming;
+	for (size_t i = 0; i < sends.size(); i++) {
+		std::vector<int>* ranks = new std::vector<int>();
+		ranks->push_back(rank);
+		ranks->push_back(sends[i]);
+		outgoing[sends[i]] = ranks;
+	}
+	neighborhood.exchange(outgoing, incoming);
+	ASSERT_EQ(recvs.size(), incoming.size());
+	for (size_t i = 0; i < recvs.size(); i++) {
+		std::vector<int>* ranks = incoming[recvs[i]];
+		ASSERT_TRUE(ranks != 0);
+		ASSERT_EQ(2u, ranks->size());
+		ASSERT_EQ(recvs[i], (*ranks)[0]);
+		ASSERT_EQ(rank, (*ranks)[1]);
+	}
+	for (std::map<int, std::vector<int>*>::iterator iter = outgoing.begin(); iter != outgoing.end(); ++iter)
+		delete iter->second;
+	for (std::map<int, std::vector<int>*>::iterator iter = incoming.begin(); iter != incoming.end(); ++iter)
+		delete iter->second;
+}
+
+}
+
+TEST(AgentSyncTests, SparseRequestExchangesMatchAllToAll)
+{
+	std::string allToAllReport;
+	std::set<std::string> allToAll = requestWith(RepastProcess::ALL_TO_ALL, allToAllReport);
+	boost::mpi::communicator world;
+	int copies = (world.size() > 1 ? 4 : 0) + (world.size() > 2 ? 2 : 0);
+	ASSERT_EQ(AGENTS + copies, (int) allToAll.size());
+
+	RepastProcess::AGENT_REQUEST_EXCHANGE sparse[] = { RepastProcess::SPARSE_COUNTS, RepastProcess::SPARSE_NBX };
+	for (int i = 0; i < 2; i++) {
+		std::string report;
+		ASSERT_TRUE(allToAll == requestWith(sparse[i], report));
+		ASSERT_EQ(allToAllReport, report);
+	}
+}
+
+TEST(AgentSyncTests, SplitPhaseMatchesSynchronizeAgentStates)
+{
+	ASSERT_TRUE(synchronizeWith(false) == synchronizeWith(true));
+}
+
+TEST(AgentSyncTests, SplitPhaseHandleMustBeBegunOnce)
+{
+	RepastProcess::init("");
+	{
+		SyncModel model(RepastProcess::instance()->getCommunicator());
+		model.requestAgents(0, 2);
+		AgentStateSyncHandle<ModelAgentContent> handle;
+		EXPECT_THROW(RepastProcess::instance()->finishSynchronizeAgentStates(handle, model.agents), Repast_Error_59);
+		RepastProcess::instance()->beginSynchronizeAgentStates(handle, model.agents);
+		EXPECT_THROW(RepastProcess::instance()->beginSynchronizeAgentStates(handle, model.agents), Repast_Error_58);
+		RepastProcess::instance()->finishSynchronizeAgentStates(handle, model.agents);
+		EXPECT_THROW(RepastProcess::instance()->finishSynchronizeAgentStates(handle, model.agents), Repast_Error_59);
+		model.checkCopies(0);
+	}
+	delete RepastProcess::instance();
+}
+
+TEST(AgentSyncTests, DeltaSyncSendsOnlyMarkedAgents)
+{
+	RepastProcess::init("");
+	{
+		SyncModel model(RepastProcess::instance()->getCommunicator());
+		model.requestAgents(0, 2);
+		RepastProcess::instance()->setDeltaAgentStateSync(true);
+		model.setLocalStates(1);
+		for (int i = 1; i < AGENTS; i += 2)
+			RepastProcess::instance()->markAgentDirty(AgentId(i, model.rank, 0));
+		RepastProcess::instance()->synchronizeAgentStates<ModelAgentContent>(model.agents, model.agents);
+
+		// Copies of the odd (marked) agents are updated, the others keep their old state
+		for (SharedContext<ModelAgent>::const_iterator iter = model.context.begin(); iter != model.context.end(); ++iter) {
+			const AgentId& id = (*iter)->getId();
+			if (id.currentRank() != model.rank) {
+				ASSERT_EQ(stateOf(id.id(), id.currentRank(), id.id() % 2), (*iter)->state());
+			}
+		}
+
+		// Synchronizing cleared the marks, so nothing more is sent
+		model.setLocalStates(2);
+		RepastProcess::instance()->synchronizeAgentStates<ModelAgentContent>(model.agents, model.agents);
+		for (SharedContext<ModelAgent>::const_iterator iter = model.context.begin(); iter != model.context.end(); ++iter) {
+			const AgentId& id = (*iter)->getId();
+			if (id.currentRank() != model.rank) {
+				ASSERT_EQ(stateOf(id.id(), id.currentRank(), id.id() % 2), (*iter)->state());
+			}
+		}
+
+		// Full synchronization sends every state again
+		RepastProcess::instance()->setDeltaAgentStateSync(false);
+		RepastProcess::instance()->synchronizeAgentStates<ModelAgentContent>(model.agents, model.agents);
+		model.checkCopies(2);
+	}
+	delete RepastProcess::instance();
+}
+
+TEST(AgentSyncTests, NeighborhoodCollectivesMatchPointToPoint)
+{
+	// A wrapped space needs a neighbor on each side that is not this process
+	boost::mpi::communicator world;
+	if (world.size() == 1) return;
+
+	RepastProcess::EXCHANGE_PATTERN patterns[] = { RepastProcess::USE_LAST_OR_POLL,
+			RepastProcess::USE_LAST_OR_USE_CURRENT };
+	for (int i = 0; i < 2; i++)
+		ASSERT_TRUE(ringWith(patterns[i], false) == ringWith(patterns[i], true));
+}
+
+TEST(AgentSyncTests, NeighborhoodRebuiltOnlyWhenPartnersChange)
+{
+	boost::mpi::communicator world;
+	int rank = world.rank();
+	std::vector<int> next(1, (rank + 1) % world.size());
+	std::vector<int> previous(1, (rank + world.size() - 1) % world.size());
+	NeighborhoodCommunicator neighborhood(&world);
+
+	ASSERT_TRUE(neighborhood.update(next, previous));
+	checkExchange(neighborhood, next, previous, rank);
+	ASSERT_FALSE(neighborhood.update(next, previous));
+	checkExchange(neighborhood, next, previous, rank);
+
+	// Reversing the ring changes the partners unless next and previous are the same
+	ASSERT_EQ(world.size() > 2, neighborhood.update(previous, next));
+	checkExchange(neighborhood, previous, next, rank);
+}
+
+TEST(AgentSyncTests, RawContentMatchesSerialized)
+{
+	// requestAgents and agent state synchronization
+	std::set<std::string> serialized = synchronizeWith(false);
+	ASSERT_TRUE(serialized == synchronizeWith<RawModelAgentContent>(false));
+	ASSERT_TRUE(serialized == synchronizeWith<RawModelAgentContent>(true));
+
+	// agent status and projection information synchronization
+	boost::mpi::communicator world;
+	if (world.size() == 1) return;
+	RepastProcess::EXCHANGE_PATTERN patterns[] = { RepastProcess::POLL, RepastProcess::USE_LAST_OR_USE_CURRENT };
+	for (int i = 0; i < 2; i++)
+		ASSERT_TRUE(ringWith(patterns[i], false) == ringWith<RawModelAgentContent>(patterns[i], false));
+}
+
+TEST(AgentSyncTests, RawHandlesFinishedOutOfOrder)
+{
+	RepastProcess::init("");
+	{
+		SyncModel model(RepastProcess::instance()->getCommunicator());
+		model.requestAgents<RawModelAgentContent>(0, 2);
+		AgentStateSyncHandle<RawModelAgentContent> first, second;
+		model.setLocalStates(1);
+		RepastProcess::instance()->beginSynchronizeAgentStates(first, model.agents);
+		model.setLocalStates(2);
+		RepastProcess::instance()->beginSynchronizeAgentStates(second, model.agents);
+
+		// Each handle receives the states that were sent when it was begun
+		RepastProcess::instance()->finishSynchronizeAgentStates(second, model.agents);
+		model.checkCopies(2);
+		RepastProcess::instance()->finishSynchronizeAgentStates(first, model.agents);
+		model.checkCopies(1);
+
+		// Every exchange in flight has its own tag, and there are only so many
+		boost::ptr_vector<AgentStateSyncHandle<RawModelAgentContent> > handles;
+		for (int i = 0; i < AGENT_STATE_CONTENT_TAGS; i++) {
+			handles.push_back(new AgentStateSyncHandle<RawModelAgentContent>());
+			RepastProcess::instance()->beginSynchronizeAgentStates(handles.back(), model.agents);
+		}
+		AgentStateSyncHandle<RawModelAgentContent> tooMany;
+		EXPECT_THROW(RepastProcess::instance()->beginSynchronizeAgentStates(tooMany, model.agents), Repast_Error_66);
+		for (int i = AGENT_STATE_CONTENT_TAGS - 1; i >= 0; i--)
+			RepastProcess::instance()->finishSynchronizeAgentStates(handles[i], model.agents);
+		RepastProcess::instance()->beginSynchronizeAgentStates(tooMany, model.agents);
+		model.setLocalStates(3);
+		RepastProcess::instance()->finishSynchronizeAgentStates(tooMany, model.agents);
+		model.checkCopies(2);
+	}
+	delete RepastProcess::instance();
+}
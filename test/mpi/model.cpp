@@ -46,13 +46,6 @@
 
 using namespace repast;
 
-ModelAgent::ModelAgent(AgentId id, int state) :
-	_id(id), _state(state) {
-}
-
-ModelAgent::~ModelAgent() {
-}
-
 ModelEdge::ModelEdge(ModelAgent* source, ModelAgent* target) :
 	RepastEdge<ModelAgent> (source, target), _state(1) {
 
@@ -140,12 +133,6 @@ void Model::createAgents(const std::vector<ModelAgentContent>& contents, std::ve
 	}
 }
 
-ModelAgent* AgentCreatorUpdater::createAgent(const ModelAgentContent& content) {
-	AgentId id = content.getId();
-	int state = content.state;
-	return new ModelAgent(id, state);
-}
-void AgentCreatorUpdater::updateAgent(const ModelAgentContent& content) {
-	ModelAgent* agent = _model->agents.getAgent(content.getId());
-	agent->state(content.state);
+AgentCreatorUpdater::AgentCreatorUpdater(Model* model) :
+	_context(&model->agents) {
 }
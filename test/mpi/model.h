@@ -47,29 +47,11 @@
 #include "repast_hpc/RepastProcess.h"
 #include "repast_hpc/SharedNetwork.h"
 #include "repast_hpc/SharedSpace.h"
+#include "model_agent.h"
 #include <vector>
 
 #include <boost/serialization/access.hpp>
 
-struct ModelAgentContent {
-
-	friend class boost::serialization::access;
-	template<class Archive>
-	void serialize(Archive& ar, const unsigned int version) {
-		ar & id;
-		ar & state;
-	}
-
-	repast::AgentId id;
-	int state;
-
-	repast::AgentId getId() const {
-		return id;
-	}
-};
-
-//BOOST_IS_MPI_DATATYPE(ModelAgentContent)
-
 struct EdgeContent {
 
 	friend class boost::serialization::access;
@@ -88,34 +70,6 @@ struct EdgeContent {
 
 //BOOST_IS_MPI_DATATYPE(EdgeContent)
 
-class ModelAgent: public repast::Agent {
-
-private:
-	repast::AgentId _id;
-	int _state;
-
-public:
-
-	ModelAgent(repast::AgentId id, int state);
-	virtual ~ModelAgent();
-
-	int state() const {
-		return _state;
-	}
-
-	void state(int val) {
-		_state = val;
-	}
-
-	virtual repast::AgentId& getId() {
-		return _id;
-	}
-
-	virtual const repast::AgentId& getId() const {
-		return _id;
-	}
-};
-
 class ModelEdge: public repast::RepastEdge<ModelAgent> {
 
 private:
@@ -161,18 +115,4 @@ public:
 	void provideContent(ModelAgent* agent, std::vector<ModelAgentContent>& out) ;
 };
 
-class AgentCreatorUpdater {
-private:
-	Model* _model;
-
-public:
-	AgentCreatorUpdater(Model* model) :
-		_model(model) {
-	}
-	virtual ~AgentCreatorUpdater() {
-	}
-	ModelAgent* createAgent(const ModelAgentContent& content);
-	void updateAgent(const ModelAgentContent& content);
-};
-
 #endif /* MODEL_H_ */
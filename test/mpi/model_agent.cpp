@@ -0,0 +1,90 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * model_agent.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "model_agent.h"
+
+using namespace repast;
+
+ModelAgent::ModelAgent(AgentId id, int state) :
+	_id(id), _state(state) {
+}
+
+ModelAgent::~ModelAgent() {
+}
+
+void AgentCreatorUpdater::provideContent(const AgentRequest& request, std::vector<ModelAgentContent>& out) {
+	const std::vector<AgentId>& ids = request.requestedAgents();
+	for (size_t i = 0; i < ids.size(); i++) {
+		ModelAgent* agent = _context->getAgent(ids[i]);
+		ModelAgentContent content = { agent->getId(), agent->state() };
+		out.push_back(content);
+	}
+}
+
+ModelAgent* AgentCreatorUpdater::createAgent(const ModelAgentContent& content) {
+	AgentId id = content.getId();
+	int state = content.state;
+	return new ModelAgent(id, state);
+}
+
+void AgentCreatorUpdater::updateAgent(const ModelAgentContent& content) {
+	ModelAgent* agent = _context->getAgent(content.getId());
+	agent->state(content.state);
+}
+
+void AgentCreatorUpdater::provideContent(const AgentRequest& request, std::vector<RawModelAgentContent>& out) {
+	const std::vector<AgentId>& ids = request.requestedAgents();
+	for (size_t i = 0; i < ids.size(); i++) {
+		ModelAgent* agent = _context->getAgent(ids[i]);
+		const AgentId& id = agent->getId();
+		RawModelAgentContent content = { id.id(), id.startingRank(), id.agentType(), id.currentRank(), agent->state() };
+		out.push_back(content);
+	}
+}
+
+ModelAgent* AgentCreatorUpdater::createAgent(const RawModelAgentContent& content) {
+	return new ModelAgent(content.getId(), content.state);
+}
+
+void AgentCreatorUpdater::updateAgent(const RawModelAgentContent& content) {
+	ModelAgent* agent = _context->getAgent(content.getId());
+	agent->state(content.state);
+}
@@ -0,0 +1,153 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * model_agent.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef MODEL_AGENT_H_
+#define MODEL_AGENT_H_
+
+#include "repast_hpc/AgentId.h"
+#include "repast_hpc/AgentRequest.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/RawContent.h"
+#include <vector>
+
+#include <boost/serialization/access.hpp>
+
+class Model;
+
+struct ModelAgentContent {
+
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & state;
+	}
+
+	repast::AgentId id;
+	int state;
+
+	repast::AgentId getId() const {
+		return id;
+	}
+};
+
+//BOOST_IS_MPI_DATATYPE(ModelAgentContent)
+
+/**
+ * The same state as ModelAgentContent, in a trivially copyable struct that
+ * is sent raw (see REPAST_RAW_CONTENT below).
+ */
+struct RawModelAgentContent {
+
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & startingRank;
+		ar & type;
+		ar & currentRank;
+		ar & state;
+	}
+
+	int id, startingRank, type, currentRank;
+	int state;
+
+	repast::AgentId getId() const {
+		return repast::AgentId(id, startingRank, type, currentRank);
+	}
+};
+
+REPAST_RAW_CONTENT(RawModelAgentContent)
+
+class ModelAgent: public repast::Agent {
+
+private:
+	repast::AgentId _id;
+	int _state;
+
+public:
+
+	ModelAgent(repast::AgentId id, int state);
+	virtual ~ModelAgent();
+
+	int state() const {
+		return _state;
+	}
+
+	void state(int val) {
+		_state = val;
+	}
+
+	virtual repast::AgentId& getId() {
+		return _id;
+	}
+
+	virtual const repast::AgentId& getId() const {
+		return _id;
+	}
+};
+
+/**
+ * Provides, creates and updates the ModelAgents in a SharedContext, and so
+ * can be passed as the provider, creator and updater to the RepastProcess
+ * synchronize methods.
+ */
+class AgentCreatorUpdater {
+private:
+	repast::SharedContext<ModelAgent>* _context;
+
+public:
+	AgentCreatorUpdater(Model* model);
+	AgentCreatorUpdater(repast::SharedContext<ModelAgent>* context) :
+		_context(context) {
+	}
+	virtual ~AgentCreatorUpdater() {
+	}
+	void provideContent(const repast::AgentRequest& request, std::vector<ModelAgentContent>& out);
+	ModelAgent* createAgent(const ModelAgentContent& content);
+	void updateAgent(const ModelAgentContent& content);
+
+	void provideContent(const repast::AgentRequest& request, std::vector<RawModelAgentContent>& out);
+	ModelAgent* createAgent(const RawModelAgentContent& content);
+	void updateAgent(const RawModelAgentContent& content);
+};
+
+#endif /* MODEL_AGENT_H_ */
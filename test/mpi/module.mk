@@ -1,6 +1,13 @@
 SOURCES = main.cpp \
           model.cpp \
-          rscpp_mpi_tests.cpp
+          model_agent.cpp \
+          rscpp_mpi_tests.cpp \
+          agent_sync_test.cpp \
+          synchronize_test.cpp \
+          repartition_test.cpp \
+          space_query_test.cpp \
+          schedule_runner_test.cpp \
+          sync_profiler_test.cpp
          
 
 local_dir := test/mpi
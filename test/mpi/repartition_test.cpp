@@ -0,0 +1,215 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*
+*   Redistribution and use in source and binary forms, with
+*   or without modification, are permitted provided that the following
+*   conditions are met:
+*
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * repartition_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/GridComponents.h"
+#include "repast_hpc/ValueLayerND.h"
+
+#include "model_agent.h"
+
+#include <vector>
+
+using namespace repast;
+
+namespace {
+
+const int SLAB_WIDTH = 10;
+const int HEIGHT = 10;
+const int CROWDED_AGENTS = 200;
+const int SPARSE_AGENTS = 10;
+
+typedef SharedDiscreteSpace<ModelAgent, StrictBorders, SimpleAdder<ModelAgent> > BalanceSpace;
+
+/**
+ * Agents on a space divided into a row of processes, with all but a few
+ * of them crowded into the slab of process 0, and a value layer sharing
+ * the space's process topology whose value at each cell encodes the cell.
+ */
+class BalanceModel {
+
+public:
+	SharedContext<ModelAgent> context;
+	AgentCreatorUpdater agents;
+	BalanceSpace* space;
+	ValueLayerND<double>* layer;
+	std::vector<int> processDims;
+	int rank, worldSize;
+
+	BalanceModel(boost::mpi::communicator* comm) : context(comm), agents(&context), rank(comm->rank()), worldSize(comm->size()) {
+		GridDimensions dims(Point<double>(0, 0), Point<double>(SLAB_WIDTH * worldSize, HEIGHT));
+		processDims.push_back(worldSize);
+		processDims.push_back(1);
+		space = new BalanceSpace("balance_space", dims, processDims, 1, comm);
+		context.addProjection(space);
+		layer = new ValueLayerND<double>(processDims, dims, 1, false);
+
+		GridDimensions local = space->dimensions();
+		int count = (rank == 0 ? CROWDED_AGENTS : SPARSE_AGENTS);
+		for (int i = 0; i < count; i++) {
+			ModelAgent* agent = new ModelAgent(AgentId(i, rank, 0), 0);
+			context.addAgent(agent);
+			std::vector<int> pt;
+			pt.push_back((int) local.origin(0) + i % SLAB_WIDTH);
+			pt.push_back(i / SLAB_WIDTH % HEIGHT);
+			space->moveTo(agent->getId(), pt);
+		}
+
+		forEachLocalCell(&BalanceModel::setCell);
+		layer->synchronize();
+	}
+
+	~BalanceModel() {
+		delete layer;
+	}
+
+	static double cellValue(const std::vector<int>& cell) {
+		return cell[0] * 100 + cell[1];
+	}
+
+	void setCell(const std::vector<int>& cell) {
+		bool err;
+		layer->setValueAt(cellValue(cell), cell, err);
+	}
+
+	void checkCell(const std::vector<int>& cell) {
+		bool err;
+		ASSERT_EQ(cellValue(cell), layer->getValueAt(cell, err));
+	}
+
+	void forEachLocalCell(void (BalanceModel::*fn)(const std::vector<int>&)) {
+		GridDimensions local = layer->getLocalBoundaries();
+		std::vector<int> cell(2);
+		for (cell[0] = (int) local.origin(0); cell[0] < (int) (local.origin(0) + local.extents(0)); cell[0]++)
+			for (cell[1] = (int) local.origin(1); cell[1] < (int) (local.origin(1) + local.extents(1)); cell[1]++)
+				(this->*fn)(cell);
+	}
+
+	bool repartition() {
+		bool changed = space->repartition();
+		RepastProcess::instance()->synchronizeAgentStatus<ModelAgent, ModelAgentContent, AgentCreatorUpdater,
+				AgentCreatorUpdater, AgentCreatorUpdater>(context, agents, agents, agents);
+		RepastProcess::instance()->synchronizeProjectionInfo<ModelAgent, ModelAgentContent, AgentCreatorUpdater,
+				AgentCreatorUpdater, AgentCreatorUpdater>(context, agents, agents, agents);
+		layer->synchronize();
+		return changed;
+	}
+
+	int localCount() {
+		int count = 0;
+		for (SharedContext<ModelAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd();
+				++iter)
+			count++;
+		return count;
+	}
+};
+
+}
+
+TEST(RepartitionTests, MovesBoundariesTowardEqualWork)
+{
+	RepastProcess::init("");
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	{
+		BalanceModel model(comm);
+		int total = CROWDED_AGENTS + SPARSE_AGENTS * (comm->size() - 1);
+		int before = boost::mpi::all_reduce(*comm, model.localCount(), boost::mpi::maximum<int>());
+
+		bool changed = false;
+		for (int i = 0; i < comm->size() + 2; i++)
+			changed = model.repartition() || changed;
+		ASSERT_EQ(comm->size() > 1, changed);
+
+		// No agent is lost, and each is on the process whose bounds it is in
+		ASSERT_EQ(total, boost::mpi::all_reduce(*comm, model.localCount(), std::plus<int>()));
+		GridDimensions local = model.space->dimensions();
+		for (SharedContext<ModelAgent>::const_local_iterator iter = model.context.localBegin();
+				iter != model.context.localEnd(); ++iter) {
+			std::vector<int> pt;
+			model.space->getLocation((*iter)->getId(), pt);
+			ASSERT_TRUE(local.contains(pt));
+		}
+
+		int after = boost::mpi::all_reduce(*comm, model.localCount(), boost::mpi::maximum<int>());
+		if (comm->size() > 1) {
+			ASSERT_LT(after, before);
+			if (comm->rank() == 0) {
+				ASSERT_LT(local.extents(0), SLAB_WIDTH);
+			}
+		}
+
+		// The value layer follows the space, and its values follow the cells
+		GridDimensions layerLocal = model.layer->getLocalBoundaries();
+		ASSERT_EQ(local.origin(0), layerLocal.origin(0));
+		ASSERT_EQ(local.extents(0), layerLocal.extents(0));
+		model.forEachLocalCell(&BalanceModel::checkCell);
+		if (local.origin(0) > 0) {
+			std::vector<int> buffered;
+			buffered.push_back((int) local.origin(0) - 1);
+			buffered.push_back(0);
+			model.checkCell(buffered);
+		}
+	}
+	delete RepastProcess::instance();
+}
+
+TEST(RepartitionTests, BalancedLoadIsLeftAlone)
+{
+	RepastProcess::init("");
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	{
+		BalanceModel model(comm);
+		// Agent cost that makes every process's load equal
+		struct EqualCost {
+			double operator()(const ModelAgent* agent) const {
+				return agent->getId().startingRank() == 0 ? SPARSE_AGENTS / (double) CROWDED_AGENTS : 1;
+			}
+		} cost;
+		GridDimensions before = model.space->dimensions();
+		ASSERT_FALSE(model.space->repartition(cost));
+		ASSERT_EQ(before.origin(0), model.space->dimensions().origin(0));
+		ASSERT_EQ(before.extents(0), model.space->dimensions().extents(0));
+	}
+	delete RepastProcess::instance();
+}
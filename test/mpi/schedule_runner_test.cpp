@@ -0,0 +1,166 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*
+*   Redistribution and use in source and binary forms, with
+*   or without modification, are permitted provided that the following
+*   conditions are met:
+*
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * schedule_runner_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/Schedule.h"
+#include "repast_hpc/ScheduleProfiler.h"
+#include "repast_hpc/RepastProcess.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+#include <boost/lexical_cast.hpp>
+
+using namespace repast;
+
+namespace {
+
+const double STOP_TICK = 40;
+const double COLLECTIVE_INTERVAL = 5;
+
+/**
+ * Records the ticks at which it executes. Every process schedules it
+ * at different ticks, and also schedules collective() at the same ticks
+ * on every process.
+ */
+class TickRecorder {
+
+public:
+	ScheduleRunner* runner;
+	boost::mpi::communicator* comm;
+	std::vector<double> ticks;
+	std::vector<int> sums;
+
+	TickRecorder(ScheduleRunner* r, boost::mpi::communicator* c) : runner(r), comm(c) {}
+
+	void record() {
+		ticks.push_back(runner->currentTick());
+	}
+
+	void collective() {
+		int sum = 0;
+		boost::mpi::all_reduce(*comm, (int) ticks.size(), sum, std::plus<int>());
+		sums.push_back(sum);
+	}
+};
+
+void runSchedule(boost::mpi::communicator& comm, double lookahead, TickRecorder*& recorder) {
+	ScheduleRunner* runner = new ScheduleRunner(&comm);
+	runner->setLookahead(lookahead);
+	recorder = new TickRecorder(runner, &comm);
+	int rank = comm.rank();
+	runner->scheduleEvent(1 + rank * 0.5, rank + 1, Schedule::FunctorPtr(new MethodFunctor<TickRecorder>(recorder,
+			&TickRecorder::record)));
+	runner->scheduleEvent(30.25 + rank, Schedule::FunctorPtr(new MethodFunctor<TickRecorder>(recorder,
+			&TickRecorder::record)));
+	runner->scheduleEvent(COLLECTIVE_INTERVAL, COLLECTIVE_INTERVAL, Schedule::FunctorPtr(
+			new MethodFunctor<TickRecorder>(recorder, &TickRecorder::collective)));
+	runner->scheduleStop(STOP_TICK);
+	runner->run();
+	delete runner;
+}
+
+}
+
+TEST(ScheduleRunner, LookaheadExecutesTheSameEvents) {
+	boost::mpi::communicator world;
+	TickRecorder* lockstep;
+	runSchedule(world, 0, lockstep);
+	double lookaheads[] = { 1, 7.5, 100 };
+	for (size_t i = 0; i < 3; i++) {
+		TickRecorder* windowed;
+		runSchedule(world, lookaheads[i], windowed);
+		ASSERT_EQ(lockstep->ticks, windowed->ticks);
+		ASSERT_EQ(lockstep->sums, windowed->sums);
+		delete windowed;
+	}
+	ASSERT_EQ(STOP_TICK / COLLECTIVE_INTERVAL, lockstep->sums.size());
+	delete lockstep;
+}
+
+TEST(ScheduleRunner, NegativeLookahead) {
+	boost::mpi::communicator world;
+	RepastProcess::init("", &world);
+	ScheduleRunner runner(&world);
+	ASSERT_THROW(runner.setLookahead(-1), std::invalid_argument);
+	ASSERT_EQ(0, runner.getLookahead());
+}
+
+TEST(ScheduleRunner, ProfilesLabelledEvents) {
+	boost::mpi::communicator world;
+	ScheduleRunner runner(&world);
+	runner.setProfiling(true, "./schedule_profile_test.csv");
+	TickRecorder recorder(&runner, &world);
+	runner.scheduleEvent(1, 1, Schedule::FunctorPtr(new MethodFunctor<TickRecorder>(&recorder, &TickRecorder::record)),
+			"record");
+	// only rank 0 executes the collective label, so it is missing on the other ranks
+	if (world.rank() == 0)
+		runner.scheduleEvent(2.5, Schedule::FunctorPtr(new MethodFunctor<TickRecorder>(&recorder,
+				&TickRecorder::record)), "rank 0 only");
+	runner.scheduleStop(10);
+	runner.run();
+
+	ASSERT_EQ(10, runner.profiler()->calls("record"));
+	ASSERT_EQ(world.rank() == 0 ? 1 : 0, runner.profiler()->calls("rank 0 only"));
+	ASSERT_EQ(1, runner.profiler()->calls(""));
+	ASSERT_EQ(0, ScheduleProfiler::bin(0.5e-6));
+	ASSERT_EQ(1, ScheduleProfiler::bin(1.5e-6));
+	ASSERT_EQ(ScheduleProfiler::BIN_COUNT - 1, ScheduleProfiler::bin(1000));
+
+	if (world.rank() == 0) {
+		std::ifstream in("./schedule_profile_test.csv");
+		std::vector<std::string> lines;
+		std::string line;
+		while (std::getline(in, line))
+			lines.push_back(line);
+		ASSERT_EQ(4u, lines.size());
+		ASSERT_EQ(0u, lines[0].find("label,processes,calls,"));
+		ASSERT_EQ(0u, lines[1].find("rank 0 only,1,1,"));
+		ASSERT_EQ(0u, lines[2].find("record," + boost::lexical_cast<std::string>(world.size()) + ","
+				+ boost::lexical_cast<std::string>(10 * world.size()) + ","));
+		ASSERT_EQ(0u, lines[3].find("unlabeled,"));
+	}
+	world.barrier();
+	if (world.rank() == 0) std::remove("./schedule_profile_test.csv");
+}
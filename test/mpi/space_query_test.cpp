@@ -0,0 +1,267 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*
+*   Redistribution and use in source and binary forms, with
+*   or without modification, are permitted provided that the following
+*   conditions are met:
+*
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * space_query_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedContinuousSpace.h"
+#include "repast_hpc/GridComponents.h"
+#include "repast_hpc/ValueLayerND.h"
+#include "repast_hpc/NDValueLayerQuery.h"
+
+#include "model_agent.h"
+
+#include <set>
+#include <vector>
+#include <algorithm>
+
+using namespace repast;
+
+namespace {
+
+const int SLAB_WIDTH = 10;
+const int HEIGHT = 10;
+const int AGENTS = 300;
+
+/**
+ * Places agents at scattered locations on this process's part of a
+ * continuous space divided into a row of processes, and checks the
+ * space's radius and box queries against a scan of all its agents.
+ */
+template<typename GPTransformer>
+void checkQueries(bool periodic) {
+	typedef SharedContinuousSpace<ModelAgent, GPTransformer, SimpleAdder<ModelAgent> > QuerySpace;
+
+	boost::mpi::communicator world;
+	RepastProcess::init("", &world);
+	int rank = world.rank();
+	SharedContext<ModelAgent> context(&world);
+	GridDimensions dims(Point<double>(0, 0), Point<double>(SLAB_WIDTH * world.size(), HEIGHT));
+	std::vector<int> processDims;
+	processDims.push_back(world.size());
+	processDims.push_back(1);
+	QuerySpace* space = new QuerySpace("query_space", dims, processDims, 1, &world);
+	context.addProjection(space);
+	space->setBinWidth(1.5);
+
+	GridDimensions local = space->dimensions();
+	for (int i = 0; i < AGENTS; i++) {
+		ModelAgent* agent = new ModelAgent(AgentId(i, rank, 0), 0);
+		context.addAgent(agent);
+		std::vector<double> pt;
+		pt.push_back(local.origin(0) + (i * 7919 % 1000) / 1000.0 * SLAB_WIDTH);
+		pt.push_back((i * 104729 % 1000) / 1000.0 * HEIGHT);
+		space->moveTo(agent->getId(), pt);
+	}
+
+	std::vector<Point<double> > centers;
+	centers.push_back(Point<double>(local.origin(0) + 5, 5));
+	centers.push_back(Point<double>(local.origin(0) + 0.5, 0.5));
+	centers.push_back(Point<double>(local.origin(0) + SLAB_WIDTH - 0.2, HEIGHT - 0.2));
+	double radii[] = { 0.5, 1.3, 3 };
+
+	for (size_t c = 0; c < centers.size(); c++) {
+		for (int r = 0; r < 3; r++) {
+			std::vector<ModelAgent*> found;
+			space->getAgentsWithin(centers[c], radii[r], found);
+			std::set<ModelAgent*> foundSet(found.begin(), found.end());
+			ASSERT_EQ(found.size(), foundSet.size());
+
+			std::set<ModelAgent*> expected;
+			for (typename QuerySpace::const_iterator iter = space->begin(); iter != space->end(); ++iter) {
+				std::vector<double> location;
+				space->getLocation((*iter)->getId(), location);
+				if (space->getDistanceSq(centers[c], Point<double>(location)) <= radii[r] * radii[r])
+					expected.insert((*iter).get());
+			}
+			ASSERT_TRUE(expected == foundSet);
+		}
+	}
+
+	// The k nearest agents, nearest first, against a sorted scan; a single
+	// process sees the whole space, so its answers are always complete
+	int ks[] = { 1, 5, 20, AGENTS + 1 };
+	for (size_t c = 0; c < centers.size(); c++) {
+		for (int i = 0; i < 4; i++) {
+			std::vector<ModelAgent*> nearest;
+			bool complete = space->getNearestAgents(centers[c], ks[i], nearest);
+			if (world.size() == 1) {
+				ASSERT_TRUE(complete);
+			}
+			if (ks[i] > AGENTS) {
+				ASSERT_EQ(world.size() == 1, complete);
+			}
+
+			std::vector<double> expected;
+			for (typename QuerySpace::const_iterator iter = space->begin(); iter != space->end(); ++iter) {
+				std::vector<double> location;
+				space->getLocation((*iter)->getId(), location);
+				expected.push_back(space->getDistanceSq(centers[c], Point<double>(location)));
+			}
+			std::sort(expected.begin(), expected.end());
+			expected.resize(std::min((size_t) ks[i], expected.size()));
+
+			ASSERT_EQ(expected.size(), nearest.size());
+			for (size_t j = 0; j < nearest.size(); j++) {
+				std::vector<double> location;
+				space->getLocation(nearest[j]->getId(), location);
+				ASSERT_NEAR(expected[j], space->getDistanceSq(centers[c], Point<double>(location)), 1e-9);
+			}
+		}
+	}
+
+	// A box over the lower left corner, which continues across both borders if periodic
+	Point<double> lower(local.origin(0) - 1, -1);
+	Point<double> upper(local.origin(0) + 2, 2);
+	std::vector<ModelAgent*> found;
+	space->getAgentsInBox(lower, upper, found);
+	std::set<ModelAgent*> foundSet(found.begin(), found.end());
+	std::set<ModelAgent*> expected;
+	for (typename QuerySpace::const_iterator iter = space->begin(); iter != space->end(); ++iter) {
+		std::vector<double> location;
+		space->getLocation((*iter)->getId(), location);
+		bool in = true;
+		for (int i = 0; i < 2; i++) {
+			double extent = dims.extents(i);
+			double coord = location[i];
+			if (periodic && coord > upper[i]) coord -= extent;
+			in = in && coord >= lower[i] && coord <= upper[i];
+		}
+		if (in) expected.insert((*iter).get());
+	}
+	ASSERT_EQ(found.size(), foundSet.size());
+	ASSERT_TRUE(expected == foundSet);
+}
+
+
+int cellValue(int x, int y) {
+	return x + 1000 * y;
+}
+
+/**
+ * Records the offsets and values a value layer query visits.
+ */
+struct CellRecorder {
+	std::vector<std::pair<std::vector<int>, double> > cells;
+	void operator()(const int* offset, double value) {
+		cells.push_back(std::make_pair(std::vector<int>(offset, offset + 2), value));
+	}
+};
+
+/**
+ * Fills a value layer divided into a row of processes with values
+ * derived from each cell's coordinates, and checks Moore and von Neumann
+ * queries around every local cell against those values.
+ */
+void checkLayerQueries(bool periodic) {
+	boost::mpi::communicator world;
+	RepastProcess::init("", &world);
+	int width = SLAB_WIDTH * world.size();
+	GridDimensions dims(Point<double>(0, 0), Point<double>(width, HEIGHT));
+	std::vector<int> processDims;
+	processDims.push_back(world.size());
+	processDims.push_back(1);
+	ValueLayerND<double> layer(processDims, dims, 1, periodic);
+
+	GridDimensions local = layer.getLocalBoundaries();
+	int xMin = (int) local.origin(0);
+	int xMax = xMin + (int) local.extents(0);
+	bool err;
+	for (int x = xMin; x < xMax; x++) {
+		for (int y = 0; y < HEIGHT; y++) {
+			layer.setValueAt(cellValue(x, y), Point<int>(x, y), err);
+		}
+	}
+	layer.synchronize();
+
+	NDValueLayerQuery<double> query(&layer);
+	NeighborhoodStencil stencils[] = { NeighborhoodStencil::moore(2, 1, true), NeighborhoodStencil::vonNeumann(2, 1, false) };
+	for (int s = 0; s < 2; s++) {
+		for (int x = xMin; x < xMax; x++) {
+			for (int y = 0; y < HEIGHT; y++) {
+				CellRecorder recorder;
+				query.apply(Point<int>(x, y), stencils[s], recorder);
+
+				size_t expected = 0;
+				for (size_t n = 0; n < stencils[s].size(); n++) {
+					const int* offset = stencils[s].offset(n);
+					int ox = x + offset[0];
+					int oy = y + offset[1];
+					if (periodic || (ox >= 0 && ox < width && oy >= 0 && oy < HEIGHT)) expected++;
+				}
+				ASSERT_EQ(expected, recorder.cells.size());
+
+				for (size_t n = 0; n < recorder.cells.size(); n++) {
+					int ox = (x + recorder.cells[n].first[0] + width) % width;
+					int oy = (y + recorder.cells[n].first[1] + HEIGHT) % HEIGHT;
+					ASSERT_EQ(cellValue(ox, oy), recorder.cells[n].second);
+				}
+
+				std::vector<double> values;
+				query.query(Point<int>(x, y), stencils[s], values);
+				ASSERT_EQ(expected, values.size());
+			}
+		}
+	}
+}
+
+}
+
+TEST(SpaceQueryTests, StrictContinuousSpace)
+{
+	checkQueries<StrictBorders>(false);
+}
+
+TEST(SpaceQueryTests, WrappedContinuousSpace)
+{
+	checkQueries<WrapAroundBorders>(true);
+}
+
+TEST(SpaceQueryTests, StrictValueLayer)
+{
+	checkLayerQueries(false);
+}
+
+TEST(SpaceQueryTests, WrappedValueLayer)
+{
+	checkLayerQueries(true);
+}
@@ -0,0 +1,194 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*
+*   Redistribution and use in source and binary forms, with
+*   or without modification, are permitted provided that the following
+*   conditions are met:
+*
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * sync_profiler_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Tests the report of the SyncProfiler. The tests are only compiled if the
+ * library and the tests are built with -DREPAST_SYNC_PROFILING; otherwise
+ * the profiler records nothing and this file is empty.
+ */
+#ifdef REPAST_SYNC_PROFILING
+
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/Schedule.h"
+#include "repast_hpc/SyncProfiler.h"
+
+#include "model_agent.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+using namespace repast;
+
+namespace {
+
+// The measures in the report, each as min, max and mean
+enum Measure {
+	CALLS, TIME, MESSAGES, BYTES, PARTNERS
+};
+
+/**
+ * A context on each process from which the previous process copies one
+ * agent more than its rank, and whose states are synchronized by the
+ * events it schedules: once at tick 1 and twice at tick 2.
+ */
+class ProfiledModel {
+
+public:
+	SharedContext<ModelAgent> context;
+	AgentCreatorUpdater agents;
+
+	ProfiledModel(boost::mpi::communicator* comm) : context(comm), agents(&context) {
+		int rank = comm->rank(), worldSize = comm->size();
+		for (int i = 0; i < worldSize; i++)
+			context.addAgent(new ModelAgent(AgentId(i, rank, 0), i));
+		AgentRequest request(rank);
+		if (worldSize > 1) {
+			for (int i = 0; i <= rank; i++)
+				request.addRequest(AgentId(i, (rank + 1) % worldSize, 0));
+		}
+		RepastProcess::instance()->requestAgents<ModelAgent, RawModelAgentContent, AgentCreatorUpdater,
+				AgentCreatorUpdater, AgentCreatorUpdater>(context, request, agents, agents, agents);
+	}
+
+	void sync() {
+		RepastProcess::instance()->synchronizeAgentStates<RawModelAgentContent>(agents, agents);
+	}
+
+	void syncTwice() {
+		sync();
+		sync();
+	}
+};
+
+/**
+ * Reads the report into rows keyed by "tick,phase", each holding the
+ * process count followed by the min, max and mean of every measure.
+ */
+std::map<std::string, std::vector<double> > readReport(const std::string& file, std::string& header) {
+	std::map<std::string, std::vector<double> > rows;
+	std::ifstream in(file.c_str());
+	std::getline(in, header);
+	std::string line;
+	while (std::getline(in, line)) {
+		std::stringstream ss(line);
+		std::string tick, phase, value;
+		std::getline(ss, tick, ',');
+		std::getline(ss, phase, ',');
+		std::vector<double>& values = rows[tick + "," + phase];
+		while (std::getline(ss, value, ','))
+			values.push_back(boost::lexical_cast<double>(value));
+	}
+	return rows;
+}
+
+void expectMeasure(const std::vector<double>& row, Measure measure, double min, double max, double mean) {
+	ASSERT_EQ(16u, row.size());
+	EXPECT_DOUBLE_EQ(min, row[1 + 3 * measure]);
+	EXPECT_DOUBLE_EQ(max, row[2 + 3 * measure]);
+	EXPECT_DOUBLE_EQ(mean, row[3 + 3 * measure]);
+}
+
+}
+
+TEST(SyncProfilerTests, ReportsPhasesPerTickAcrossProcesses)
+{
+	const std::string file = "./sync_profile_test.csv";
+	RepastProcess::init("");
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	int worldSize = comm->size();
+	{
+		ProfiledModel model(comm);
+		ScheduleRunner& runner = RepastProcess::instance()->getScheduleRunner();
+		runner.scheduleEvent(1, Schedule::FunctorPtr(new MethodFunctor<ProfiledModel>(&model, &ProfiledModel::sync)));
+		runner.scheduleEvent(2, Schedule::FunctorPtr(new MethodFunctor<ProfiledModel>(&model,
+				&ProfiledModel::syncTwice)));
+		runner.scheduleStop(2);
+		runner.run();
+
+		SyncProfiler::instance()->setFile(file);
+		RepastProcess::instance()->done();
+	}
+
+	if (comm->rank() == 0) {
+		std::string header;
+		std::map<std::string, std::vector<double> > rows = readReport(file, header);
+		ASSERT_EQ("tick,phase,processes,calls_min,calls_max,calls_mean,time_min,time_max,time_mean,"
+				"messages_min,messages_max,messages_mean,bytes_min,bytes_max,bytes_mean,"
+				"partners_min,partners_max,partners_mean", header);
+
+		// The agents are requested before the schedule runs
+		ASSERT_EQ(1u, rows.count("0,agent_request"));
+		ASSERT_EQ(worldSize, rows["0,agent_request"][0]);
+		expectMeasure(rows["0,agent_request"], CALLS, 1, 1, 1);
+
+		// Each process sends its previous process one message holding one agent
+		// more than that process's rank; there is no one to send to on one process
+		double agentBytes = SyncProfiler::bytes(ContentTraits<RawModelAgentContent>::datatype());
+		bool sends = worldSize > 1;
+		for (int tick = 1; tick <= 2; tick++) {
+			std::string key = boost::lexical_cast<std::string>(tick) + ",agent_states";
+			ASSERT_EQ(1u, rows.count(key));
+			const std::vector<double>& row = rows[key];
+			ASSERT_EQ(worldSize, row[0]);
+			expectMeasure(row, CALLS, tick, tick, tick);
+			expectMeasure(row, MESSAGES, sends ? tick : 0, sends ? tick : 0, sends ? tick : 0);
+			expectMeasure(row, BYTES, sends ? tick * agentBytes : 0, sends ? tick * worldSize * agentBytes : 0,
+					sends ? tick * agentBytes * (worldSize + 1) / 2 : 0);
+			expectMeasure(row, PARTNERS, sends ? 2 * tick : 0, sends ? 2 * tick : 0, sends ? 2 * tick : 0);
+			EXPECT_LE(0, row[1 + 3 * TIME]);
+			EXPECT_LE(row[1 + 3 * TIME], row[3 + 3 * TIME]);
+			EXPECT_LE(row[3 + 3 * TIME], row[2 + 3 * TIME]);
+		}
+		ASSERT_EQ(0u, rows.count("1,agent_request"));
+	}
+	comm->barrier();
+	if (comm->rank() == 0) std::remove(file.c_str());
+	delete RepastProcess::instance();
+}
+
+#endif
@@ -0,0 +1,333 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*
+*   Redistribution and use in source and binary forms, with
+*   or without modification, are permitted provided that the following
+*   conditions are met:
+*
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * synchronize_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+#include <gtest/gtest.h>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/RepastProcess.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/GridComponents.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using namespace repast;
+
+namespace {
+
+const int AGENTS_PER_PROCESS = 24;
+const int TICKS = 10;
+const int FAR_AGENTS[] = { 4, 5, 14 };
+
+class SyncAgent: public Agent {
+
+private:
+	AgentId _id;
+	int _state;
+
+public:
+	SyncAgent(AgentId id, int state) : _id(id), _state(state) {}
+	virtual ~SyncAgent() {}
+
+	virtual AgentId& getId() { return _id; }
+	virtual const AgentId& getId() const { return _id; }
+
+	int state() const { return _state; }
+	void state(int val) { _state = val; }
+};
+
+struct SyncAgentContent {
+
+	friend class boost::serialization::access;
+
+	int id, startProc, type, currentProc, state;
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & startProc;
+		ar & type;
+		ar & currentProc;
+		ar & state;
+	}
+
+	AgentId getId() const {
+		return AgentId(id, startProc, type, currentProc);
+	}
+};
+
+typedef SharedDiscreteSpace<SyncAgent, StrictBorders, SimpleAdder<SyncAgent> > SyncSpace;
+
+/**
+ * Agents on a space that is divided into a row of processes, so that a process
+ * shares a buffer zone only with the processes next to it. Each process also
+ * requests some agents from a process farther along the row.
+ */
+class SyncModel {
+
+public:
+	SharedContext<SyncAgent> context;
+	SyncSpace* space;
+	int rank, worldSize;
+
+	SyncModel(boost::mpi::communicator* comm) : context(comm), rank(comm->rank()), worldSize(comm->size()) {
+		GridDimensions dims(Point<double>(0, 0), Point<double>(10 * worldSize, 10));
+		std::vector<int> processDims;
+		processDims.push_back(worldSize);
+		processDims.push_back(1);
+		space = new SyncSpace("sync_space", dims, processDims, 1, comm);
+		context.addProjection(space);
+
+		GridDimensions bounds = space->dimensions();
+		for (int i = 0; i < AGENTS_PER_PROCESS; i++) {
+			SyncAgent* agent = new SyncAgent(AgentId(i, rank, i % 2), 0);
+			context.addAgent(agent);
+			std::vector<int> pt;
+			pt.push_back(bounds.origin(0) + i % (int) bounds.extents(0));
+			pt.push_back(bounds.origin(1) + (i * 3) % (int) bounds.extents(1));
+			space->moveTo(agent->getId(), pt);
+		}
+	}
+
+	void requestFarAgents() {
+		AgentRequest request(rank);
+		int other = (rank + worldSize / 2) % worldSize;
+		if (other != rank) {
+			for (int i = 0; i < 3; i++)
+				request.addRequest(AgentId(FAR_AGENTS[i], other, FAR_AGENTS[i] % 2, other));
+		}
+		RepastProcess::instance()->requestAgents<SyncAgent, SyncAgentContent, SyncModel, SyncModel, SyncModel>(
+				context, request, *this, *this, *this, "far");
+	}
+
+	// Changes the state of every local agent and moves it; in delta mode only
+	// agents with an even id are marked as changed
+	void step(int tick) {
+		std::vector<SyncAgent*> locals;
+		for (SharedContext<SyncAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd();
+				++iter)
+			locals.push_back(iter->get());
+
+		GridDimensions bounds = space->bounds();
+		for (size_t i = 0; i < locals.size(); i++) {
+			SyncAgent* agent = locals[i];
+			agent->state(agent->state() + 1);
+			if (agent->getId().id() % 2 == 0)
+				RepastProcess::instance()->markAgentDirty(agent->getId());
+			std::vector<int> pt;
+			space->getLocation(agent->getId(), pt);
+			pt[0] += (agent->getId().id() + tick) % 3 - 1;
+			pt[1] += (agent->getId().id() * 5 + tick) % 3 - 1;
+			for (int d = 0; d < 2; d++) {
+				int lower = (int) bounds.origin(d);
+				int upper = lower + (int) bounds.extents(d) - 1;
+				pt[d] = std::min(std::max(pt[d], lower), upper);
+			}
+			space->moveTo(agent->getId(), pt);
+		}
+		space->balance();
+	}
+
+	// The id, owner, state and location of every agent on this process
+	std::set<std::vector<int> > snapshot() {
+		std::set<std::vector<int> > out;
+		for (SharedContext<SyncAgent>::const_iterator iter = context.begin(); iter != context.end(); ++iter) {
+			SyncAgent* agent = iter->get();
+			std::vector<int> entry;
+			entry.push_back(agent->getId().id());
+			entry.push_back(agent->getId().startingRank());
+			entry.push_back(agent->getId().agentType());
+			entry.push_back(agent->getId().currentRank());
+			entry.push_back(agent->state());
+			std::vector<int> pt;
+			space->getLocation(agent->getId(), pt);
+			entry.insert(entry.end(), pt.begin(), pt.end());
+			out.insert(entry);
+		}
+		return out;
+	}
+
+	void provideContent(const AgentRequest& request, std::vector<SyncAgentContent>& out) {
+		const std::vector<AgentId>& ids = request.requestedAgents();
+		for (size_t i = 0; i < ids.size(); i++) {
+			SyncAgent* agent = context.getAgent(ids[i]);
+			SyncAgentContent content;
+			content.id = agent->getId().id();
+			content.startProc = agent->getId().startingRank();
+			content.type = agent->getId().agentType();
+			content.currentProc = agent->getId().currentRank();
+			content.state = agent->state();
+			out.push_back(content);
+		}
+	}
+
+	SyncAgent* createAgent(const SyncAgentContent& content) {
+		return new SyncAgent(content.getId(), content.state);
+	}
+
+	void updateAgent(const SyncAgentContent& content) {
+		SyncAgent* agent = context.getAgent(content.getId());
+		agent->state(content.state);
+	}
+};
+
+std::set<std::vector<int> > runModel(bool fused, RepastProcess::EXCHANGE_PATTERN pattern, bool requestFarAgents,
+		bool delta) {
+	RepastProcess::init("");
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	std::set<std::vector<int> > result;
+	{
+		SyncModel model(comm);
+		RepastProcess::instance()->setDeltaAgentStateSync(delta);
+		if (requestFarAgents) model.requestFarAgents();
+		for (int tick = 0; tick < TICKS; tick++) {
+			model.step(tick);
+			if (fused) {
+				RepastProcess::instance()->synchronize<SyncAgent, SyncAgentContent, SyncModel, SyncModel, SyncModel>(
+						model.context, model, model, model, pattern);
+			} else {
+				RepastProcess::instance()->synchronizeAgentStatus<SyncAgent, SyncAgentContent, SyncModel, SyncModel,
+						SyncModel>(model.context, model, model, model, pattern);
+				RepastProcess::instance()->synchronizeProjectionInfo<SyncAgent, SyncAgentContent, SyncModel,
+						SyncModel, SyncModel>(model.context, model, model, model, pattern);
+				RepastProcess::instance()->synchronizeAgentStates<SyncAgentContent, SyncModel, SyncModel>(model,
+						model);
+			}
+		}
+		result = model.snapshot();
+	}
+	delete RepastProcess::instance();
+	return result;
+}
+
+void checkFusedMatchesSeparate(RepastProcess::EXCHANGE_PATTERN pattern, bool requestFarAgents, bool delta = false) {
+	std::set<std::vector<int> > separate = runModel(false, pattern, requestFarAgents, delta);
+	std::set<std::vector<int> > fused = runModel(true, pattern, requestFarAgents, delta);
+	ASSERT_EQ(separate, fused);
+
+	boost::mpi::communicator world;
+	int nonLocal = 0, far = 0;
+	int other = (world.rank() + world.size() / 2) % world.size();
+	for (std::set<std::vector<int> >::const_iterator iter = fused.begin(); iter != fused.end(); ++iter) {
+		if ((*iter)[3] != world.rank()) nonLocal++;
+		if ((*iter)[1] == other && std::count(FAR_AGENTS, FAR_AGENTS + 3, (*iter)[0]) > 0) far++;
+	}
+	if (world.size() > 1) ASSERT_GT(nonLocal, 0);
+	if (requestFarAgents && other != world.rank()) ASSERT_EQ(3, far);
+}
+
+// The local and non-local iterators must agree with the agents' current ranks
+void checkLocalAndNonLocal(SharedContext<SyncAgent>& context, int rank) {
+	std::set<AgentId> local, nonLocal;
+	for (SharedContext<SyncAgent>::const_iterator iter = context.begin(); iter != context.end(); ++iter) {
+		if ((*iter)->getId().currentRank() == rank) local.insert((*iter)->getId());
+		else nonLocal.insert((*iter)->getId());
+	}
+
+	std::set<AgentId> found;
+	for (SharedContext<SyncAgent>::const_local_iterator iter = context.localBegin(); iter != context.localEnd(); ++iter)
+		ASSERT_TRUE(found.insert((*iter)->getId()).second);
+	ASSERT_EQ(local, found);
+
+	found.clear();
+	for (SharedContext<SyncAgent>::const_state_aware_iterator iter = context.begin(SharedContext<SyncAgent>::NON_LOCAL);
+			iter != context.end(SharedContext<SyncAgent>::NON_LOCAL); ++iter)
+		ASSERT_TRUE(found.insert((*iter)->getId()).second);
+	ASSERT_EQ(nonLocal, found);
+
+	int count = 0;
+	for (SharedContext<SyncAgent>::const_state_aware_bytype_iterator iter = context.byTypeBegin(
+			SharedContext<SyncAgent>::LOCAL, 1); iter != context.byTypeEnd(SharedContext<SyncAgent>::LOCAL, 1); ++iter) {
+		ASSERT_EQ(1, (*iter)->getId().agentType());
+		count++;
+	}
+	int expected = 0;
+	for (std::set<AgentId>::const_iterator iter = local.begin(); iter != local.end(); ++iter)
+		if (iter->agentType() == 1) expected++;
+	ASSERT_EQ(expected, count);
+}
+
+}
+
+TEST(SynchronizeTests, LocalAgentListsFollowRanks)
+{
+	RepastProcess::init("");
+	boost::mpi::communicator* comm = RepastProcess::instance()->getCommunicator();
+	{
+		SyncModel model(comm);
+		model.requestFarAgents();
+		checkLocalAndNonLocal(model.context, comm->rank());
+		for (int tick = 0; tick < TICKS; tick++) {
+			model.step(tick);
+			RepastProcess::instance()->synchronize<SyncAgent, SyncAgentContent, SyncModel, SyncModel, SyncModel>(
+					model.context, model, model, model, RepastProcess::POLL);
+			checkLocalAndNonLocal(model.context, comm->rank());
+		}
+	}
+	delete RepastProcess::instance();
+}
+
+TEST(SynchronizeTests, FusedMatchesSeparatePoll)
+{
+	checkFusedMatchesSeparate(RepastProcess::POLL, true);
+}
+
+TEST(SynchronizeTests, FusedMatchesSeparateUseCurrent)
+{
+	checkFusedMatchesSeparate(RepastProcess::USE_CURRENT, false);
+}
+
+TEST(SynchronizeTests, FusedMatchesSeparateUseLast)
+{
+	checkFusedMatchesSeparate(RepastProcess::USE_LAST_OR_USE_CURRENT, false);
+}
+
+TEST(SynchronizeTests, FusedMatchesSeparateUseCurrentFar)
+{
+	checkFusedMatchesSeparate(RepastProcess::USE_CURRENT, true);
+}
+
+TEST(SynchronizeTests, FusedMatchesSeparateDelta)
+{
+	checkFusedMatchesSeparate(RepastProcess::POLL, true, true);
+	checkFusedMatchesSeparate(RepastProcess::USE_LAST_OR_USE_CURRENT, true, true);
+}
@@ -0,0 +1,152 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * agent_request_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times RepastProcess::requestAgents under each AGENT_REQUEST_EXCHANGE
+ * method. Every process requests a few agents from its two ring neighbors
+ * and process 0 additionally makes one large request of process 1, which is
+ * the case where the padded all-to-all exchange does badly. Along with the
+ * time, the bench reports the size of the exchange buffers each method
+ * allocates on a process.
+ */
+
+#include <vector>
+#include <string>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/AgentId.h"
+#include "repast_hpc/AgentRequest.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/RepastProcess.h"
+#include "perf.h"
+#include "bench_agent.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int AGENTS_PER_PROC = 5000;
+const int RING_REQUESTS = 10;
+const int HOT_REQUESTS = 4000;
+
+void addRequests(AgentRequest& req, int target, int first, int count) {
+	for (int i = first; i < first + count; i++)
+		req.addRequest(AgentId(i, target, 0, target));
+}
+
+AgentRequest makeRequest(int rank, int worldSize) {
+	int left = (rank + worldSize - 1) % worldSize;
+	int right = (rank + 1) % worldSize;
+	AgentRequest req(rank);
+	addRequests(req, right, 0, RING_REQUESTS);
+	if (left != right) addRequests(req, left, 0, RING_REQUESTS);
+	if (rank == 0) addRequests(req, 1, RING_REQUESTS, HOT_REQUESTS);
+	return req;
+}
+
+/*
+ * Bytes of exchange buffers allocated on this process by each method.
+ */
+double exchangeBytes(RepastProcess::AGENT_REQUEST_EXCHANGE exchange, int worldSize, int partners,
+		int sentIds, int recvdIds, int maxGlobalPerTarget) {
+	double intSize = sizeof(int);
+	// Packed buffers hold a two int header per partner and three ints per id
+	double packed = (2.0 * partners * 2 + 3.0 * (sentIds + recvdIds)) * intSize;
+	switch (exchange) {
+	case RepastProcess::ALL_TO_ALL:
+		return 2.0 * (maxGlobalPerTarget + 2) * 3 * worldSize * intSize;
+	case RepastProcess::SPARSE_COUNTS:
+		return 2.0 * worldSize * intSize + packed;
+	default:
+		return packed;
+	}
+}
+
+}
+
+namespace perf {
+
+void agentRequestBench(boost::mpi::communicator& comm, int reps) {
+	int rank = comm.rank();
+	int worldSize = comm.size();
+	if (worldSize < 2) return;
+
+	RepastProcess::AGENT_REQUEST_EXCHANGE exchanges[] = { RepastProcess::ALL_TO_ALL,
+			RepastProcess::SPARSE_COUNTS, RepastProcess::SPARSE_NBX };
+	const char* names[] = { "all_to_all", "sparse_counts", "sparse_nbx" };
+
+	int partners = (worldSize > 2 ? 2 : 1);
+
+	// The largest request made of any one process determines the all-to-all block size
+	int maxPerTarget = (rank == 0 ? RING_REQUESTS + HOT_REQUESTS : RING_REQUESTS);
+	int maxGlobalPerTarget = 0;
+	MPI_Allreduce(&maxPerTarget, &maxGlobalPerTarget, 1, MPI_INT, MPI_MAX, comm);
+	int sentIds = makeRequest(rank, worldSize).requestCount();
+	int recvdIds = partners * RING_REQUESTS + (rank == 1 ? HOT_REQUESTS : 0);
+
+	for (int e = 0; e < 3; e++) {
+		double time = 0;
+		for (int r = 0; r < reps; r++) {
+			// Reinitialize so that every repetition starts with no imported agents
+			RepastProcess* process = RepastProcess::init("", &comm);
+			process->setAgentRequestExchange(exchanges[e]);
+
+			SharedContext<BenchAgent> context(&comm);
+			for (int i = 0; i < AGENTS_PER_PROC; i++)
+				context.addAgent(new BenchAgent(AgentId(i, rank, 0), i));
+
+			AgentRequest req = makeRequest(rank, worldSize);
+			BenchAgentPackager<BenchAgentPackage> packager;
+			packager.context = &context;
+
+			comm.barrier();
+			Stopwatch watch;
+			process->requestAgents<BenchAgent, BenchAgentPackage, BenchAgentPackager<BenchAgentPackage>,
+					BenchAgentPackager<BenchAgentPackage>, BenchAgentPackager<BenchAgentPackage> >(context, req, packager,
+					packager, packager);
+			time += watch.elapsed();
+		}
+		report(comm, "agent_request", names[e], "seconds/request", time / reps);
+		report(comm, "agent_request", names[e], "exchange bytes",
+				exchangeBytes(exchanges[e], worldSize, partners, sentIds, recvdIds, maxGlobalPerTarget));
+	}
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * bench_agent.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * A minimal agent, its Content, and a Provider / Updater / AgentCreator
+ * for the benchmarks that move agents between processes.
+ */
+
+#ifndef BENCH_AGENT_H_
+#define BENCH_AGENT_H_
+
+#include <vector>
+#include <boost/serialization/access.hpp>
+
+#include "repast_hpc/AgentId.h"
+#include "repast_hpc/AgentRequest.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/RawContent.h"
+
+namespace perf {
+
+class BenchAgent: public repast::Agent {
+private:
+	repast::AgentId _id;
+
+public:
+	int state;
+
+	BenchAgent(const repast::AgentId& id, int state) : _id(id), state(state) {}
+
+	repast::AgentId& getId() {
+		return _id;
+	}
+
+	const repast::AgentId& getId() const {
+		return _id;
+	}
+};
+
+struct BenchAgentPackage {
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int version) {
+		ar & id;
+		ar & startingRank;
+		ar & type;
+		ar & currentRank;
+		ar & state;
+	}
+
+	int id, startingRank, type, currentRank, state;
+
+	repast::AgentId getId() const {
+		return repast::AgentId(id, startingRank, type, currentRank);
+	}
+};
+
+/**
+ * The same Content as BenchAgentPackage, but sent raw (see REPAST_RAW_CONTENT below).
+ */
+struct RawBenchAgentPackage: public BenchAgentPackage {
+};
+
+template<typename Package>
+struct BenchAgentPackager {
+	repast::SharedContext<BenchAgent>* context;
+
+	void provideContent(const repast::AgentRequest& req, std::vector<Package>& out) {
+		const std::vector<repast::AgentId>& ids = req.requestedAgents();
+		for (size_t i = 0; i < ids.size(); i++) {
+			BenchAgent* agent = context->getAgent(ids[i]);
+			Package package;
+			package.id = ids[i].id();
+			package.startingRank = ids[i].startingRank();
+			package.type = ids[i].agentType();
+			package.currentRank = agent->getId().currentRank();
+			package.state = agent->state;
+			out.push_back(package);
+		}
+	}
+
+	BenchAgent* createAgent(const Package& package) {
+		return new BenchAgent(package.getId(), package.state);
+	}
+
+	void updateAgent(const Package& package) {
+		context->getAgent(package.getId())->state = package.state;
+	}
+};
+
+}
+
+REPAST_RAW_CONTENT(perf::RawBenchAgentPackage)
+
+#endif /* BENCH_AGENT_H_ */
@@ -0,0 +1,117 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * content_transfer_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times RepastProcess::synchronizeAgentStates with the same Content sent
+ * through boost::serialization archives and sent raw (see ContentTraits).
+ * Every process imports all the agents of its left neighbor, so each
+ * synchronization moves that many agents' Content in each direction.
+ */
+
+#include <vector>
+#include <string>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/AgentId.h"
+#include "repast_hpc/AgentRequest.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/RepastProcess.h"
+#include "perf.h"
+#include "bench_agent.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int AGENT_COUNTS[] = { 1000, 10000, 100000 };
+
+template<typename Package>
+double timeSynchronizeAgentStates(boost::mpi::communicator& comm, SharedContext<BenchAgent>& context, int reps) {
+	BenchAgentPackager<Package> packager;
+	packager.context = &context;
+	RepastProcess* process = RepastProcess::instance();
+
+	// One untimed synchronization to warm up
+	process->synchronizeAgentStates<Package, BenchAgentPackager<Package>, BenchAgentPackager<Package> >(packager,
+			packager);
+	comm.barrier();
+	Stopwatch watch;
+	for (int r = 0; r < reps; r++)
+		process->synchronizeAgentStates<Package, BenchAgentPackager<Package>, BenchAgentPackager<Package> >(packager,
+				packager);
+	return watch.elapsed() / reps;
+}
+
+}
+
+namespace perf {
+
+void contentTransferBench(boost::mpi::communicator& comm, int reps) {
+	int rank = comm.rank();
+	int worldSize = comm.size();
+	if (worldSize < 2) return;
+	int left = (rank + worldSize - 1) % worldSize;
+
+	for (size_t c = 0; c < sizeof(AGENT_COUNTS) / sizeof(AGENT_COUNTS[0]); c++) {
+		int count = AGENT_COUNTS[c];
+		RepastProcess* process = RepastProcess::init("", &comm);
+		SharedContext<BenchAgent> context(&comm);
+		for (int i = 0; i < count; i++)
+			context.addAgent(new BenchAgent(AgentId(i, rank, 0), i));
+
+		AgentRequest req(rank);
+		for (int i = 0; i < count; i++)
+			req.addRequest(AgentId(i, left, 0, left));
+		BenchAgentPackager<BenchAgentPackage> packager;
+		packager.context = &context;
+		process->requestAgents<BenchAgent, BenchAgentPackage, BenchAgentPackager<BenchAgentPackage>,
+				BenchAgentPackager<BenchAgentPackage>, BenchAgentPackager<BenchAgentPackage> >(context, req, packager,
+				packager, packager);
+
+		std::string agents = boost::lexical_cast<std::string>(count) + " agents";
+		report(comm, "content_transfer", "archive", agents + " s/sync",
+				timeSynchronizeAgentStates<BenchAgentPackage>(comm, context, reps));
+		report(comm, "content_transfer", "raw", agents + " s/sync",
+				timeSynchronizeAgentStates<RawBenchAgentPackage>(comm, context, reps));
+	}
+}
+
+}
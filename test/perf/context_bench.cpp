@@ -0,0 +1,132 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * context_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times the Context with its HASH_MAP and SLABS agent storage: adding
+ * agents, sweeping over them, looking each of them up by id, removing and
+ * re-adding half of them (births and deaths), and destroying the Context.
+ * The agents have a few types, added interleaved. Each process runs its
+ * own Context.
+ */
+
+#include <string>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/SharedContext.h"
+#include "bench_agent.h"
+#include "perf.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int AGENT_COUNTS[] = { 10000, 100000, 1000000 };
+const int TYPE_COUNT = 4;
+const int SWEEPS = 10;
+
+struct ContextTimes {
+	double add, sweep, lookup, churn, destroy;
+
+	ContextTimes() : add(0), sweep(0), lookup(0), churn(0), destroy(0) {}
+};
+
+void timeContext(boost::mpi::communicator& comm, Context<BenchAgent>::STORAGE storage, int count, int reps,
+		ContextTimes& times) {
+	int rank = comm.rank();
+	long sum = 0;
+	for (int r = 0; r < reps; r++) {
+		SharedContext<BenchAgent>* context = new SharedContext<BenchAgent> (&comm, storage);
+
+		Stopwatch watch;
+		for (int i = 0; i < count; i++)
+			context->addAgent(new BenchAgent(AgentId(i, rank, i % TYPE_COUNT, rank), i));
+		times.add += watch.elapsed();
+
+		watch.reset();
+		for (int s = 0; s < SWEEPS; s++) {
+			for (Context<BenchAgent>::const_iterator iter = context->begin(); iter != context->end(); ++iter)
+				sum += (*iter)->state;
+		}
+		times.sweep += watch.elapsed();
+
+		watch.reset();
+		for (int i = 0; i < count; i++)
+			sum += context->getAgent(AgentId(i, rank, i % TYPE_COUNT, rank))->state;
+		times.lookup += watch.elapsed();
+
+		watch.reset();
+		for (int i = 0; i < count; i += 2)
+			context->removeAgent(AgentId(i, rank, i % TYPE_COUNT, rank));
+		for (int i = 0; i < count; i += 2)
+			context->addAgent(new BenchAgent(AgentId(count + i, rank, i % TYPE_COUNT, rank), i));
+		times.churn += watch.elapsed();
+
+		watch.reset();
+		delete context;
+		times.destroy += watch.elapsed();
+	}
+	// keeps the sweeps and lookups from being optimized away
+	if (sum == -1) std::cout << sum << std::endl;
+}
+
+}
+
+namespace perf {
+
+void contextBench(boost::mpi::communicator& comm, int reps) {
+	Context<BenchAgent>::STORAGE storages[] = { Context<BenchAgent>::HASH_MAP, Context<BenchAgent>::SLABS };
+	for (size_t c = 0; c < sizeof(AGENT_COUNTS) / sizeof(AGENT_COUNTS[0]); c++) {
+		int count = AGENT_COUNTS[c];
+		std::string suffix = "_" + boost::lexical_cast<std::string>(count);
+		for (int s = 0; s < 2; s++) {
+			ContextTimes times;
+			timeContext(comm, storages[s], count, reps, times);
+			std::string variant = (storages[s] == Context<BenchAgent>::SLABS ? "slabs" : "hash_map");
+			report(comm, "context", variant, "add_s" + suffix, times.add / reps);
+			report(comm, "context", variant, "sweep_s" + suffix, times.sweep / reps);
+			report(comm, "context", variant, "lookup_s" + suffix, times.lookup / reps);
+			report(comm, "context", variant, "churn_s" + suffix, times.churn / reps);
+			report(comm, "context", variant, "destroy_s" + suffix, times.destroy / reps);
+		}
+	}
+}
+
+}
@@ -0,0 +1,184 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * grid_query_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times a SharedDiscreteSpace with its default MultipleOccupancy cell
+ * accessor and with DenseOccupancy: placing agents at random cells, running
+ * a Moore and a von Neumann neighborhood query around every agent, and moving
+ * every agent one cell. Each process has a square local grid with one agent
+ * for every few cells.
+ */
+
+#include <vector>
+#include <string>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/Moore2DGridQuery.h"
+#include "repast_hpc/VN2DGridQuery.h"
+#include "repast_hpc/NDGridQuery.h"
+#include "repast_hpc/RepastProcess.h"
+#include "bench_agent.h"
+#include "perf.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int SIDES[] = { 500, 1000, 4000 };
+const int CELLS_PER_AGENT = 8;
+
+struct GridTimes {
+	double place, moore, vn, ndMoore, ndVn, move;
+
+	GridTimes() : place(0), moore(0), vn(0), ndMoore(0), ndVn(0), move(0) {}
+};
+
+template<typename CellAccessor>
+void timeGrid(boost::mpi::communicator& comm, int side, int reps, GridTimes& times) {
+	typedef SharedDiscreteSpace<BenchAgent, WrapAroundBorders, SimpleAdder<BenchAgent>, CellAccessor> BenchSpace;
+
+	RepastProcess::init("", &comm);
+	int count = side * side / CELLS_PER_AGENT;
+	size_t sum = 0;
+	for (int r = 0; r < reps; r++) {
+		SharedContext<BenchAgent> context(&comm);
+		GridDimensions dims(Point<double>(0, 0), Point<double>(side * comm.size(), side));
+		std::vector<int> processDims;
+		processDims.push_back(comm.size());
+		processDims.push_back(1);
+		BenchSpace* space = new BenchSpace("bench_space", dims, processDims, 1, &comm);
+		context.addProjection(space);
+
+		int originX = (int) space->dimensions().origin(0);
+		std::vector<Point<int> > locations;
+		unsigned int seed = 12345 + comm.rank();
+		for (int i = 0; i < count; i++) {
+			context.addAgent(new BenchAgent(AgentId(i, comm.rank(), 0), i));
+			seed = seed * 1103515245 + 12345;
+			int x = originX + (seed >> 8) % side;
+			seed = seed * 1103515245 + 12345;
+			int y = (seed >> 8) % side;
+			locations.push_back(Point<int>(x, y));
+		}
+
+		Stopwatch watch;
+		for (int i = 0; i < count; i++)
+			space->moveTo(AgentId(i, comm.rank(), 0), locations[i]);
+		times.place += watch.elapsed();
+
+		std::vector<BenchAgent*> out;
+		Moore2DGridQuery<BenchAgent> moore(space);
+		watch.reset();
+		for (int i = 0; i < count; i++) {
+			out.clear();
+			moore.query(locations[i], 1, true, out);
+			sum += out.size();
+		}
+		times.moore += watch.elapsed();
+
+		VN2DGridQuery<BenchAgent> vn(space);
+		watch.reset();
+		for (int i = 0; i < count; i++) {
+			out.clear();
+			vn.query(locations[i], 1, true, out);
+			sum += out.size();
+		}
+		times.vn += watch.elapsed();
+
+		NDGridQuery<BenchAgent> nd(space);
+		NeighborhoodStencil mooreStencil = NeighborhoodStencil::moore(2, 1, true);
+		watch.reset();
+		for (int i = 0; i < count; i++) {
+			out.clear();
+			nd.query(locations[i], mooreStencil, out);
+			sum += out.size();
+		}
+		times.ndMoore += watch.elapsed();
+
+		NeighborhoodStencil vnStencil = NeighborhoodStencil::vonNeumann(2, 1, true);
+		watch.reset();
+		for (int i = 0; i < count; i++) {
+			out.clear();
+			nd.query(locations[i], vnStencil, out);
+			sum += out.size();
+		}
+		times.ndVn += watch.elapsed();
+
+		watch.reset();
+		for (int i = 0; i < count; i++) {
+			std::vector<int> pt(locations[i].coords());
+			pt[1] = (pt[1] + 1) % side;
+			space->moveTo(AgentId(i, comm.rank(), 0), pt);
+		}
+		times.move += watch.elapsed();
+	}
+	// keeps the queries from being optimized away
+	if (sum == 0) std::cout << sum << std::endl;
+}
+
+template<typename CellAccessor>
+void reportGrid(boost::mpi::communicator& comm, const std::string& variant, int reps) {
+	for (size_t s = 0; s < sizeof(SIDES) / sizeof(SIDES[0]); s++) {
+		int side = SIDES[s];
+		std::string suffix = "_" + boost::lexical_cast<std::string>(side);
+		GridTimes times;
+		timeGrid<CellAccessor>(comm, side, reps, times);
+		report(comm, "grid_query", variant, "place_s" + suffix, times.place / reps);
+		report(comm, "grid_query", variant, "moore_s" + suffix, times.moore / reps);
+		report(comm, "grid_query", variant, "vn_s" + suffix, times.vn / reps);
+		report(comm, "grid_query", variant, "nd_moore_s" + suffix, times.ndMoore / reps);
+		report(comm, "grid_query", variant, "nd_vn_s" + suffix, times.ndVn / reps);
+		report(comm, "grid_query", variant, "move_s" + suffix, times.move / reps);
+	}
+}
+
+}
+
+namespace perf {
+
+void gridQueryBench(boost::mpi::communicator& comm, int reps) {
+	reportGrid<MultipleOccupancy<BenchAgent, int> >(comm, "multiple", reps);
+	reportGrid<DenseOccupancy<BenchAgent, int> >(comm, "dense", reps);
+}
+
+}
@@ -0,0 +1,153 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * knn_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times SharedContinuousSpace::getNearestAgents against a brute-force
+ * scan that computes the distance to every agent and partially sorts
+ * them, for several values of k. Each process has a square part of a
+ * periodic space with agents scattered uniformly over it.
+ */
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedContinuousSpace.h"
+#include "repast_hpc/RepastProcess.h"
+#include "bench_agent.h"
+#include "perf.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int AGENT_COUNTS[] = { 10000, 100000 };
+const int KS[] = { 1, 8, 32 };
+const int QUERIES = 1000;
+const double SIDE = 100;
+
+typedef SharedContinuousSpace<BenchAgent, WrapAroundBorders, SimpleAdder<BenchAgent> > BenchSpace;
+
+struct KnnTimes {
+	double indexed, scan;
+
+	KnnTimes() : indexed(0), scan(0) {}
+};
+
+double nextCoordinate(unsigned int& seed, double origin) {
+	seed = seed * 1103515245 + 12345;
+	return origin + (seed >> 8) % 100000 / 100000.0 * SIDE;
+}
+
+void timeKnn(boost::mpi::communicator& comm, int count, int k, int reps, KnnTimes& times) {
+	RepastProcess::init("", &comm);
+	size_t sum = 0;
+	for (int r = 0; r < reps; r++) {
+		SharedContext<BenchAgent> context(&comm);
+		GridDimensions dims(Point<double>(0, 0), Point<double>(SIDE * comm.size(), SIDE));
+		std::vector<int> processDims;
+		processDims.push_back(comm.size());
+		processDims.push_back(1);
+		BenchSpace* space = new BenchSpace("bench_space", dims, processDims, 2, &comm);
+		context.addProjection(space);
+		space->setBinWidth(2);
+
+		double originX = space->dimensions().origin(0);
+		unsigned int seed = 12345 + comm.rank();
+		std::vector<std::pair<BenchAgent*, Point<double> > > located;
+		for (int i = 0; i < count; i++) {
+			BenchAgent* agent = new BenchAgent(AgentId(i, comm.rank(), 0), i);
+			context.addAgent(agent);
+			double x = nextCoordinate(seed, originX);
+			double y = nextCoordinate(seed, 0);
+			space->moveTo(agent->getId(), Point<double>(x, y));
+			located.push_back(std::make_pair(agent, Point<double>(x, y)));
+		}
+
+		std::vector<Point<double> > centers;
+		for (int q = 0; q < QUERIES; q++) {
+			double x = nextCoordinate(seed, originX);
+			centers.push_back(Point<double>(x, nextCoordinate(seed, 0)));
+		}
+
+		std::vector<BenchAgent*> out;
+		Stopwatch watch;
+		for (int q = 0; q < QUERIES; q++) {
+			out.clear();
+			space->getNearestAgents(centers[q], k, out);
+			sum += out.size();
+		}
+		times.indexed += watch.elapsed();
+
+		std::vector<std::pair<double, BenchAgent*> > distances(located.size());
+		watch.reset();
+		for (int q = 0; q < QUERIES; q++) {
+			for (size_t i = 0; i < located.size(); i++)
+				distances[i] = std::make_pair(space->getDistanceSq(centers[q], located[i].second), located[i].first);
+			std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+			sum += distances[k - 1].second->state;
+		}
+		times.scan += watch.elapsed();
+	}
+	// keeps the queries from being optimized away
+	if (sum == 0) std::cout << sum << std::endl;
+}
+
+}
+
+namespace perf {
+
+void knnBench(boost::mpi::communicator& comm, int reps) {
+	for (size_t c = 0; c < sizeof(AGENT_COUNTS) / sizeof(AGENT_COUNTS[0]); c++) {
+		for (size_t k = 0; k < sizeof(KS) / sizeof(KS[0]); k++) {
+			std::string suffix = "_" + boost::lexical_cast<std::string>(AGENT_COUNTS[c]) + "_k" +
+					boost::lexical_cast<std::string>(KS[k]);
+			KnnTimes times;
+			timeKnn(comm, AGENT_COUNTS[c], KS[k], reps, times);
+			report(comm, "knn", "binned", "query_s" + suffix, times.indexed / reps);
+			report(comm, "knn", "scan", "query_s" + suffix, times.scan / reps);
+		}
+	}
+}
+
+}
@@ -0,0 +1,110 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * main.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Runs the performance benchmarks. Usage:
+ *
+ *   mpirun -n <procs> perf_test [benchmark|all] [repetitions]
+ *
+ * Results are printed one per line as: benchmark, variant, processes,
+ * metric, value. Running with increasing process counts shows how each
+ * variant scales with the world size.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <boost/mpi.hpp>
+
+#include "repast_hpc/RepastProcess.h"
+#include "perf.h"
+
+static long allocations = 0;
+
+// Counts every allocation for perf::allocationCount; array new and the
+// other forms of operator new call this one
+void* operator new(std::size_t size) {
+	allocations++;
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == 0) throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+long perf::allocationCount() {
+	return allocations;
+}
+
+typedef void (*Benchmark)(boost::mpi::communicator&, int);
+
+struct NamedBenchmark {
+	const char* name;
+	Benchmark run;
+};
+
+static NamedBenchmark benchmarks[] = {
+		{ "agent_request", perf::agentRequestBench },
+		{ "content_transfer", perf::contentTransferBench },
+		{ "context", perf::contextBench },
+		{ "grid_query", perf::gridQueryBench },
+		{ "knn", perf::knnBench },
+		{ "move", perf::moveBench },
+		{ "projection_sync", perf::projectionSyncBench },
+		{ "projection_sync_ghosts", perf::projectionSyncGhostsBench },
+		{ "schedule", perf::scheduleBench },
+		{ "schedule_runner", perf::scheduleRunnerBench }
+};
+
+int main(int argc, char **argv) {
+	boost::mpi::environment env(argc, argv);
+	boost::mpi::communicator world;
+
+	std::string which = (argc > 1 ? argv[1] : "all");
+	int reps = (argc > 2 ? atoi(argv[2]) : 10);
+
+	repast::RepastProcess::init("", &world);
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+		if (which == "all" || which == benchmarks[i].name) benchmarks[i].run(world, reps);
+	}
+	repast::RepastProcess::instance()->done();
+	return 0;
+}
@@ -0,0 +1,13 @@
+SOURCES = main.cpp \
+          agent_request_bench.cpp \
+          content_transfer_bench.cpp \
+          context_bench.cpp \
+          grid_query_bench.cpp \
+          knn_bench.cpp \
+          move_bench.cpp \
+          projection_sync_bench.cpp \
+          schedule_bench.cpp
+
+local_dir := perf
+local_src :=  $(addprefix $(local_dir)/, $(SOURCES))
+perf_test_src += $(local_src)
@@ -0,0 +1,214 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * move_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times agent moves through the runtime dimension std::vector / Point<T>
+ * overloads against the same moves through the compile time dimension
+ * Point<T, N> overloads, which do not allocate. Each process has a square
+ * part of a periodic grid and space, and every agent takes a random step
+ * each iteration, in the grid by displacement and in the space by
+ * translating its location and moving to the result. Besides the times,
+ * it reports the heap allocations per move counted by the perf driver's
+ * operator new.
+ */
+
+#include <vector>
+#include <string>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/SharedContinuousSpace.h"
+#include "repast_hpc/RepastProcess.h"
+#include "bench_agent.h"
+#include "perf.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int AGENT_COUNTS[] = { 10000, 100000 };
+const int STEPS = 20;
+const int SIDE = 500;
+
+typedef SharedDiscreteSpace<BenchAgent, WrapAroundBorders, SimpleAdder<BenchAgent> > BenchGrid;
+typedef SharedContinuousSpace<BenchAgent, WrapAroundBorders, SimpleAdder<BenchAgent> > BenchSpace;
+
+enum MoveVariant {
+	GRID_VECTOR, GRID_FIXED, SPACE_VECTOR, SPACE_FIXED, VARIANTS
+};
+
+const char* VARIANT_NAMES[] = { "grid_vector", "grid_fixed", "space_vector", "space_fixed" };
+
+struct MoveResults {
+	double seconds[VARIANTS];
+	long allocations[VARIANTS];
+
+	MoveResults() {
+		for (int i = 0; i < VARIANTS; i++) {
+			seconds[i] = 0;
+			allocations[i] = 0;
+		}
+	}
+};
+
+// Measures the time and the allocations of one variant's moves
+class MoveMeter {
+private:
+	Stopwatch watch;
+	long allocationsAtStart;
+
+public:
+	MoveMeter() : allocationsAtStart(allocationCount()) {}
+
+	void start() {
+		allocationsAtStart = allocationCount();
+		watch.reset();
+	}
+
+	void stop(MoveResults& results, MoveVariant variant) {
+		results.seconds[variant] += watch.elapsed();
+		results.allocations[variant] += allocationCount() - allocationsAtStart;
+	}
+};
+
+int nextStep(unsigned int& seed) {
+	seed = seed * 1103515245 + 12345;
+	return (int) ((seed >> 16) % 3) - 1;
+}
+
+void timeMoves(boost::mpi::communicator& comm, int count, int reps, MoveResults& results) {
+	RepastProcess::init("", &comm);
+	long sum = 0;
+	for (int r = 0; r < reps; r++) {
+		SharedContext<BenchAgent> context(&comm);
+		GridDimensions dims(Point<double>(0, 0), Point<double>(SIDE * comm.size(), SIDE));
+		std::vector<int> processDims;
+		processDims.push_back(comm.size());
+		processDims.push_back(1);
+		BenchGrid* grid = new BenchGrid("bench_grid", dims, processDims, 1, &comm);
+		BenchSpace* space = new BenchSpace("bench_space", dims, processDims, 1, &comm);
+		context.addProjection(grid);
+		context.addProjection(space);
+
+		int originX = SIDE * comm.rank();
+		std::vector<BenchAgent*> agents;
+		for (int i = 0; i < count; i++) {
+			BenchAgent* agent = new BenchAgent(AgentId(i, comm.rank(), 0), i);
+			context.addAgent(agent);
+			agents.push_back(agent);
+			grid->moveTo(agent->getId(), Point<int>(originX + i % SIDE, i / SIDE % SIDE));
+			space->moveTo(agent->getId(), Point<double>(originX + i % SIDE, i / SIDE % SIDE));
+		}
+
+		unsigned int seed = 12345 + comm.rank();
+		MoveMeter meter;
+		meter.start();
+		for (int s = 0; s < STEPS; s++) {
+			for (int i = 0; i < count; i++) {
+				std::vector<int> displacement(2, 0);
+				displacement[0] = nextStep(seed);
+				displacement[1] = nextStep(seed);
+				sum += grid->moveByDisplacement(agents[i], displacement).second.getX();
+			}
+		}
+		meter.stop(results, GRID_VECTOR);
+
+		seed = 12345 + comm.rank();
+		meter.start();
+		for (int s = 0; s < STEPS; s++) {
+			for (int i = 0; i < count; i++) {
+				Point<int, 2> displacement(nextStep(seed), nextStep(seed));
+				sum += grid->moveByDisplacement(agents[i], displacement).second.getX();
+			}
+		}
+		meter.stop(results, GRID_FIXED);
+
+		std::vector<double> location;
+		seed = 12345 + comm.rank();
+		meter.start();
+		for (int s = 0; s < STEPS; s++) {
+			for (int i = 0; i < count; i++) {
+				space->getLocation(agents[i]->getId(), location);
+				std::vector<double> newLocation(2, 0);
+				space->translate(Point<double>(location), Point<double>(nextStep(seed) * .5, nextStep(seed) * .5),
+						newLocation);
+				space->moveTo(agents[i]->getId(), Point<double>(newLocation));
+			}
+		}
+		meter.stop(results, SPACE_VECTOR);
+
+		Point<double, 2> fixedLocation;
+		seed = 12345 + comm.rank();
+		meter.start();
+		for (int s = 0; s < STEPS; s++) {
+			for (int i = 0; i < count; i++) {
+				space->getLocation(agents[i]->getId(), fixedLocation);
+				Point<double, 2> newLocation;
+				space->translate(fixedLocation, Point<double, 2>(nextStep(seed) * .5, nextStep(seed) * .5),
+						newLocation);
+				space->moveTo(agents[i]->getId(), newLocation);
+			}
+		}
+		meter.stop(results, SPACE_FIXED);
+	}
+	// keeps the moves from being optimized away
+	if (sum == -1) std::cout << sum << std::endl;
+}
+
+}
+
+namespace perf {
+
+void moveBench(boost::mpi::communicator& comm, int reps) {
+	for (size_t c = 0; c < sizeof(AGENT_COUNTS) / sizeof(AGENT_COUNTS[0]); c++) {
+		std::string suffix = "_" + boost::lexical_cast<std::string>(AGENT_COUNTS[c]);
+		MoveResults results;
+		timeMoves(comm, AGENT_COUNTS[c], reps, results);
+		double moves = (double) reps * STEPS * AGENT_COUNTS[c];
+		for (int v = 0; v < VARIANTS; v++) {
+			report(comm, "move", VARIANT_NAMES[v], "move_s" + suffix, results.seconds[v] / reps);
+			report(comm, "move", VARIANT_NAMES[v], "allocs_per_move" + suffix, results.allocations[v] / moves);
+		}
+	}
+}
+
+}
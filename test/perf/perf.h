@@ -0,0 +1,114 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * perf.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef PERF_H_
+#define PERF_H_
+
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <mpi.h>
+#include <boost/mpi.hpp>
+
+namespace perf {
+
+/**
+ * Wall clock stopwatch for the performance benchmarks.
+ */
+class Stopwatch {
+private:
+	double _start;
+
+public:
+	Stopwatch() : _start(MPI_Wtime()) {}
+
+	void reset() {
+		_start = MPI_Wtime();
+	}
+
+	double elapsed() const {
+		return MPI_Wtime() - _start;
+	}
+};
+
+/**
+ * Prints a single result line on rank 0. The value reported is the
+ * maximum of the local values across all the processes in the communicator,
+ * which for timings is the time the slowest process took.
+ *
+ * @param comm the communicator to reduce over
+ * @param bench the name of the benchmark
+ * @param variant the variant of the benchmark (e.g. the algorithm used)
+ * @param metric the name of the measured quantity
+ * @param value the local value
+ */
+inline void report(boost::mpi::communicator& comm, const std::string& bench, const std::string& variant,
+		const std::string& metric, double value) {
+	double maxValue = 0;
+	MPI_Reduce(&value, &maxValue, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+	if (comm.rank() == 0) {
+		std::cout << std::left << std::setw(24) << bench << std::setw(20) << variant << std::setw(8) << comm.size()
+				<< std::setw(24) << metric << maxValue << std::endl;
+	}
+}
+
+/**
+ * Gets the number of heap allocations made through operator new on this
+ * process so far. The perf driver replaces the global operator new to count
+ * them.
+ */
+long allocationCount();
+
+// Benchmarks; each takes the number of repetitions to run
+void agentRequestBench(boost::mpi::communicator& comm, int reps);
+void contextBench(boost::mpi::communicator& comm, int reps);
+void contentTransferBench(boost::mpi::communicator& comm, int reps);
+void gridQueryBench(boost::mpi::communicator& comm, int reps);
+void knnBench(boost::mpi::communicator& comm, int reps);
+void moveBench(boost::mpi::communicator& comm, int reps);
+void projectionSyncBench(boost::mpi::communicator& comm, int reps);
+void projectionSyncGhostsBench(boost::mpi::communicator& comm, int reps);
+void scheduleBench(boost::mpi::communicator& comm, int reps);
+void scheduleRunnerBench(boost::mpi::communicator& comm, int reps);
+
+}
+
+#endif /* PERF_H_ */
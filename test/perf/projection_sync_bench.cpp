@@ -0,0 +1,166 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * projection_sync_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times RepastProcess::synchronizeProjectionInfo for a grid on which every
+ * agent lies in the buffer zone of a neighboring process, so that each
+ * synchronization exports every local agent, with its Content and a
+ * ProjectionInfoPacket, and imports as many non-local agents. A second
+ * benchmark keeps the number of local agents fixed and varies how many of
+ * them lie in buffer zones, and so the number of ghost (non-local) agents
+ * each process keeps. Besides the times, both report the heap allocations
+ * per synchronization counted by the perf driver's operator new.
+ */
+
+#include <vector>
+#include <string>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/AgentId.h"
+#include "repast_hpc/SharedContext.h"
+#include "repast_hpc/SharedDiscreteSpace.h"
+#include "repast_hpc/GridComponents.h"
+#include "repast_hpc/RepastProcess.h"
+#include "perf.h"
+#include "bench_agent.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int AGENT_COUNTS[] = { 1000, 10000, 100000 };
+
+const int GHOST_BENCH_AGENTS = 20000;
+const int GHOST_BENCH_BUFFERED[] = { 0, 2500, 5000, 10000, 20000 };
+
+typedef SharedDiscreteSpace<BenchAgent, StrictBorders, SimpleAdder<BenchAgent> > BenchSpace;
+
+/**
+ * Times synchronizeProjectionInfo with 'count' agents on each process. Each
+ * process has a column 'width' cells wide, of which the first and last are in
+ * the buffer zones of the processes on either side; the first 'buffered'
+ * agents are placed in those two cells and the rest between them. The
+ * number of non-local agents this process keeps is returned in 'ghosts', and
+ * the allocations per synchronization in 'allocations'.
+ */
+template<typename Package>
+double timeSynchronizeProjectionInfo(boost::mpi::communicator& comm, int count, int width, int buffered, int reps,
+		int& ghosts, double& allocations) {
+	RepastProcess* process = RepastProcess::init("", &comm);
+
+	SharedContext<BenchAgent> context(&comm);
+	GridDimensions dims(Point<double>(0, 0), Point<double>(width * comm.size(), (count + width - 1) / width));
+	std::vector<int> processDims;
+	processDims.push_back(comm.size());
+	processDims.push_back(1);
+	BenchSpace* space = new BenchSpace("bench_space", dims, processDims, 1, &comm);
+	context.addProjection(space);
+
+	GridDimensions local = space->dimensions();
+	for (int i = 0; i < count; i++) {
+		BenchAgent* agent = new BenchAgent(AgentId(i, comm.rank(), 0), i);
+		context.addAgent(agent);
+		std::vector<int> pt;
+		pt.push_back((int) local.origin(0) + (i < buffered ? (i % 2) * (width - 1) : 1 + i % (width - 2)));
+		pt.push_back(i / width);
+		space->moveTo(agent->getId(), pt);
+	}
+
+	BenchAgentPackager<Package> packager;
+	packager.context = &context;
+
+	// One untimed synchronization to warm up
+	process->synchronizeProjectionInfo<BenchAgent, Package, BenchAgentPackager<Package>,
+			BenchAgentPackager<Package>, BenchAgentPackager<Package> >(context, packager, packager, packager);
+	ghosts = 0;
+	for (SharedContext<BenchAgent>::const_state_aware_iterator iter = context.begin(SharedContext<BenchAgent>::NON_LOCAL),
+			iterEnd = context.end(SharedContext<BenchAgent>::NON_LOCAL); iter != iterEnd; ++iter)
+		ghosts++;
+	comm.barrier();
+	long allocationsAtStart = allocationCount();
+	Stopwatch watch;
+	for (int r = 0; r < reps; r++)
+		process->synchronizeProjectionInfo<BenchAgent, Package, BenchAgentPackager<Package>,
+				BenchAgentPackager<Package>, BenchAgentPackager<Package> >(context, packager, packager, packager);
+	double elapsed = watch.elapsed() / reps;
+	allocations = (double) (allocationCount() - allocationsAtStart) / reps;
+	return elapsed;
+}
+
+}
+
+namespace perf {
+
+void projectionSyncBench(boost::mpi::communicator& comm, int reps) {
+	if (comm.size() < 2) return;
+
+	// Every agent is in the buffer zone of a neighboring process
+	int ghosts;
+	double allocations;
+	for (size_t c = 0; c < sizeof(AGENT_COUNTS) / sizeof(AGENT_COUNTS[0]); c++) {
+		int count = AGENT_COUNTS[c];
+		std::string agents = boost::lexical_cast<std::string>(count) + " agents";
+		report(comm, "projection_sync", "archive", agents + " s/sync",
+				timeSynchronizeProjectionInfo<BenchAgentPackage>(comm, count, 2, count, reps, ghosts, allocations));
+		report(comm, "projection_sync", "archive", agents + " allocs", allocations);
+		report(comm, "projection_sync", "raw", agents + " s/sync",
+				timeSynchronizeProjectionInfo<RawBenchAgentPackage>(comm, count, 2, count, reps, ghosts, allocations));
+		report(comm, "projection_sync", "raw", agents + " allocs", allocations);
+	}
+}
+
+void projectionSyncGhostsBench(boost::mpi::communicator& comm, int reps) {
+	if (comm.size() < 2) return;
+
+	for (size_t b = 0; b < sizeof(GHOST_BENCH_BUFFERED) / sizeof(GHOST_BENCH_BUFFERED[0]); b++) {
+		int ghosts;
+		double allocations;
+		double elapsed = timeSynchronizeProjectionInfo<BenchAgentPackage>(comm, GHOST_BENCH_AGENTS, 8,
+				GHOST_BENCH_BUFFERED[b], reps, ghosts, allocations);
+		int maxGhosts = 0;
+		boost::mpi::all_reduce(comm, ghosts, maxGhosts, boost::mpi::maximum<int>());
+		std::string label = boost::lexical_cast<std::string>(maxGhosts) + " ghosts";
+		report(comm, "projection_sync_ghosts", "archive", label + " s/sync", elapsed);
+		report(comm, "projection_sync_ghosts", "archive", label + " allocs", allocations);
+	}
+}
+
+}
@@ -0,0 +1,187 @@
+/*
+*Repast for High Performance Computing (Repast HPC)
+*
+*   Copyright (c) 2010 Argonne National Laboratory
+*   All rights reserved.
+*  
+*   Redistribution and use in source and binary forms, with 
+*   or without modification, are permitted provided that the following 
+*   conditions are met:
+*  
+*  	 Redistributions of source code must retain the above copyright notice,
+*  	 this list of conditions and the following disclaimer.
+*  
+*  	 Redistributions in binary form must reproduce the above copyright notice,
+*  	 this list of conditions and the following disclaimer in the documentation
+*  	 and/or other materials provided with the distribution.
+*  
+*  	 Neither the name of the Argonne National Laboratory nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*  
+*   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+*   PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE TRUSTEES OR
+*   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+*   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+*   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+*   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+*   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+*   EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * schedule_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ * Times the Schedule with its HEAP and CALENDAR queues. The one time
+ * variant schedules events at pseudo random integer ticks, in the way
+ * per-agent timers are scheduled, and then executes the schedule until
+ * it is empty; the inline variant does the same with the calls stored in
+ * the events (Schedule::schedule_call) rather than in a shared Functor.
+ * The repeating variant executes a fixed number of ticks of events that
+ * repeat every tick. Each process runs its own Schedule.
+ *
+ * The schedule_runner benchmark times ScheduleRunner::run over a schedule
+ * with one event every tick on every process, with and without a
+ * lookahead, i.e. with one reduction per tick or per window of ticks.
+ */
+
+#include <string>
+#include <boost/mpi.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "repast_hpc/Schedule.h"
+#include "perf.h"
+
+using namespace repast;
+using namespace perf;
+
+namespace {
+
+const int EVENT_COUNTS[] = { 10000, 100000, 1000000 };
+const int TICK_SPAN = 1000;
+const int REPEATING_TICKS = 100;
+const int RUNNER_TICKS = 10000;
+const double LOOKAHEADS[] = { 0, 10, 100 };
+
+class Counter: public Functor {
+public:
+	long count;
+
+	Counter() : count(0) {}
+
+	void operator()() {
+		count++;
+	}
+
+	void increment() {
+		count++;
+	}
+};
+
+const char* queueName(Schedule::QUEUE_TYPE type) {
+	return type == Schedule::CALENDAR ? "calendar" : "heap";
+}
+
+double timeOneTime(Schedule::QUEUE_TYPE type, int count, int reps) {
+	Counter* counter = new Counter();
+	Schedule::FunctorPtr func(counter);
+	Stopwatch watch;
+	for (int r = 0; r < reps; r++) {
+		Schedule schedule(type);
+		unsigned long seed = 12345;
+		for (int i = 0; i < count; i++) {
+			seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+			schedule.schedule_event(1 + (seed >> 33) % TICK_SPAN, func);
+		}
+		while (schedule.size() > 0)
+			schedule.execute();
+	}
+	return watch.elapsed() / reps;
+}
+
+double timeOneTimeInline(Schedule::QUEUE_TYPE type, int count, int reps) {
+	Counter counter;
+	MethodCall<Counter> call(&counter, &Counter::increment);
+	Stopwatch watch;
+	for (int r = 0; r < reps; r++) {
+		Schedule schedule(type);
+		unsigned long seed = 12345;
+		for (int i = 0; i < count; i++) {
+			seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+			schedule.schedule_call(1 + (seed >> 33) % TICK_SPAN, call);
+		}
+		while (schedule.size() > 0)
+			schedule.execute();
+	}
+	return watch.elapsed() / reps;
+}
+
+double timeRepeating(Schedule::QUEUE_TYPE type, int count, int reps) {
+	Counter* counter = new Counter();
+	Schedule::FunctorPtr func(counter);
+	double total = 0;
+	for (int r = 0; r < reps; r++) {
+		Schedule schedule(type);
+		for (int i = 0; i < count; i++)
+			schedule.schedule_event(1, 1, func);
+		Stopwatch watch;
+		for (int t = 0; t < REPEATING_TICKS; t++)
+			schedule.execute();
+		total += watch.elapsed();
+	}
+	return total / reps;
+}
+
+double timeRun(boost::mpi::communicator& comm, double lookahead, int reps) {
+	double total = 0;
+	for (int r = 0; r < reps; r++) {
+		ScheduleRunner runner(&comm);
+		runner.setLookahead(lookahead);
+		runner.scheduleEvent(1, 1, Schedule::FunctorPtr(new Counter()));
+		runner.scheduleStop(RUNNER_TICKS);
+		comm.barrier();
+		Stopwatch watch;
+		runner.run();
+		total += watch.elapsed();
+	}
+	return total / reps / RUNNER_TICKS;
+}
+
+}
+
+namespace perf {
+
+void scheduleBench(boost::mpi::communicator& comm, int reps) {
+	const Schedule::QUEUE_TYPE types[] = { Schedule::HEAP, Schedule::CALENDAR };
+	for (size_t c = 0; c < sizeof(EVENT_COUNTS) / sizeof(EVENT_COUNTS[0]); c++) {
+		int count = EVENT_COUNTS[c];
+		std::string events = boost::lexical_cast<std::string>(count) + " events";
+		for (size_t t = 0; t < 2; t++) {
+			report(comm, "schedule", std::string(queueName(types[t])) + " one time", events + " s/run",
+					timeOneTime(types[t], count, reps));
+			report(comm, "schedule", std::string(queueName(types[t])) + " inline", events + " s/run",
+					timeOneTimeInline(types[t], count, reps));
+		}
+		std::string repeating = boost::lexical_cast<std::string>(count / 100) + " events";
+		for (size_t t = 0; t < 2; t++) {
+			report(comm, "schedule", std::string(queueName(types[t])) + " repeating", repeating + " s/"
+					+ boost::lexical_cast<std::string>(REPEATING_TICKS) + " ticks",
+					timeRepeating(types[t], count / 100, reps));
+		}
+	}
+}
+
+void scheduleRunnerBench(boost::mpi::communicator& comm, int reps) {
+	for (size_t i = 0; i < sizeof(LOOKAHEADS) / sizeof(LOOKAHEADS[0]); i++) {
+		report(comm, "schedule_runner", "lookahead " + boost::lexical_cast<std::string>(LOOKAHEADS[i]), "s/tick",
+				timeRun(comm, LOOKAHEADS[i], reps));
+	}
+}
+
+}